@@ -0,0 +1,90 @@
+/**
+ * @file bench_merge.cpp
+ * @brief Scaling of deep_merge_parallel() on a wide per-tenant map
+ *
+ * Usage: confy_bench_merge [TENANTS] [REPEAT]
+ *
+ * Builds a base map of TENANTS small objects and an override touching
+ * most of them, then times deep_merge() against deep_merge_parallel()
+ * with 1 to 32 threads. Every parallel result is checked against the
+ * sequential one.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/Merge.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+
+void make_tenants(size_t count, confy::Value& base, confy::Value& over) {
+    base = confy::Value::object();
+    over = confy::Value::object();
+    for (size_t i = 0; i < count; ++i) {
+        std::string key = "tenant" + std::to_string(i);
+        base[key] = {
+            {"plan", "free"},
+            {"region", "eu-west-" + std::to_string(i % 3)},
+            {"limits", {{"cpu", 1}, {"memory", 512}, {"disk", 10}}},
+            {"features", {{"sso", false}, {"audit", false}}}
+        };
+        if (i % 10 < 8) {
+            over[key] = {{"limits", {{"cpu", 2 + i % 4}}}, {"features", {{"sso", true}}}};
+        }
+    }
+    for (size_t i = count; i < count + count / 10; ++i) {
+        over["tenant" + std::to_string(i)] = {{"plan", "trial"}};
+    }
+}
+
+/// Best of @p repeat runs, in milliseconds
+template <typename Fn>
+double best_ms(size_t repeat, Fn&& fn) {
+    double best = 0;
+    for (size_t i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        best = (i == 0) ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    size_t tenants = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t repeat = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 5;
+    repeat = std::max<size_t>(repeat, 1);
+
+    confy::Value base, over;
+    make_tenants(tenants, base, over);
+
+    confy::Value expected;
+    double sequential = best_ms(repeat, [&] { expected = confy::deep_merge(base, over); });
+
+    std::printf("deep_merge: %zu base keys, %zu override keys, %u hardware threads\n",
+                base.size(), over.size(), std::thread::hardware_concurrency());
+    std::printf("%-12s %10s %8s\n", "threads", "ms", "speedup");
+    std::printf("%-12s %10.2f %8.2f\n", "sequential", sequential, 1.0);
+
+    for (size_t threads : {1, 2, 4, 8, 16, 32}) {
+        confy::ParallelMergeOptions options;
+        options.threads = threads;
+        confy::Value merged;
+        double ms = best_ms(repeat, [&] { merged = confy::deep_merge_parallel(base, over, options); });
+        if (merged != expected) {
+            std::fprintf(stderr, "mismatch with %zu threads\n", threads);
+            return 1;
+        }
+        std::printf("%-12zu %10.2f %8.2f\n", threads, ms, sequential / ms);
+    }
+    return 0;
+}
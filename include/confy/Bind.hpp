@@ -0,0 +1,255 @@
+/**
+ * @file Bind.hpp
+ * @brief Typed struct binding with compile-time field tables
+ *
+ * Maps the fields of a plain C++ struct to dot-paths through a constexpr
+ * table of member pointers (no runtime reflection). bind_config() fills
+ * the struct from a Config in one ordered traversal: paths are split and
+ * sorted once per struct type, and fields sharing a prefix reuse the
+ * nodes already walked. Hot code then reads plain struct members instead
+ * of calling Config::get<T>() with a string path.
+ *
+ * Error handling matches Config:
+ * - Type mismatches throw TypeError (as Config::get<T>())
+ * - Traversal into a non-container throws TypeError (RULE D2)
+ * - Missing required fields are collected and reported together in
+ *   MissingMandatoryConfig (RULE M1-M3)
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_BIND_HPP
+#define CONFY_BIND_HPP
+
+#include "confy/Config.hpp"
+#include "confy/Value.hpp"
+#include "confy/Errors.hpp"
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief One entry of a binding table: dot-path to struct member
+ *
+ * @tparam S Bound struct type
+ * @tparam T Member type (anything Value::get<T>() supports)
+ */
+template<typename S, typename T>
+struct FieldBinding {
+    /// Dot-path of the value in the configuration
+    const char* path;
+
+    /// Member receiving the value
+    T S::* member;
+
+    /// Missing value is an error (otherwise the member keeps its value)
+    bool required;
+};
+
+/**
+ * @brief Bind an optional field (member keeps its current value if missing)
+ */
+template<typename S, typename T>
+constexpr FieldBinding<S, T> bind_field(const char* path, T S::* member) {
+    return {path, member, false};
+}
+
+/**
+ * @brief Bind a required field (missing value raises MissingMandatoryConfig)
+ */
+template<typename S, typename T>
+constexpr FieldBinding<S, T> bind_required(const char* path, T S::* member) {
+    return {path, member, true};
+}
+
+/**
+ * @brief Binding table for a struct (specialize for each bound type)
+ *
+ * A specialization provides a constexpr tuple of FieldBinding entries
+ * named `fields`:
+ *
+ * @code
+ * struct DbSettings {
+ *     std::string host;
+ *     int pool_max = 16;
+ * };
+ *
+ * template<>
+ * struct confy::Binding<DbSettings> {
+ *     static constexpr auto fields = std::make_tuple(
+ *         confy::bind_required("database.host", &DbSettings::host),
+ *         confy::bind_field("database.pool.max", &DbSettings::pool_max));
+ * };
+ * @endcode
+ */
+template<typename S>
+struct Binding;
+
+/**
+ * @brief Precomputed traversal plan for a set of dot-paths
+ *
+ * Splits each path once and orders the paths by segment so a single
+ * walk over the tree resolves all of them, sharing common prefixes.
+ */
+class BindPlan {
+public:
+    /**
+     * @brief Result of resolving one path
+     */
+    struct Slot {
+        /// Value at the path, or nullptr if missing or blocked
+        const Value* value = nullptr;
+
+        /// Non-container that stopped traversal (RULE D2), or nullptr
+        const Value* blocked_by = nullptr;
+    };
+
+    /**
+     * @brief Build a plan for the given paths
+     *
+     * @param paths Dot-paths, in field declaration order
+     */
+    explicit BindPlan(std::vector<std::string> paths);
+
+    /**
+     * @brief Resolve every path against a tree
+     *
+     * @param root Configuration tree
+     * @param out Receives one Slot per path, in declaration order
+     */
+    void resolve(const Value& root, std::vector<Slot>& out) const;
+
+    /**
+     * @brief Number of paths in the plan
+     */
+    size_t size() const { return paths_.size(); }
+
+private:
+    std::vector<std::string> paths_;
+    std::vector<std::vector<std::string>> segments_;
+
+    /// Path indices in traversal order
+    std::vector<size_t> order_;
+
+    /// Segments shared with the previous path in traversal order
+    std::vector<size_t> shared_;
+};
+
+namespace detail {
+
+template<typename Fields, size_t... I>
+std::vector<std::string> binding_paths(const Fields& fields,
+                                       std::index_sequence<I...>) {
+    return {std::string(std::get<I>(fields).path)...};
+}
+
+template<typename S, typename T>
+void assign_field(S& out, const FieldBinding<S, T>& field,
+                  const BindPlan::Slot& slot,
+                  std::vector<std::string>& missing) {
+    if (slot.value != nullptr) {
+        try {
+            out.*(field.member) = slot.value->template get<T>();
+        } catch (const nlohmann::json::type_error& e) {
+            throw TypeError(field.path, "compatible type", e.what());
+        }
+        return;
+    }
+
+    if (field.required) {
+        // RULE M3: Path into non-container counts as missing
+        missing.emplace_back(field.path);
+        return;
+    }
+
+    if (slot.blocked_by != nullptr) {
+        // RULE D2: Optional fields still raise for type mismatches
+        throw TypeError(field.path, "object or array", type_name(*slot.blocked_by));
+    }
+}
+
+template<typename S, typename Fields, size_t... I>
+void assign_fields(S& out, const Fields& fields,
+                   const std::vector<BindPlan::Slot>& slots,
+                   std::vector<std::string>& missing,
+                   std::index_sequence<I...>) {
+    (assign_field(out, std::get<I>(fields), slots[I], missing), ...);
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the traversal plan for a bound struct (built once per type)
+ */
+template<typename S>
+const BindPlan& bind_plan() {
+    constexpr auto& fields = Binding<S>::fields;
+    constexpr size_t count = std::tuple_size_v<std::decay_t<decltype(fields)>>;
+
+    static const BindPlan plan(
+        detail::binding_paths(fields, std::make_index_sequence<count>{}));
+    return plan;
+}
+
+/**
+ * @brief Populate (or re-populate) a bound struct from a Config
+ *
+ * Strong exception guarantee: on error, out is left unchanged, so the
+ * same instance can be re-bound after each reload.
+ *
+ * @tparam S Struct type with a Binding<S> specialization
+ * @param cfg Source configuration
+ * @param out Struct to fill; unbound and missing optional members keep
+ *            their current values
+ *
+ * @throws TypeError if a value cannot convert to its member type, or an
+ *         optional field's traversal hits a non-container
+ * @throws MissingMandatoryConfig listing every missing required field
+ */
+template<typename S>
+void bind_config(const Config& cfg, S& out) {
+    constexpr auto& fields = Binding<S>::fields;
+    constexpr size_t count = std::tuple_size_v<std::decay_t<decltype(fields)>>;
+
+    std::vector<BindPlan::Slot> slots;
+    bind_plan<S>().resolve(cfg.data(), slots);
+
+    S result = out;
+    std::vector<std::string> missing;
+    detail::assign_fields(result, fields, slots, missing,
+                          std::make_index_sequence<count>{});
+
+    if (!missing.empty()) {
+        throw MissingMandatoryConfig(missing);
+    }
+    out = std::move(result);
+}
+
+/**
+ * @brief Create a bound struct from a Config
+ *
+ * @tparam S Default-constructible struct type with a Binding<S> specialization
+ * @param cfg Source configuration
+ * @return Struct with bound members populated
+ *
+ * Example:
+ * @code
+ * DbSettings db = confy::bind_config<DbSettings>(cfg);
+ * connect(db.host, db.pool_max);  // plain member reads
+ * @endcode
+ */
+template<typename S>
+S bind_config(const Config& cfg) {
+    S result{};
+    bind_config(cfg, result);
+    return result;
+}
+
+} // namespace confy
+
+#endif // CONFY_BIND_HPP
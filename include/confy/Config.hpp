@@ -26,15 +26,30 @@
 
 #include "confy/Value.hpp"
 #include "confy/Errors.hpp"
+#include "confy/DotPath.hpp"
+#include "confy/StaticPath.hpp"
+#include "confy/Provenance.hpp"
 
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <optional>
 #include <functional>
+#include <iosfwd>
+#include <memory>
 
 namespace confy {
 
+class Schema;
+
+/**
+ * @brief Callback receiving serialized output in chunks
+ *
+ * Called with consecutive pieces of the output; the data pointer is only
+ * valid for the duration of the call.
+ */
+using OutputSink = std::function<void(const char* data, size_t size)>;
+
 /**
  * @brief Configuration loading options
  *
@@ -122,6 +137,30 @@ struct LoadOptions {
      * @endcode
      */
     std::vector<std::string> mandatory;
+
+    /**
+     * @brief Optional schema checked after merge
+     *
+     * Can be used in place of (or together with) mandatory. Schema
+     * defaults are placed beneath defaults (lowest precedence), and the
+     * merged tree is checked in one pass; all violations are reported
+     * together in SchemaValidationError.
+     *
+     * Example:
+     * @code
+     * auto schema = std::make_shared<Schema>();
+     * schema->field("database.host").required().type(SchemaType::String);
+     * opts.schema = schema;
+     * @endcode
+     */
+    std::shared_ptr<const Schema> schema;
+
+    /**
+     * @brief Record which source set each key (see Config::origin())
+     *
+     * Off by default; when off, loading does no extra work.
+     */
+    bool track_origins = false;
 };
 
 /**
@@ -137,6 +176,11 @@ struct LoadOptions {
  * Thread-safety: NOT thread-safe. External synchronization required
  * for concurrent access to the same Config instance.
  *
+ * Copies share structure: the configuration tree is reference-counted and
+ * copied only when a shared instance is first modified (copy-on-write).
+ * Keeping several versions alive (e.g. for rollback) therefore costs one
+ * tree per version that was actually changed, and copying a Config is O(1).
+ *
  * Example usage:
  * @code
  * LoadOptions opts;
@@ -159,7 +203,7 @@ public:
      * Creates an empty configuration object. Use Config::load() for
      * normal initialization with source loading.
      */
-    Config() = default;
+    Config();
 
     /**
      * @brief Construct from existing JSON value
@@ -168,25 +212,39 @@ public:
      */
     explicit Config(const Value& data);
 
+    /**
+     * @brief Construct from existing JSON value (taking ownership)
+     *
+     * @param data Initial configuration data (should be object type)
+     */
+    explicit Config(Value&& data);
+
     /**
      * @brief Copy constructor
+     *
+     * O(1): the copy shares the configuration tree with other until
+     * either instance is modified. If other has handed out a reference
+     * through mutable_data(), the tree is copied instead, so writes
+     * through that reference never reach the copy.
      */
-    Config(const Config& other) = default;
+    Config(const Config& other);
 
     /**
      * @brief Move constructor
+     *
+     * Leaves other as an empty configuration.
      */
-    Config(Config&& other) noexcept = default;
+    Config(Config&& other) noexcept;
 
     /**
-     * @brief Copy assignment
+     * @brief Copy assignment (shares or copies the tree like the copy constructor)
      */
-    Config& operator=(const Config& other) = default;
+    Config& operator=(const Config& other);
 
     /**
      * @brief Move assignment
      */
-    Config& operator=(Config&& other) noexcept = default;
+    Config& operator=(Config&& other) noexcept;
 
     /**
      * @brief Default destructor
@@ -206,7 +264,7 @@ public:
      * 3. Load .env file (if enabled)
      * 4. Merge environment variables (if prefix set)
      * 5. Apply overrides
-     * 6. Validate mandatory keys
+     * 6. Validate mandatory keys and schema
      *
      * @param opts Loading options specifying all sources
      * @return Fully configured Config instance
@@ -214,6 +272,7 @@ public:
      * @throws FileNotFoundError if file_path specified but not found
      * @throws ConfigParseError if config file has syntax errors
      * @throws MissingMandatoryConfig if mandatory keys are missing
+     * @throws SchemaValidationError if opts.schema is set and not satisfied
      */
     static Config load(const LoadOptions& opts);
 
@@ -278,6 +337,94 @@ public:
      */
     std::optional<Value> get_optional(const std::string& path) const;
 
+    /**
+     * @brief Look up a dot-path without throwing
+     *
+     * Never throws for missing keys or type mismatches; the result's
+     * status says which happened, and message() builds the text of the
+     * exception get() would have raised.
+     *
+     * The path is viewed in place, never copied: a literal or a caller's
+     * string costs no allocation, and the result's segment stays valid
+     * as long as that buffer does. Do not pass a temporary std::string
+     * if the segment is read after the call's full-expression.
+     *
+     * @param path Dot-separated path
+     * @return Lookup result; value points into this Config and is valid
+     *         until the Config is modified
+     *
+     * Example:
+     * @code
+     * if (auto r = cfg.find("cache.ttl")) {
+     *     ttl = r.value->get<int>();
+     * }
+     * @endcode
+     */
+    LookupResult find(std::string_view path) const noexcept {
+        return try_get_by_dot(*data_, path);
+    }
+
+    /**
+     * @brief Get value at a compile-time tokenized path with default
+     *
+     * Same as get<T>(const std::string&, const T&) without runtime path
+     * parsing.
+     *
+     * Example:
+     * @code
+     * using namespace confy::literals;
+     * int port = cfg.get<int>("database.port"_cpath, 5432);
+     * @endcode
+     */
+    template<typename T>
+    T get(const StaticPath& path, const T& default_val) const;
+
+    /**
+     * @brief Get value at a compile-time tokenized path (strict)
+     *
+     * @throws KeyError if path not found (RULE D1)
+     * @throws TypeError if traversal encounters non-object (RULE D1)
+     */
+    Value get(const StaticPath& path) const;
+
+    /**
+     * @brief Get value at a compile-time tokenized path, or std::nullopt
+     *
+     * @throws TypeError if traversal encounters non-object
+     */
+    std::optional<Value> get_optional(const StaticPath& path) const;
+
+    /**
+     * @brief Result of one lookup in a get_many() batch
+     */
+    struct KeyResult {
+        /// Found, Missing, or TypeMismatch (traversal into non-container)
+        LookupStatus status = LookupStatus::Missing;
+
+        /// Copy of the value (null unless status is Found)
+        Value value;
+
+        bool found() const { return status == LookupStatus::Found; }
+    };
+
+    /**
+     * @brief Get several values in one traversal
+     *
+     * Paths are grouped by common prefix so each shared prefix is walked
+     * once. Nothing is thrown for missing keys or type mismatches; each
+     * key reports its own status instead.
+     *
+     * @param paths Dot-separated paths
+     * @return One result per path, in the order given
+     *
+     * Example:
+     * @code
+     * auto r = cfg.get_many({"db.host", "db.port", "db.pool.max"});
+     * if (r[1].found()) port = r[1].value.get<int>();
+     * @endcode
+     */
+    std::vector<KeyResult> get_many(const std::vector<std::string>& paths) const;
+
     /**
      * @brief Set value at dot-path
      *
@@ -320,6 +467,30 @@ public:
      */
     bool contains(const std::string& path) const;
 
+    /**
+     * @brief Source that set the value at dot-path
+     *
+     * Available when the config was loaded with LoadOptions::track_origins
+     * and has not been modified since; set(), merge() and mutable_data()
+     * discard the record. A path inside an array reports the array.
+     *
+     * @param path Dot-separated path of a leaf (not a section)
+     * @return Origin, or std::nullopt if unknown
+     *
+     * Example:
+     * @code
+     * if (auto o = cfg.origin("database.port")) {
+     *     std::cerr << "database.port from " << o->to_string() << "\n";
+     * }
+     * @endcode
+     */
+    std::optional<Origin> origin(const std::string& path) const;
+
+    /**
+     * @brief Whether origin() has a record to consult
+     */
+    bool has_origins() const noexcept { return provenance_ != nullptr; }
+
     // =========================================================================
     // Raw Data Access
     // =========================================================================
@@ -329,14 +500,44 @@ public:
      *
      * @return Const reference to internal data
      */
-    const Value& data() const { return data_; }
+    const Value& data() const { return *data_; }
 
     /**
-     * @brief Get underlying JSON object (mutable)
+     * @brief Get underlying JSON object for modification
+     *
+     * Detaches this instance from any copies sharing its tree first (a
+     * full copy of a shared tree) and discards the origin record. Reads
+     * should use data(), which never copies.
+     *
+     * The tree is then treated as unsharable: later copies of this
+     * instance take a full copy instead of sharing it, so writes through
+     * the returned reference only ever reach this instance. merge() and
+     * assignment replace the tree and make it sharable again.
      *
      * @return Mutable reference to internal data
      */
-    Value& data() { return data_; }
+    Value& mutable_data();
+
+    /**
+     * @brief Get underlying JSON object for modification
+     *
+     * @deprecated Same as mutable_data(). Use std::as_const(cfg).data()
+     * for reads, which never copy the tree.
+     */
+    [[deprecated("use mutable_data(), or std::as_const(cfg).data() to read")]]
+    Value& data() { return mutable_data(); }
+
+    /**
+     * @brief Check whether two configs share the same underlying tree
+     *
+     * True for copies that have not been modified since they were taken.
+     *
+     * @param other Config to compare with
+     * @return true if both instances reference the same tree
+     */
+    bool shares_data_with(const Config& other) const noexcept {
+        return data_ == other.data_;
+    }
 
     // =========================================================================
     // Serialization
@@ -350,13 +551,58 @@ public:
      */
     std::string to_json(int indent = 2) const;
 
+    /**
+     * @brief Serialize to JSON, writing directly to a stream
+     *
+     * Produces the same text as to_json(indent) without building the
+     * whole document in memory first.
+     *
+     * @param out Destination stream
+     * @param indent Indentation level (default 2 for pretty print, -1 for compact)
+     */
+    void to_json(std::ostream& out, int indent = 2) const;
+
+    /**
+     * @brief Serialize to JSON, passing output to a sink in chunks
+     *
+     * Output is staged in a fixed-size buffer that is handed to sink
+     * each time it fills, so memory use does not grow with config size.
+     * Exceptions thrown by sink propagate to the caller.
+     *
+     * @param sink Chunk consumer
+     * @param indent Indentation level (default 2 for pretty print, -1 for compact)
+     */
+    void to_json(const OutputSink& sink, int indent = 2) const;
+
     /**
      * @brief Serialize to TOML string
      *
+     * null values are written as "" since TOML has no null.
+     *
      * @return TOML string representation
+     * @throws ConfigError for an unsigned integer above INT64_MAX, which
+     *         TOML cannot represent. The stream and sink overloads may
+     *         have written part of the document by then.
      */
     std::string to_toml() const;
 
+    /**
+     * @brief Serialize to TOML, writing directly to a stream
+     *
+     * Walks the tree and emits TOML text as it goes; no intermediate
+     * document is built.
+     *
+     * @param out Destination stream
+     */
+    void to_toml(std::ostream& out) const;
+
+    /**
+     * @brief Serialize to TOML, passing output to a sink in chunks
+     *
+     * @param sink Chunk consumer (see to_json(const OutputSink&, int))
+     */
+    void to_toml(const OutputSink& sink) const;
+
     /**
      * @brief Convert to plain dictionary (recursively)
      *
@@ -365,7 +611,7 @@ public:
      *
      * @return Copy of internal data
      */
-    Value to_dict() const { return data_; }
+    Value to_dict() const { return *data_; }
 
     // =========================================================================
     // Utility
@@ -376,14 +622,14 @@ public:
      *
      * @return true if no keys are set
      */
-    bool empty() const { return data_.empty(); }
+    bool empty() const { return data_->empty(); }
 
     /**
      * @brief Get number of top-level keys
      *
      * @return Count of top-level keys in configuration
      */
-    size_t size() const { return data_.size(); }
+    size_t size() const { return data_->size(); }
 
     /**
      * @brief Merge another Config into this one
@@ -402,7 +648,19 @@ public:
     void merge(const Value& other);
 
 private:
-    Value data_ = Value::object();
+    friend class LayeredConfig;
+
+    /// Shared, copy-on-write configuration tree (never null)
+    std::shared_ptr<Value> data_;
+
+    /// Source of each leaf of data_ (null unless tracked and unmodified)
+    std::shared_ptr<const Provenance> provenance_;
+
+    /// mutable_data() handed out a reference into data_; copies must not share it
+    bool unsharable_ = false;
+
+    /// Detach data_ from other instances and drop the origin record
+    Value& writable_tree();
 
     /**
      * @brief Validate that all mandatory keys exist
@@ -415,7 +673,9 @@ private:
     /**
      * @brief Convert overrides map to nested Value
      *
-     * Transforms flat dot-path map to nested structure.
+     * Transforms flat dot-path map to nested structure. Built with a
+     * TreeBuilder, so overlapping paths resolve the same way whatever
+     * the map's iteration order.
      *
      * @param overrides Map of dot-paths to values
      * @return Nested Value object
@@ -442,6 +702,20 @@ T Config::get(const std::string& path, const T& default_val) const {
     }
 }
 
+template<typename T>
+T Config::get(const StaticPath& path, const T& default_val) const {
+    auto opt = get_optional(path);
+    if (!opt.has_value()) {
+        return default_val;
+    }
+
+    try {
+        return opt->get<T>();
+    } catch (const nlohmann::json::type_error& e) {
+        throw TypeError(std::string(path.str()), "compatible type", e.what());
+    }
+}
+
 } // namespace confy
 
 #endif // CONFY_CONFIG_HPP
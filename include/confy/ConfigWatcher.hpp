@@ -0,0 +1,114 @@
+/**
+ * @file ConfigWatcher.hpp
+ * @brief Reload a configuration only when one of its sources changed
+ *
+ * A ConfigWatcher remembers what its current Config was loaded from:
+ * the config file and .env file (existence, modification time, size)
+ * and the filtered environment (env_fingerprint()). refresh() compares
+ * them and calls Config::load() only on a difference, so polling an
+ * unchanged setup costs a few stat() calls and one environment scan.
+ *
+ * .env never overrides a variable that is already set, and the previous
+ * load left every .env variable in the environment. Before reloading,
+ * the watcher therefore removes the variables the last .env exported
+ * that still hold the value it gave them, so an edited .env takes
+ * effect. Variables changed or set by anyone else are left alone.
+ *
+ * @code
+ * confy::ConfigWatcher watcher(opts);
+ * // ... periodically:
+ * if (watcher.refresh()) {
+ *     apply(watcher.config());
+ * }
+ * @endcode
+ *
+ * Not thread-safe; call refresh() from one thread.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_CONFIG_WATCHER_HPP
+#define CONFY_CONFIG_WATCHER_HPP
+
+#include "confy/Config.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Config plus the source state it was loaded from
+ */
+class ConfigWatcher {
+public:
+    /**
+     * @brief Load the configuration
+     * @throws Same as Config::load()
+     */
+    explicit ConfigWatcher(LoadOptions opts);
+
+    /**
+     * @brief Watch a configuration already loaded from @p opts
+     *
+     * Sources are recorded now; a change between that load and this
+     * call is only seen on the next change.
+     */
+    ConfigWatcher(LoadOptions opts, Config current);
+
+    /// Most recently loaded configuration
+    const Config& config() const { return config_; }
+
+    /// Options the configuration is loaded with
+    const LoadOptions& options() const { return opts_; }
+
+    /**
+     * @brief Whether any source differs from the last load
+     */
+    bool changed() const;
+
+    /**
+     * @brief Reload if changed()
+     *
+     * Each load also clears the find_dotenv() cache.
+     *
+     * @return true if a new configuration was loaded
+     * @throws Same as Config::load(); the previous configuration is kept
+     *         and the failed sources are not retried until they change
+     */
+    bool refresh();
+
+private:
+    struct Stamp {
+        bool exists = false;
+        std::filesystem::file_time_type mtime{};
+        std::uintmax_t size = 0;
+
+        bool operator==(const Stamp& other) const {
+            return exists == other.exists && mtime == other.mtime && size == other.size;
+        }
+        bool operator!=(const Stamp& other) const { return !(*this == other); }
+    };
+
+    static Stamp stamp(const std::string& path);
+    std::string dotenv_file() const;
+    void load();
+    void record();
+    void withdraw_dotenv();
+
+    LoadOptions opts_;
+    Config config_;
+    Stamp file_;
+    Stamp dotenv_;
+    uint64_t env_ = 0;
+
+    /// Variables the last .env set in the environment, with their values
+    std::vector<std::pair<std::string, std::string>> dotenv_vars_;
+};
+
+} // namespace confy
+
+#endif // CONFY_CONFIG_WATCHER_HPP
@@ -20,7 +20,9 @@
 
 #include "Value.hpp"
 #include "Errors.hpp"
+#include "StaticPath.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 
@@ -40,6 +42,106 @@ namespace confy {
  */
 std::vector<std::string> split_dot_path(const std::string& path);
 
+/**
+ * @brief Check if a path segment is a valid array index
+ *
+ * A valid index is a non-empty run of ASCII digits without leading zeros
+ * ("0" itself is allowed).
+ *
+ * @param segment The segment to check
+ * @return true if segment can index into an array
+ *
+ * Examples:
+ * - "0", "12" → true
+ * - "01", "-1", "x", "" → false
+ */
+bool is_array_index(const std::string& segment);
+
+/**
+ * @brief Value of an array-index segment, without throwing
+ *
+ * Indices too large for size_t saturate to StaticPath::NOT_AN_INDEX,
+ * which is out of range for every array, so callers report them as
+ * "index out of range" like any other index past the end.
+ *
+ * @param segment Segment for which is_array_index() is true
+ * @return The index, or StaticPath::NOT_AN_INDEX on overflow
+ */
+size_t parse_array_index(std::string_view segment) noexcept;
+
+/**
+ * @brief Outcome of a non-throwing path lookup
+ */
+enum class LookupStatus {
+    Found,          ///< Path resolved to a value
+    Missing,        ///< A segment was not found (RULE D1 KeyError case)
+    TypeMismatch    ///< Traversal hit a non-container (RULE D1 TypeError case)
+};
+
+/**
+ * @brief Result of a non-throwing path lookup
+ *
+ * Carries enough to rebuild the KeyError/TypeError a throwing lookup
+ * would raise, but formats nothing until message() or throw_if_error()
+ * is called, so misses cost no string building or unwinding.
+ */
+struct LookupResult {
+    /// Outcome of the lookup
+    LookupStatus status = LookupStatus::Missing;
+
+    /// Found: the value. TypeMismatch: the non-container that was hit.
+    const Value* value = nullptr;
+
+    /// Missing: the segment that was not found (view into the path)
+    std::string_view segment;
+
+    /// Missing: detail appended to the segment in KeyError
+    /// ("", " (not a valid array index)" or " (index out of range)")
+    const char* detail = "";
+
+    /// True if the path resolved
+    bool found() const noexcept { return status == LookupStatus::Found; }
+
+    explicit operator bool() const noexcept { return found(); }
+
+    /**
+     * @brief Build the error message a throwing lookup would use
+     *
+     * @param path The path that was looked up
+     * @return Message text, or empty string if found
+     */
+    std::string message(const std::string& path) const;
+
+    /**
+     * @brief Throw the exception a throwing lookup would raise
+     *
+     * @param path The path that was looked up
+     * @throws KeyError if status is Missing
+     * @throws TypeError if status is TypeMismatch
+     */
+    void throw_if_error(const std::string& path) const;
+};
+
+/**
+ * @brief Look up a dot-path without throwing
+ *
+ * Same resolution rules as get_by_dot(), but reports the outcome as a
+ * status instead of raising KeyError/TypeError, and does not allocate.
+ *
+ * @param data Source JSON object
+ * @param path Dot-separated path, viewed in place (its buffer must outlive
+ *        the result's segment view)
+ * @return Lookup result
+ *
+ * Example:
+ * ```cpp
+ * auto r = try_get_by_dot(cfg, "db.port");
+ * if (r) use(*r.value);
+ * else if (r.status == LookupStatus::TypeMismatch) log(r.message("db.port"));
+ * ```
+ */
+LookupResult try_get_by_dot(const Value& data, std::string_view path) noexcept;
+
 /**
  * @brief Get value from nested structure using dot-path (strict)
  *
@@ -84,6 +186,41 @@ const Value* get_by_dot(const Value& data, const std::string& path);
 const Value* get_by_dot(const Value& data, const std::string& path,
                        const Value& default_val);
 
+/**
+ * @brief Look up a compile-time tokenized path without throwing
+ *
+ * @param data Source JSON object
+ * @param path Path tokenized by StaticPath / "..."_cpath
+ * @return Lookup result
+ */
+LookupResult try_get_by_dot(const Value& data, const StaticPath& path) noexcept;
+
+/**
+ * @brief Get value using a compile-time tokenized path (strict)
+ *
+ * Same semantics as get_by_dot(const Value&, const std::string&), without
+ * splitting the path or re-validating array indices at runtime.
+ *
+ * @param data Source JSON object
+ * @param path Path tokenized by StaticPath / "..."_cpath
+ * @return Pointer to value at path
+ * @throws KeyError if any segment not found
+ * @throws TypeError if traversal hits non-container before final segment
+ */
+const Value* get_by_dot(const Value& data, const StaticPath& path);
+
+/**
+ * @brief Get value using a compile-time tokenized path (with default)
+ *
+ * @param data Source JSON object
+ * @param path Path tokenized by StaticPath / "..."_cpath
+ * @param default_val Value to return if path not found
+ * @return Pointer to value at path, or pointer to default_val if not found
+ * @throws TypeError if traversal hits non-container before final segment
+ */
+const Value* get_by_dot(const Value& data, const StaticPath& path,
+                       const Value& default_val);
+
 /**
  * @brief Set value in nested structure using dot-path
  *
@@ -116,6 +253,60 @@ const Value* get_by_dot(const Value& data, const std::string& path,
 void set_by_dot(Value& data, const std::string& path,
                 const Value& value, bool create_missing = true);
 
+/**
+ * @brief Build a nested Value from many (dot-path, value) pairs at once
+ *
+ * The batch counterpart of set_by_dot(create_missing = true). Each path
+ * is split once; build() sorts the pairs by path and walks them in
+ * order, so a prefix shared by consecutive paths is descended once and
+ * values are moved into place. The result does not depend on the order
+ * the pairs were added in:
+ * - The same path added twice keeps the value added last
+ * - A non-object value ends its path: pairs below it are skipped
+ * - An object value is a base: pairs below it are set inside it
+ *
+ * Example:
+ * ```cpp
+ * TreeBuilder tree;
+ * tree.add("db.port", 5432);
+ * tree.add("db.host", "localhost");
+ * tree.add("log", "info");
+ * Value cfg = tree.build();
+ * // Result: {"db": {"host": "localhost", "port": 5432}, "log": "info"}
+ * ```
+ */
+class TreeBuilder {
+public:
+    /// Reserve room for @p count pairs
+    void reserve(size_t count) { entries_.reserve(count); }
+
+    /**
+     * @brief Queue @p value at dot-path @p path
+     *
+     * Empty segments are ignored, as in split_dot_path(). The empty path
+     * stands for the root.
+     */
+    void add(std::string_view path, Value value);
+
+    /// Number of pairs queued
+    size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief Assemble the queued pairs into an object
+     *
+     * Leaves the builder empty.
+     */
+    Value build();
+
+private:
+    struct Entry {
+        std::string path;   ///< Segments joined by single dots
+        Value value;
+    };
+
+    std::vector<Entry> entries_;
+};
+
 /**
  * @brief Check if dot-path exists in nested structure
  *
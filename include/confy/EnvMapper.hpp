@@ -18,6 +18,8 @@
 #define CONFY_ENVMAPPER_HPP
 
 #include "confy/Value.hpp"
+#include "confy/KeySet.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <set>
@@ -94,6 +96,18 @@ std::string strip_prefix(const std::string& var_name, const std::string& prefix)
 std::vector<std::pair<std::string, std::string>>
 collect_env_vars(const std::optional<std::string>& prefix);
 
+/**
+ * @brief Fingerprint of the variables collect_env_vars() would return
+ *
+ * Hashes the selected names and values, in order, without copying them.
+ * Equal fingerprints mean an unchanged filtered environment (up to a
+ * 64-bit hash collision), so the env layer of the previous load holds.
+ *
+ * @param prefix Same as for collect_env_vars()
+ * @return Fingerprint (0 when prefix is nullopt)
+ */
+uint64_t env_fingerprint(const std::optional<std::string>& prefix);
+
 /**
  * @brief Flatten a nested Value object into dot-path keys.
  *
@@ -103,8 +117,11 @@ collect_env_vars(const std::optional<std::string>& prefix);
  *   {"database": {"host": "x", "port": 5432}, "debug": true}
  *   -> {"database.host", "database.port", "debug", "database"}
  *
+ * The remapping itself uses the hashed KeySet; this ordered set is
+ * kept for callers that want to list the keys.
+ *
  * @param data The Value to flatten
- * @param prefix Optional prefix for recursion (internal use)
+ * @param prefix Optional prefix prepended to every key
  * @return Set of all dot-path keys in the structure
  */
 std::set<std::string> flatten_keys(const Value& data, const std::string& prefix = "");
@@ -128,6 +145,18 @@ std::set<std::string> flatten_keys(const Value& data, const std::string& prefix
  * @param load_dotenv Whether .env loading was enabled (for conservative mode)
  * @return Remapped key, or empty string if should be discarded
  */
+std::string remap_env_key(
+    const std::string& dot_path,
+    const KeySet& base_keys,
+    const std::optional<std::string>& prefix,
+    bool load_dotenv
+);
+
+/**
+ * @brief remap_env_key() against an ordered set of base keys.
+ *
+ * Queries the set directly (O(log N) per lookup); no KeySet is built.
+ */
 std::string remap_env_key(
     const std::string& dot_path,
     const std::set<std::string>& base_keys,
@@ -168,6 +197,9 @@ Value env_vars_to_nested(
  * @param prefix The prefix used for filtering
  * @param load_dotenv Whether .env loading was enabled
  * @return Flat map of dot-path keys to values
+ *
+ * The base keys are built with KeySet::from_layers(); the set from the
+ * previous call is reused when the structure is unchanged.
  */
 std::vector<std::pair<std::string, Value>> remap_and_flatten_env_data(
     const Value& nested_env_data,
@@ -177,6 +209,100 @@ std::vector<std::pair<std::string, Value>> remap_and_flatten_env_data(
     bool load_dotenv
 );
 
+/**
+ * @brief remap_and_flatten_env_data() against prebuilt base keys.
+ */
+std::vector<std::pair<std::string, Value>> remap_and_flatten_env_data(
+    const Value& nested_env_data,
+    const KeySet& base_keys,
+    const std::optional<std::string>& prefix,
+    bool load_dotenv
+);
+
+/**
+ * @brief Memoized mapping from environment variable names to final dot-paths
+ *
+ * The remap (RULE E4-E7) depends only on the variable names, the prefix,
+ * the load_dotenv mode and the base keys, as long as no value parses to
+ * an object. A plan records the outcome for one such combination, so a
+ * reload with the same names only re-parses the values.
+ *
+ * load_env_vars() keeps the plan of its previous call and rebuilds it
+ * when matches() fails.
+ */
+class RemapPlan {
+public:
+    using EnvVars = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @brief Run the remap pipeline on the names of @p env_vars
+     *
+     * @param env_vars Collected variables (values are ignored)
+     * @param base_keys Dot-paths of defaults + config file
+     * @param prefix The prefix used for filtering
+     * @param load_dotenv Whether .env loading was enabled
+     */
+    static RemapPlan build(const EnvVars& env_vars,
+                           const KeySet& base_keys,
+                           const std::optional<std::string>& prefix,
+                           bool load_dotenv);
+
+    /**
+     * @brief Whether the plan was built for these names and this context
+     *
+     * Base keys are compared by fingerprint and size.
+     */
+    bool matches(const EnvVars& env_vars,
+                 const KeySet& base_keys,
+                 const std::optional<std::string>& prefix,
+                 bool load_dotenv) const;
+
+    /**
+     * @brief Parse the values of @p env_vars and place them by the plan
+     *
+     * @param env_vars Variables with the names the plan was built for
+     * @return Env layer as load_env_vars() builds it, or nullopt if some
+     *         value parses to an object (the full pipeline is needed)
+     */
+    std::optional<Value> apply(const EnvVars& env_vars) const;
+
+    /// Number of values the plan assigns
+    size_t size() const { return steps_.size(); }
+
+    /**
+     * @brief (final dot-path, variable name) of every value the plan assigns
+     */
+    std::vector<std::pair<std::string, std::string>> targets() const;
+
+private:
+    std::optional<std::string> prefix_;
+    bool load_dotenv_ = false;
+    uint64_t base_fingerprint_ = 0;
+    size_t base_size_ = 0;
+    std::vector<std::string> names_;
+    std::vector<std::pair<size_t, std::string>> steps_;  ///< (env_vars index, final dot-path)
+};
+
+/**
+ * @brief Variable behind each dot-path of the load_env_vars() result.
+ *
+ * Runs the remap for the current environment and reports where each
+ * variable landed. A variable whose value parses to an object covers
+ * every path below its own.
+ *
+ * @param prefix Optional prefix filter (nullopt returns nothing)
+ * @param defaults_data Original defaults
+ * @param file_data Original file data
+ * @param load_dotenv Whether .env loading was enabled
+ * @return (dot-path, variable name) pairs
+ */
+std::vector<std::pair<std::string, std::string>> env_var_origins(
+    const std::optional<std::string>& prefix,
+    const Value& defaults_data,
+    const Value& file_data,
+    bool load_dotenv
+);
+
 /**
  * @brief Full environment variable loading pipeline.
  *
@@ -186,6 +312,11 @@ std::vector<std::pair<std::string, Value>> remap_and_flatten_env_data(
  * 3. remap_and_flatten_env_data() - Smart remapping
  * 4. Structure into final Value
  *
+ * Steps 2-3 are memoized in a RemapPlan while the variable names and
+ * the base keys stay the same. When the whole filtered environment is
+ * unchanged (see env_fingerprint()), the previous result is returned
+ * without collecting the variables again.
+ *
  * @param prefix Optional prefix filter (nullopt disables)
  * @param base_structure Combined defaults + file structure for remapping
  * @param defaults_data Original defaults
@@ -9,6 +9,7 @@
  * - ConfigParseError: JSON/TOML syntax errors
  * - KeyError: Dot-path segment not found
  * - TypeError: Traversal into non-container
+ * - SchemaValidationError: Configuration violates a Schema
  */
 
 #ifndef CONFY_ERRORS_HPP
@@ -214,6 +215,94 @@ private:
     std::string actual_;
 };
 
+/**
+ * @brief Configuration violates a Schema
+ *
+ * Contains every violation found (not just the first), plus the subset
+ * that are missing required keys.
+ */
+class SchemaValidationError : public ConfigError {
+public:
+    /**
+     * @brief Construct with violation descriptions
+     * @param violations Human-readable violations ("path: problem")
+     * @param missing_keys Dot-paths of missing required keys
+     */
+    SchemaValidationError(std::vector<std::string> violations,
+                          std::vector<std::string> missing_keys)
+        : ConfigError(format_message(violations))
+        , violations_(std::move(violations))
+        , missing_keys_(std::move(missing_keys))
+    {}
+
+    /**
+     * @brief Get all violation descriptions
+     */
+    const std::vector<std::string>& violations() const noexcept {
+        return violations_;
+    }
+
+    /**
+     * @brief Get the required keys that were missing
+     */
+    const std::vector<std::string>& missing_keys() const noexcept {
+        return missing_keys_;
+    }
+
+private:
+    std::vector<std::string> violations_;
+    std::vector<std::string> missing_keys_;
+
+    static std::string format_message(const std::vector<std::string>& violations) {
+        std::ostringstream oss;
+        oss << "Configuration failed schema validation: [";
+        for (size_t i = 0; i < violations.size(); ++i) {
+            if (i > 0) oss << ", ";
+            oss << "'" << violations[i] << "'";
+        }
+        oss << "]";
+        return oss.str();
+    }
+};
+
+/**
+ * @brief A ${...} reference could not be expanded
+ *
+ * Raised for references to missing keys, unset environment variables,
+ * malformed references and reference cycles.
+ */
+class InterpolationError : public ConfigError {
+public:
+    /**
+     * @brief Construct with the path being expanded and the reason
+     * @param path Dot-path of the string holding the reference
+     * @param reason What went wrong (e.g., "reference cycle a -> b -> a")
+     */
+    InterpolationError(std::string path, std::string reason)
+        : ConfigError("Cannot interpolate '" + path + "': " + reason)
+        , path_(std::move(path))
+        , reason_(std::move(reason))
+    {}
+
+    /**
+     * @brief Get the dot-path of the string holding the reference
+     */
+    const std::string& path() const noexcept {
+        return path_;
+    }
+
+    /**
+     * @brief Get the reason the reference could not be expanded
+     */
+    const std::string& reason() const noexcept {
+        return reason_;
+    }
+
+private:
+    std::string path_;
+    std::string reason_;
+};
+
 } // namespace confy
 
 #endif // CONFY_ERRORS_HPP
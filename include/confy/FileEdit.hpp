@@ -0,0 +1,123 @@
+/**
+ * @file FileEdit.hpp
+ * @brief Crash-safe, minimal-rewrite editing of configuration files
+ *
+ * update_config_file() applies dot-path assignments to a JSON or TOML
+ * file. Where possible only the bytes of each changed value are
+ * replaced, so the rest of the file (formatting, key order, TOML
+ * comments) is left exactly as it was. When a value cannot be patched
+ * in place (new key, TOML table, multi-line value, ...) the whole file
+ * is re-serialized instead.
+ *
+ * Either way the result is written with write_file_atomic(): a
+ * temporary file in the same directory is written, flushed to disk and
+ * renamed over the original, so a crash leaves the old or the new file,
+ * never a truncated one.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_FILEEDIT_HPP
+#define CONFY_FILEEDIT_HPP
+
+#include "confy/Value.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Byte range [begin, end) of a value in a file's text
+ */
+struct TextSpan {
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+/**
+ * @brief Outcome of update_config_file()
+ */
+struct FileUpdateResult {
+    /// True if the values were patched in place, false if the file was
+    /// re-serialized (or newly created)
+    bool patched = false;
+};
+
+/**
+ * @brief Replace a file atomically
+ *
+ * If @p path is a symlink, the file it resolves to is replaced and the
+ * link is kept. The content is written to a temporary file next to that
+ * file, flushed to stable storage, given the owner, group (where the
+ * process is permitted to) and permissions of the existing file (if
+ * any) and renamed over it. On failure the temporary file is removed
+ * and the original is untouched.
+ *
+ * @param path Target file
+ * @param write Callback producing the new content
+ * @throws ConfigError if the file cannot be written or replaced;
+ *         exceptions from @p write propagate
+ */
+void write_file_atomic(const std::string& path,
+                       const std::function<void(std::ostream&)>& write);
+
+/**
+ * @brief Replace a file atomically with the given text
+ */
+void write_file_atomic(const std::string& path, std::string_view content);
+
+/**
+ * @brief Locate the text of the value at a dot-path in a JSON document
+ *
+ * Object keys and array indices are matched per RULE D1-D6; keys with
+ * escape sequences are decoded before comparison.
+ *
+ * @param text JSON document
+ * @param path Dot-separated path (empty for the root value)
+ * @return Span of the value, or nullopt if it is not present or the
+ *         text is malformed
+ */
+std::optional<TextSpan> find_json_value_span(std::string_view text, const std::string& path);
+
+/**
+ * @brief Locate the text of a single-line value in a TOML document
+ *
+ * Only the common layout is recognized: `key = value` under the
+ * `[table]` header spelling the rest of the path (or before the first
+ * header for top-level keys). Dotted keys, inline tables, arrays of
+ * tables and multi-line values return nullopt.
+ *
+ * @param text TOML document
+ * @param path Dot-separated path
+ * @return Span of the value (comments excluded), or nullopt
+ */
+std::optional<TextSpan> find_toml_value_span(std::string_view text, const std::string& path);
+
+/**
+ * @brief Apply dot-path assignments to a JSON or TOML file
+ *
+ * The file is parsed once, every assignment is applied in order with
+ * set_by_dot(..., create_missing = true), and the file is replaced
+ * atomically. Existing values are patched in place when every
+ * assignment can be; the patched text is re-parsed and only kept if it
+ * yields exactly the updated tree. A missing file is created.
+ *
+ * @param path JSON or TOML file (format chosen by extension)
+ * @param assignments (dot-path, value) pairs
+ * @return Whether the file was patched in place
+ * @throws ConfigError for unsupported extensions or write failures
+ * @throws ConfigParseError if the existing file is malformed
+ */
+FileUpdateResult update_config_file(const std::string& path,
+                                    const std::vector<std::pair<std::string, Value>>& assignments);
+
+} // namespace confy
+
+#endif // CONFY_FILEEDIT_HPP
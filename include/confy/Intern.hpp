@@ -0,0 +1,175 @@
+/**
+ * @file Intern.hpp
+ * @brief Key interning table shared across snapshots and layers
+ *
+ * Configuration keys ("database", "host", "port", ...) repeat across every
+ * layer, every reloaded snapshot and every auxiliary structure built from
+ * them (key sets, provenance tables, path indexes). The KeyTable stores
+ * each distinct key exactly once in immutable, arena-allocated storage and
+ * hands out stable views into it.
+ *
+ * Interned keys from the same table compare by pointer, so hot lookups in
+ * hash sets and maps keyed by InternedKey never touch the characters.
+ *
+ * Note: Value (nlohmann::json) owns its object keys by value, so the table
+ * cannot share storage inside a Value tree itself. The library keeps a
+ * private KeyTable per snapshot for the leaf paths it holds outside the
+ * tree (the Provenance table filled by deep_merge() and the entries of a
+ * PathIndex), so that storage is released with the snapshot. The global
+ * table never shrinks; use it only for a bounded set of keys.
+ */
+
+#ifndef CONFY_INTERN_HPP
+#define CONFY_INTERN_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Handle to an interned key
+ *
+ * A thin wrapper around a view into KeyTable storage. Two handles obtained
+ * from the same table are equal if and only if they point to the same
+ * storage, so equality and hashing are O(1) regardless of key length.
+ *
+ * A default-constructed InternedKey is empty and compares equal only to
+ * other empty handles.
+ */
+class InternedKey {
+public:
+    InternedKey() = default;
+
+    /**
+     * @brief View of the interned characters (valid for the table lifetime)
+     */
+    std::string_view view() const noexcept { return view_; }
+
+    /**
+     * @brief Convert to an owning string
+     */
+    std::string str() const { return std::string(view_); }
+
+    /**
+     * @brief Whether this handle refers to an empty key
+     */
+    bool empty() const noexcept { return view_.empty(); }
+
+    friend bool operator==(const InternedKey& a, const InternedKey& b) noexcept {
+        return a.view_.data() == b.view_.data() && a.view_.size() == b.view_.size();
+    }
+
+    friend bool operator!=(const InternedKey& a, const InternedKey& b) noexcept {
+        return !(a == b);
+    }
+
+    /**
+     * @brief Lexicographic ordering by content (for sorted containers)
+     */
+    friend bool operator<(const InternedKey& a, const InternedKey& b) noexcept {
+        return a.view_ < b.view_;
+    }
+
+private:
+    friend class KeyTable;
+    explicit InternedKey(std::string_view view) noexcept : view_(view) {}
+
+    std::string_view view_;
+};
+
+/**
+ * @brief Pointer-based hash for InternedKey
+ */
+struct InternedKeyHash {
+    size_t operator()(const InternedKey& key) const noexcept {
+        return std::hash<const void*>{}(key.view().data()) ^ key.view().size();
+    }
+};
+
+/**
+ * @brief Append-only table of immutable key strings
+ *
+ * Keys are copied once into fixed-size arena blocks; views handed out by
+ * intern() stay valid for the lifetime of the table. Entries are never
+ * removed, which is what makes the views safe to share across snapshots.
+ *
+ * Thread-safety: all member functions are safe to call concurrently.
+ *
+ * Example:
+ * @code
+ * KeyTable& keys = KeyTable::global();
+ * InternedKey a = keys.intern("database");
+ * InternedKey b = keys.intern(std::string("data") + "base");
+ * assert(a == b);                         // pointer comparison
+ * assert(a.view().data() == b.view().data());
+ * @endcode
+ */
+class KeyTable {
+public:
+    KeyTable() = default;
+    KeyTable(const KeyTable&) = delete;
+    KeyTable& operator=(const KeyTable&) = delete;
+
+    /**
+     * @brief Intern a key, returning the shared handle
+     *
+     * @param key Key characters (need not outlive the call)
+     * @return Handle to the single stored copy of key
+     */
+    InternedKey intern(std::string_view key);
+
+    /**
+     * @brief Look up a key without inserting it
+     *
+     * @param key Key characters
+     * @return Handle if the key was interned before, empty handle otherwise
+     */
+    InternedKey find(std::string_view key) const;
+
+    /**
+     * @brief Number of distinct keys stored
+     */
+    size_t size() const;
+
+    /**
+     * @brief Bytes of character storage reserved by the arena
+     */
+    size_t storage_bytes() const;
+
+    /**
+     * @brief Process-wide table for application keys (never shrinks)
+     */
+    static KeyTable& global();
+
+private:
+    /// Size of each arena block; longer keys get a dedicated block
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    std::string_view store(std::string_view key);
+
+    mutable std::mutex mutex_;
+    std::unordered_set<std::string_view> index_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t block_used_ = BLOCK_SIZE;
+    size_t storage_bytes_ = 0;
+};
+
+/**
+ * @brief Intern a key in the process-wide table
+ *
+ * Shorthand for KeyTable::global().intern(key).
+ */
+inline InternedKey intern_key(std::string_view key) {
+    return KeyTable::global().intern(key);
+}
+
+} // namespace confy
+
+#endif // CONFY_INTERN_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file Interpolator.hpp
+ * @brief Lazy ${...} expansion over a Config snapshot
+ *
+ * String values may refer to other keys and to environment variables:
+ *
+ *   "url": "http://${server.host}:${server.port}/"
+ *   "home": "${env:HOME}"
+ *   "pool": "${database.pool}"       (a whole-string reference keeps the type)
+ *
+ * Nothing is expanded up front. get() expands only the strings on the
+ * requested path and the keys they refer to, and memoizes each expanded
+ * string together with what it referred to. Those references form a
+ * dependency graph: a reference back to a string being expanded is
+ * reported as a cycle, and update() with a reloaded snapshot drops only
+ * the cached strings that depend, directly or through other strings, on
+ * a key that changed or an environment variable whose value changed.
+ *
+ * Expansion rules:
+ * - `${a.b}` is replaced by the (expanded) value at dot-path a.b
+ * - `${env:NAME}` is replaced by environment variable NAME
+ * - `$${` is a literal `${`
+ * - A string that is exactly one reference becomes the referenced value
+ *   (objects and arrays included); an environment variable is typed with
+ *   parse_value()
+ * - Otherwise references are spliced into the text (non-strings as
+ *   JSON) and the result is typed with parse_value()
+ *
+ * @code
+ * confy::Interpolator values(confy::Config::load(opts));
+ * std::string url = values.get<std::string>("service.url", "");
+ *
+ * if (watcher.refresh()) {
+ *     values.update(watcher.config());   // keeps what did not change
+ * }
+ * @endcode
+ *
+ * Not thread-safe: lookups fill the cache. Use one instance per thread
+ * or synchronize externally.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_INTERPOLATOR_HPP
+#define CONFY_INTERPOLATOR_HPP
+
+#include "confy/Config.hpp"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Config view that expands ${...} references on access
+ */
+class Interpolator {
+public:
+    /**
+     * @brief Expand references within @p snapshot
+     */
+    explicit Interpolator(Config snapshot);
+
+    /// Snapshot being expanded (unexpanded values)
+    const Config& config() const { return snapshot_; }
+
+    /**
+     * @brief Expanded value at dot-path
+     *
+     * Objects and arrays are returned with every reference inside them
+     * expanded.
+     *
+     * @throws KeyError if path not found (RULE D1)
+     * @throws TypeError if traversal encounters non-object (RULE D1)
+     * @throws InterpolationError if a reference cannot be expanded
+     */
+    Value get(const std::string& path);
+
+    /**
+     * @brief Expanded value at dot-path with type conversion and default
+     *
+     * @throws TypeError if the value cannot convert to T
+     * @throws InterpolationError if a reference cannot be expanded
+     */
+    template<typename T>
+    T get(const std::string& path, const T& default_val);
+
+    /**
+     * @brief Expanded value at dot-path, or std::nullopt if missing
+     *
+     * @throws TypeError if traversal encounters non-object
+     * @throws InterpolationError if a reference cannot be expanded
+     */
+    std::optional<Value> get_optional(const std::string& path);
+
+    /**
+     * @brief Whole configuration with every reference expanded
+     *
+     * @throws InterpolationError if a reference cannot be expanded
+     */
+    Value resolve_all();
+
+    /**
+     * @brief Switch to a reloaded snapshot
+     *
+     * Compares @p next with the current snapshot and re-reads the
+     * environment variables that were referenced, then drops the cached
+     * expansions affected by a difference. The rest stay valid.
+     *
+     * @return Number of cached expansions dropped
+     */
+    size_t update(Config next);
+
+    /// Number of cached expansions
+    size_t cached() const { return cache_.size(); }
+
+private:
+    /// One expanded string and what it referred to
+    struct Node {
+        Value value;
+        std::vector<std::string> refs;   ///< Dot-paths referred to
+        std::vector<std::string> env;    ///< Environment variables referred to
+    };
+
+    Value expand_tree(const std::string& path, const Value& value);
+    void expand_in_place(Value& node, std::string& path);
+    const Value& expand_string(const std::string& path, const std::string& text);
+    Value expand_text(const std::string& path, const std::string& text, Node& node);
+    Value lookup(const std::string& path, const std::string& ref, Node& node, bool& is_env);
+
+    void invalidate(std::vector<std::string> changed);
+    void drop(std::map<std::string, Node>::iterator it, std::vector<std::string>& work);
+
+    Config snapshot_;
+
+    /// Expanded strings by dot-path (ordered for subtree scans)
+    std::map<std::string, Node> cache_;
+
+    /// Referenced dot-path -> cached strings referring to it
+    std::map<std::string, std::vector<std::string>> dependents_;
+
+    /// Environment variable -> (value seen, cached strings referring to it)
+    std::map<std::string, std::pair<std::optional<std::string>, std::vector<std::string>>> env_;
+
+    /// Strings being expanded, outermost first (cycle detection)
+    std::vector<std::string> expanding_;
+};
+
+// =============================================================================
+// Template Implementation
+// =============================================================================
+
+template<typename T>
+T Interpolator::get(const std::string& path, const T& default_val) {
+    auto opt = get_optional(path);
+    if (!opt.has_value()) {
+        return default_val;
+    }
+
+    try {
+        return opt->get<T>();
+    } catch (const nlohmann::json::type_error& e) {
+        throw TypeError(path, "compatible type", e.what());
+    }
+}
+
+} // namespace confy
+
+#endif // CONFY_INTERPOLATOR_HPP
@@ -0,0 +1,126 @@
+/**
+ * @file KeySet.hpp
+ * @brief Compact hashed set of configuration dot-paths
+ *
+ * Environment remapping (RULE E5-E7) asks, for every variable, whether a
+ * dot-path exists in the defaults + file structure and whether any path
+ * lies below a given section. A KeySet answers both in O(1): paths live
+ * once in a character arena and an open-addressing table holds their
+ * 64-bit hashes, with the characters compared on a hash match.
+ *
+ * @code
+ * confy::KeySet keys = confy::KeySet::from_layers(defaults, file_data);
+ * keys.contains("database.host");      // exact path
+ * keys.contains_prefix("feature_flags"); // the path or anything below it
+ * @endcode
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_KEY_SET_HPP
+#define CONFY_KEY_SET_HPP
+
+#include "confy/Value.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Set of dot-paths with section-prefix queries
+ *
+ * Query methods are const and safe to call from several threads.
+ */
+class KeySet {
+public:
+    /// Empty set
+    KeySet() = default;
+
+    /**
+     * @brief Every dot-path of @p data, sections included (as flatten_keys())
+     */
+    explicit KeySet(const Value& data);
+
+    /// Set of the given paths
+    KeySet(std::initializer_list<std::string_view> paths);
+
+    /// Set of the paths in [first, last)
+    template <typename It>
+    KeySet(It first, It last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    /**
+     * @brief Dot-paths of the remap base: @p file sections over @p defaults
+     *
+     * Equivalent to KeySet(base) where base is @p defaults with each
+     * top-level key of @p file replacing its counterpart, built in one
+     * traversal without materializing base. Non-object layers add nothing.
+     */
+    static KeySet from_layers(const Value& defaults, const Value& file);
+
+    /**
+     * @brief Whether from_layers(@p defaults, @p file) would equal this set
+     *
+     * Verifies without building or allocating per path, so a reload with
+     * an unchanged structure can keep its KeySet.
+     */
+    bool same_as_layers(const Value& defaults, const Value& file) const;
+
+    /// Add a path
+    void insert(std::string_view path);
+
+    /// Whether @p path is in the set
+    bool contains(std::string_view path) const;
+
+    /**
+     * @brief Whether @p prefix is in the set or some path starts with
+     *        @p prefix followed by '.'
+     */
+    bool contains_prefix(std::string_view prefix) const;
+
+    /// Number of paths
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Order-independent hash of the paths
+     *
+     * Equal sets have equal fingerprints, whatever the insertion order.
+     */
+    uint64_t fingerprint() const { return fingerprint_; }
+
+private:
+    enum : uint8_t {
+        KEY = 1,        ///< A path in the set
+        SECTION = 2     ///< A proper prefix (up to a '.') of a path in the set
+    };
+
+    struct Slot {
+        uint64_t hash;
+        uint32_t offset;
+        uint32_t length;
+        uint8_t flags;  ///< 0 = empty
+    };
+
+    size_t find_slot(std::string_view path, uint64_t hash) const;
+    void mark(std::string_view path, uint8_t flag);
+    void grow();
+
+    std::vector<Slot> slots_;
+    std::string chars_;
+    size_t used_ = 0;           ///< Occupied slots (keys and sections)
+    size_t size_ = 0;           ///< Slots flagged KEY
+    uint64_t fingerprint_ = 0;
+};
+
+} // namespace confy
+
+#endif // CONFY_KEY_SET_HPP
@@ -0,0 +1,255 @@
+/**
+ * @file LayeredConfig.hpp
+ * @brief Lazy layered configuration (no eager merge)
+ *
+ * LayeredConfig keeps each source (defaults, file, env, overrides) as a
+ * separate layer and resolves lookups by probing the layers from highest
+ * to lowest precedence. Only the subtree a caller actually requests is
+ * merged, so startup does not pay for merging keys that nobody reads.
+ *
+ * Resolution follows the same rules as deep_merge():
+ * - RULE P2: Objects at the same path are merged recursively
+ * - RULE P3: A non-object replaces everything below it entirely
+ * - null never overrides a lower layer
+ *
+ * For any path, LayeredConfig::get(path) returns exactly what
+ * Config::get(path) would return on the eagerly merged tree.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_LAYEREDCONFIG_HPP
+#define CONFY_LAYEREDCONFIG_HPP
+
+#include "confy/Config.hpp"
+#include "confy/DotPath.hpp"
+#include "confy/Value.hpp"
+#include "confy/Errors.hpp"
+#include "confy/Provenance.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Configuration that resolves lookups across unmerged layers
+ *
+ * Thread-safety: const member functions are safe for concurrent use;
+ * add_layer() requires external synchronization.
+ *
+ * Example:
+ * @code
+ * LoadOptions opts;
+ * opts.defaults = huge_defaults;          // not copied into a merged tree
+ * opts.overrides = {{"server.port", 9090}};
+ *
+ * LayeredConfig cfg = LayeredConfig::load(opts);
+ * int port = cfg.get<int>("server.port", 8080);   // probes overrides first
+ * Value server = cfg.get("server");                // merges only "server"
+ * @endcode
+ */
+class LayeredConfig {
+public:
+    /**
+     * @brief A single named source layer
+     */
+    struct Layer {
+        /// Source name ("defaults", "file", "env", "overrides", ...)
+        std::string name;
+
+        /// Layer data (always an object)
+        Value data;
+    };
+
+    /**
+     * @brief Default constructor (no layers)
+     */
+    LayeredConfig() = default;
+
+    // =========================================================================
+    // Static Factories
+    // =========================================================================
+
+    /**
+     * @brief Load all sources as separate layers
+     *
+     * Reads the same sources as Config::load() in the same order, keeps
+     * them unmerged, then validates mandatory keys lazily.
+     *
+     * @param opts Loading options specifying all sources
+     * @return LayeredConfig with one layer per enabled source
+     *
+     * @throws FileNotFoundError if file_path specified but not found
+     * @throws ConfigParseError if config file has syntax errors
+     * @throws MissingMandatoryConfig if mandatory keys are missing
+     * @throws SchemaValidationError if opts.schema is set and not satisfied
+     */
+    static LayeredConfig load(const LoadOptions& opts);
+
+    /**
+     * @brief Load all sources as separate layers without validation
+     *
+     * Used by Config::load() to build the layers it merges eagerly.
+     *
+     * @param opts Loading options specifying all sources
+     * @param provenance If non-null, receives one layer per layer returned,
+     *        with what each loader knows about its values (file text,
+     *        variable names, override keys)
+     * @return LayeredConfig with one layer per enabled source
+     */
+    static LayeredConfig from_sources(const LoadOptions& opts,
+                                      Provenance* provenance = nullptr);
+
+    // =========================================================================
+    // Layers
+    // =========================================================================
+
+    /**
+     * @brief Add a layer with higher precedence than all existing layers
+     *
+     * @param data Layer data (must be an object)
+     * @param name Source name for diagnostics
+     * @throws TypeError if data is not an object
+     */
+    void add_layer(Value data, std::string name = "");
+
+    /**
+     * @brief Get all layers, lowest precedence first
+     */
+    const std::vector<Layer>& layers() const { return layers_; }
+
+    // =========================================================================
+    // Value Access (Dot-Path)
+    // =========================================================================
+
+    /**
+     * @brief Get value at dot-path, merging only the requested subtree
+     *
+     * @param path Dot-separated path
+     * @return Resolved value at path
+     *
+     * @throws KeyError if path not found (RULE D1)
+     * @throws TypeError if traversal encounters non-container (RULE D1)
+     */
+    Value get(const std::string& path) const;
+
+    /**
+     * @brief Get value at dot-path with type conversion and default
+     *
+     * @tparam T Expected type
+     * @param path Dot-separated path
+     * @param default_val Value to return if path not found
+     * @return Value at path converted to T, or default_val
+     *
+     * @throws TypeError if the value cannot convert to T or traversal
+     *         encounters a non-container (RULE D2)
+     */
+    template<typename T>
+    T get(const std::string& path, const T& default_val) const;
+
+    /**
+     * @brief Get value at dot-path with optional return
+     *
+     * @param path Dot-separated path
+     * @return Resolved value, or std::nullopt if missing
+     *
+     * @throws TypeError if traversal encounters non-container
+     */
+    std::optional<Value> get_optional(const std::string& path) const;
+
+    /**
+     * @brief Check if dot-path exists in any layer's effective view
+     *
+     * @param path Dot-separated path
+     * @return true if path resolves
+     *
+     * @throws TypeError if traversal encounters non-container (RULE D6)
+     */
+    bool contains(const std::string& path) const;
+
+    // =========================================================================
+    // Materialization
+    // =========================================================================
+
+    /**
+     * @brief Merge all layers into a single tree
+     *
+     * Equivalent to deep_merge_all() over the layers.
+     *
+     * @return Fully merged Value
+     */
+    Value materialize() const;
+
+    /**
+     * @brief Merge all layers, recording the winning layer of each leaf
+     *
+     * @param provenance Filled by from_sources() for these layers
+     * @return Fully merged Value
+     */
+    Value materialize(Provenance& provenance) const;
+
+    /**
+     * @brief Merge all layers into a Config
+     */
+    Config to_config() const { return Config(materialize()); }
+
+private:
+    std::vector<Layer> layers_;
+
+    /**
+     * @brief Resolution state at one node of the effective tree
+     *
+     * Either a single value (leaf, array, or object from one layer) or a
+     * run of objects from several layers that still needs merging.
+     * Sources are ordered lowest precedence first.
+     */
+    struct Resolved {
+        std::vector<const Value*> sources;
+    };
+
+    /**
+     * @brief Walk the effective tree to path
+     *
+     * @param path Dot-separated path
+     * @param out Receives the resolved node
+     * @param missing Receives the KeyError segment text if not found
+     * @return Found; Missing; or TypeMismatch for traversal into a
+     *         non-container, which is then the only entry of out.sources
+     */
+    LookupStatus resolve(const std::string& path, Resolved& out, std::string& missing) const;
+
+    /**
+     * @brief Merge the sources of a resolved node into one Value
+     */
+    static Value merge_sources(const Resolved& node);
+
+    /**
+     * @brief Validate mandatory keys against the effective view
+     * @throws MissingMandatoryConfig if any keys are missing
+     */
+    void validate_mandatory(const std::vector<std::string>& mandatory) const;
+};
+
+// =============================================================================
+// Template Implementation
+// =============================================================================
+
+template<typename T>
+T LayeredConfig::get(const std::string& path, const T& default_val) const {
+    auto opt = get_optional(path);
+    if (!opt.has_value()) {
+        return default_val;
+    }
+
+    try {
+        return opt->get<T>();
+    } catch (const nlohmann::json::type_error& e) {
+        throw TypeError(path, "compatible type", e.what());
+    }
+}
+
+} // namespace confy
+
+#endif // CONFY_LAYEREDCONFIG_HPP
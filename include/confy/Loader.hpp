@@ -116,34 +116,98 @@ struct DotenvResult {
     bool found = false;
 };
 
+/**
+ * @brief Options for parse_dotenv_file().
+ */
+struct DotenvOptions {
+    /// Expand ${VAR} and ${VAR:-default} in unquoted and double-quoted values
+    bool interpolate = true;
+
+    /// Resolve ${VAR} from earlier entries before the environment, as
+    /// python-dotenv does when the entries will override it
+    bool override_existing = false;
+};
+
 /**
  * @brief Parse a .env file.
  *
- * Minimal implementation following Python's python-dotenv behavior:
- * - Parse KEY=value format
- * - Handle comments (# at start of line)
- * - Support quoted values (single and double quotes)
- * - Handle inline comments (# after value)
- * - Support export prefix (export KEY=value)
+ * Follows python-dotenv's grammar:
+ * - KEY=value lines, optionally prefixed with `export`
+ * - Full-line comments, and ` # comment` after a value (a `#` with no
+ *   whitespace before it is part of an unquoted value)
+ * - Single-quoted values are literal except for \\ and \'
+ * - Double-quoted values decode \n, \t, \" and the other C escapes
+ * - Quoted values may span several lines (certificates, keys)
+ * - ${VAR} and ${VAR:-default} expand in unquoted and double-quoted
+ *   values, from the environment or an earlier entry (see DotenvOptions)
+ * - A line that does not parse is skipped; parsing resumes on the next
+ *
+ * The file is read with one read() (memory-mapped only above 4 MiB) and
+ * scanned once; keys and values are only copied out when an entry is
+ * complete. A file truncated while it is read yields partial text, not
+ * a fault.
  *
  * DOES NOT modify the process environment.
  *
  * @param path Path to .env file
- * @return DotenvResult with parsed entries
+ * @param options Interpolation behaviour
+ * @return DotenvResult with parsed entries, in file order
+ */
+DotenvResult parse_dotenv_file(const std::string& path, const DotenvOptions& options = {});
+
+/**
+ * @brief Where find_dotenv() searches.
+ */
+struct DotenvSearch {
+    /// Directory to start in (empty = current working directory)
+    std::string start_dir;
+
+    /// Last directory searched, e.g. a repository root (empty = the
+    /// filesystem root). Ignored if it is not an ancestor of start_dir.
+    std::string stop_dir;
+
+    /// Also stop in the first directory that contains this entry, after
+    /// searching it (e.g. ".git"; empty = no marker)
+    std::string stop_marker;
+};
+
+/**
+ * @brief Search for a .env file from a directory upwards.
+ *
+ * Looks for a regular file named ".env" in the start directory and then
+ * in each parent, with one stat() per directory (plus one for the stop
+ * marker, if given). Similar to python-dotenv's find_dotenv(usecwd=True).
+ *
+ * Files found are cached for the process, keyed by the absolute start
+ * directory and the boundary, and a cached file is confirmed with one
+ * stat() before it is returned. "Not found" is never cached, so a .env
+ * created later is found by the next call. Only a .env created closer
+ * to the start than the cached one is missed, until clear_dotenv_cache()
+ * (which a ConfigWatcher calls on every reload).
+ *
+ * @param search Start directory and optional stop boundary
+ * @return Absolute path to the .env file, or empty string if not found
  */
-DotenvResult parse_dotenv_file(const std::string& path);
+std::string find_dotenv(const DotenvSearch& search);
 
 /**
  * @brief Search for .env file starting from current directory.
  *
- * Searches current directory and parent directories for a file named ".env".
- * Similar to python-dotenv's find_dotenv(usecwd=True).
+ * Same as find_dotenv(DotenvSearch{start_dir}): no boundary below the
+ * filesystem root.
  *
  * @param start_dir Starting directory (empty = current working directory)
  * @return Path to found .env file, or empty string if not found
  */
 std::string find_dotenv(const std::string& start_dir = "");
 
+/**
+ * @brief Forget every cached find_dotenv() result.
+ *
+ * Thread-safe.
+ */
+void clear_dotenv_cache();
+
 /**
  * @brief Load .env file into process environment.
  *
@@ -184,6 +248,15 @@ std::optional<std::string> get_env_var(const std::string& name);
  */
 bool has_env_var(const std::string& name);
 
+/**
+ * @brief Remove environment variable.
+ *
+ * Cross-platform wrapper; removing a variable that is not set is a no-op.
+ *
+ * @param name Variable name
+ */
+void unset_env_var(const std::string& name);
+
 } // namespace confy
 
 #endif // CONFY_LOADER_HPP
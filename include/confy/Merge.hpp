@@ -12,8 +12,13 @@
 
 #include "confy/Value.hpp"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace confy {
 
+class Provenance;
+
 /**
  * @brief Deep merge two JSON objects
  *
@@ -52,6 +57,23 @@ namespace confy {
  */
 Value deep_merge(const Value& base, const Value& override_val);
 
+/**
+ * @brief Deep merge, recording which leaves @p override_val supplied
+ *
+ * Produces the same result as deep_merge(base, override_val). Every leaf
+ * the result takes from @p override_val is assigned to @p layer in
+ * @p provenance, and the base leaves it replaces are erased, so merging
+ * the layers in order leaves each leaf attributed to the layer that won.
+ *
+ * @param base Base object (lower precedence)
+ * @param override_val Override object (higher precedence)
+ * @param provenance Leaf table to update
+ * @param layer Index of override_val's layer in provenance
+ * @return Merged result
+ */
+Value deep_merge(const Value& base, const Value& override_val,
+                 Provenance& provenance, uint8_t layer);
+
 /**
  * @brief Deep merge multiple configuration sources in order
  *
@@ -72,6 +94,46 @@ Value deep_merge(const Value& base, const Value& override_val);
  */
 Value deep_merge_all(const std::vector<Value>& sources);
 
+/**
+ * @brief Tuning for deep_merge_parallel()
+ */
+struct ParallelMergeOptions {
+    /// Worker threads, including the caller (0 = hardware concurrency)
+    size_t threads = 0;
+
+    /// Split a level when base.size() + override.size() reaches this;
+    /// smaller levels are merged key by key on the calling thread
+    size_t min_keys = 8192;
+};
+
+/**
+ * @brief Deep merge, splitting very wide objects across threads
+ *
+ * Produces exactly the same result as deep_merge(base, override_val),
+ * null-does-not-override included. Where base and override both hold an
+ * object at the same path, at the top level or below, and the two
+ * objects' key counts add up to at least options.min_keys, the keys are
+ * split into ranges and the ranges are merged on a pool of threads.
+ * Narrower levels are walked on the calling thread.
+ *
+ * Worth it only for objects with tens of thousands of keys, such as
+ * per-tenant maps; below that, thread start-up costs more than it saves.
+ *
+ * @param base Base object (lower precedence)
+ * @param override_val Override object (higher precedence)
+ * @param options Thread count and width threshold
+ * @return Merged result
+ *
+ * Example:
+ * ```cpp
+ * ParallelMergeOptions options;
+ * options.threads = 8;
+ * Value merged = deep_merge_parallel(tenants, tenant_overrides, options);
+ * ```
+ */
+Value deep_merge_parallel(const Value& base, const Value& override_val,
+                          const ParallelMergeOptions& options = {});
+
 } // namespace confy
 
 #endif // CONFY_MERGE_HPP
@@ -0,0 +1,108 @@
+/**
+ * @file PathIndex.hpp
+ * @brief Sorted dot-path index over a Config snapshot
+ *
+ * A PathIndex flattens a configuration once into its leaf dot-paths
+ * (objects are descended, arrays and scalars are leaves) and keeps them
+ * sorted. Key searches then narrow the candidates before any full
+ * pattern match:
+ * - A literal prefix ("db.*", "^db\\.") selects a sorted range
+ * - With trigrams enabled, every literal fragment of the pattern
+ *   ("*.port", "host") intersects the posting lists of its trigrams
+ *
+ * The index holds its own Config copy, which shares data with the
+ * original (copy-on-write), so entries stay valid however the original
+ * is modified afterwards. Build a new index to see later changes. Paths
+ * are packed into a KeyTable owned by the index (and shared by its
+ * copies), so they are freed with the index.
+ *
+ * @code
+ * confy::PathIndex index(cfg, true);
+ * for (const auto* e : index.find(confy::Pattern("database.*.port"))) {
+ *     std::cout << e->path << " = " << e->value->dump() << "\n";
+ * }
+ * @endcode
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_PATH_INDEX_HPP
+#define CONFY_PATH_INDEX_HPP
+
+#include "confy/Config.hpp"
+#include "confy/Intern.hpp"
+#include "confy/Pattern.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Immutable index of the leaf paths of a Config
+ *
+ * All query methods are const and safe to call from several threads.
+ */
+class PathIndex {
+public:
+    /// One leaf: its dot-path (valid while the index or a copy lives) and its value
+    struct Entry {
+        std::string_view path;
+        const Value* value;
+    };
+
+    /**
+     * @brief Index a configuration snapshot
+     *
+     * @param cfg Configuration to index (shared, not copied)
+     * @param trigrams Also build a trigram index for infix queries
+     */
+    explicit PathIndex(const Config& cfg, bool trigrams = false);
+
+    /// Number of leaf paths
+    size_t size() const { return entries_.size(); }
+
+    /// All entries, sorted by path
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    /// Whether the trigram index was built
+    bool has_trigrams() const { return trigrams_; }
+
+    /**
+     * @brief Entries whose path starts with @p prefix (a sorted range)
+     */
+    std::vector<const Entry*> with_prefix(std::string_view prefix) const;
+
+    /**
+     * @brief Positions in entries() that may match a key pattern
+     *
+     * A superset of the matches, ascending. Callers still test each
+     * candidate with Pattern::matches(); find() does this for them.
+     */
+    std::vector<size_t> candidates(const Pattern& pattern) const;
+
+    /**
+     * @brief Entries whose path matches @p pattern, sorted by path
+     */
+    std::vector<const Entry*> find(const Pattern& pattern) const;
+
+    /// Compile @p pattern and find() it
+    std::vector<const Entry*> find(std::string_view pattern, bool ignore_case = false) const {
+        return find(Pattern(pattern, ignore_case));
+    }
+
+private:
+    Config snapshot_;
+    std::shared_ptr<KeyTable> keys_;  ///< storage of every Entry::path
+    std::vector<Entry> entries_;
+    bool trigrams_ = false;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings_;  ///< trigram -> entry positions
+};
+
+} // namespace confy
+
+#endif // CONFY_PATH_INDEX_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file Pattern.hpp
+ * @brief Pre-compiled key/value patterns for search
+ *
+ * A Pattern is compiled once and then tested against many strings
+ * without allocating. The pattern kind is detected from its text:
+ * - Contains `*`, `?` or `[`       -> glob, matched against the whole text
+ * - Contains `^`, `$`, `|`, `(`, `+` -> ECMAScript regex, searched
+ * - Otherwise                       -> plain substring search
+ *
+ * Globs support `*` (any run), `?` (any character) and `[...]` classes
+ * with ranges, negated by a leading `!` or `^`; every other character is
+ * literal. Invalid globs and
+ * regexes fall back to a substring search for the pattern text.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_PATTERN_HPP
+#define CONFY_PATTERN_HPP
+
+#include <array>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Glob, regex or substring pattern compiled for repeated matching
+ *
+ * matches() is const and safe to call from several threads at once.
+ */
+class Pattern {
+public:
+    enum class Kind {
+        Substring,
+        Glob,
+        Regex
+    };
+
+    /**
+     * @brief Compile a pattern
+     *
+     * @param pattern Pattern text (kind detected as described above)
+     * @param ignore_case ASCII case-insensitive matching
+     */
+    explicit Pattern(std::string_view pattern, bool ignore_case = false);
+
+    /**
+     * @brief Test a string against the pattern
+     */
+    bool matches(std::string_view text) const;
+
+    /// Detected kind (Substring after a fallback)
+    Kind kind() const { return kind_; }
+
+    /**
+     * @brief Text every match starts with
+     *
+     * Used by PathIndex to narrow a sorted key range. Empty when there
+     * is no such prefix or matching ignores case.
+     */
+    std::string literal_prefix() const;
+
+    /**
+     * @brief Fragments every match contains (case-folded with ignore_case)
+     *
+     * Used by PathIndex for trigram pruning. May be empty.
+     */
+    std::vector<std::string> required_literals() const;
+
+private:
+    struct Atom {
+        enum Type { Char, AnyChar, Class, AnyRun } type;
+        char ch;        ///< Char: expected (case-folded) character
+        size_t index;   ///< Class: position in classes_
+    };
+
+    bool compile_glob(std::string_view pattern);
+    bool match_glob(std::string_view text) const;
+    bool match_substring(std::string_view text) const;
+
+    Kind kind_ = Kind::Substring;
+    bool ignore_case_ = false;
+    std::string text_;                                  ///< Substring (case-folded)
+    std::vector<Atom> atoms_;                           ///< Compiled glob
+    std::vector<std::array<bool, 256>> classes_;        ///< Glob [...] sets
+    std::optional<std::regex> regex_;
+    std::string regex_prefix_;                          ///< Literal after a leading '^'
+};
+
+} // namespace confy
+
+#endif // CONFY_PATTERN_HPP
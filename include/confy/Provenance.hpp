@@ -0,0 +1,147 @@
+/**
+ * @file Provenance.hpp
+ * @brief Which source set each key of a loaded configuration
+ *
+ * With LoadOptions::track_origins enabled, Config::load() records for
+ * every leaf of the merged tree the layer it came from: defaults, the
+ * config file, .env, an environment variable or an override. The record
+ * is a flat table from leaf dot-path to a one-byte layer index, filled in
+ * by deep_merge() as layers replace each other. What the loaders know
+ * about a layer (the file path and text, the variable behind each env
+ * key, the override key) is kept once per layer and only combined with
+ * the table when Config::origin() is asked.
+ *
+ * Leaf paths are interned in a KeyTable owned by the record, so each path
+ * is stored once in arena blocks and lookups hash a pointer. The table is
+ * released with the last snapshot holding the record; nothing accumulates
+ * across reloads.
+ *
+ * @code
+ * opts.track_origins = true;
+ * Config cfg = Config::load(opts);
+ * if (auto origin = cfg.origin("database.host")) {
+ *     std::cout << origin->to_string() << "\n";   // env MYAPP_DATABASE_HOST
+ * }
+ * @endcode
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_PROVENANCE_HPP
+#define CONFY_PROVENANCE_HPP
+
+#include "confy/Intern.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Kind of source a value was loaded from, lowest precedence first
+ */
+enum class Source : uint8_t {
+    Defaults,   ///< LoadOptions::defaults (and schema defaults)
+    File,       ///< Config file
+    Dotenv,     ///< Variable set from the .env file
+    Env,        ///< Environment variable
+    Override    ///< LoadOptions::overrides
+};
+
+/**
+ * @brief Lower-case name of a source kind ("defaults", "file", ".env", ...)
+ */
+const char* source_name(Source source);
+
+/**
+ * @brief Where one value of a loaded configuration came from
+ */
+struct Origin {
+    Source source = Source::Defaults;
+
+    /// Environment variable or override key; empty for defaults and file
+    std::string name;
+
+    /// Config file or .env file; empty for other sources
+    std::string file;
+
+    /// 1-based line of the value in file, 0 if unknown
+    size_t line = 0;
+
+    /**
+     * @brief One-line description, e.g. "file config.toml:12",
+     *        "env MYAPP_DB_HOST" or ".env MYAPP_DB_HOST (/srv/app/.env)"
+     */
+    std::string to_string() const;
+};
+
+/**
+ * @brief Per-leaf record of the layer each value of a merge came from
+ *
+ * Query methods are const and safe to call from several threads.
+ */
+class Provenance {
+public:
+    /// Layer indices are one byte
+    static constexpr size_t MAX_LAYERS = 255;
+
+    /**
+     * @brief Register a source layer, in merge order
+     *
+     * @param source Kind of the layer
+     * @param file Config or .env file the layer was read from, if any
+     * @param text Content of a config file, used to find value lines
+     * @return Index to pass to deep_merge()
+     * @throws ConfigError after MAX_LAYERS layers
+     */
+    uint8_t add_layer(Source source, std::string file = "", std::string text = "");
+
+    /**
+     * @brief Give @p path of @p layer, and everything below it without a
+     *        deeper entry, its own origin
+     *
+     * Used for the variable behind each env key and for override keys.
+     */
+    void set_origin(uint8_t layer, std::string path, Origin origin);
+
+    /// Record that @p layer set the leaf at @p path
+    void assign(std::string_view path, uint8_t layer);
+
+    /// Forget the leaf at @p path (its value was replaced)
+    void erase(std::string_view path);
+
+    /**
+     * @brief Origin of the value at @p path
+     *
+     * Paths inside an array resolve to the array. Sections (objects)
+     * have no single origin.
+     *
+     * @return Origin, or nullopt if @p path is not a recorded leaf
+     */
+    std::optional<Origin> origin(std::string_view path) const;
+
+    /// Number of recorded leaves
+    size_t size() const { return leaves_.size(); }
+
+private:
+    struct Layer {
+        Source source;
+        std::string file;
+        std::string text;
+        std::unordered_map<std::string, Origin> origins;
+    };
+
+    std::vector<Layer> layers_;
+    std::shared_ptr<KeyTable> keys_ = std::make_shared<KeyTable>();  ///< shared by copies
+    std::unordered_map<InternedKey, uint8_t, InternedKeyHash> leaves_;
+};
+
+} // namespace confy
+
+#endif // CONFY_PROVENANCE_HPP
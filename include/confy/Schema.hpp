@@ -0,0 +1,229 @@
+/**
+ * @file Schema.hpp
+ * @brief Compiled configuration schema with one-pass validation
+ *
+ * A Schema describes the expected shape of a configuration: required
+ * paths, value types, enum/range/regex constraints and default values.
+ * Rules are compiled once (regexes included) into a trie keyed by path
+ * segment, and validate() checks a whole tree in a single traversal,
+ * collecting every violation without using exceptions for control flow.
+ *
+ * Missing semantics follow the mandatory-key rules:
+ * - RULE M1-M2: All violations are reported, not just the first
+ * - RULE M3: A path into a non-container counts as missing
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_SCHEMA_HPP
+#define CONFY_SCHEMA_HPP
+
+#include "confy/Value.hpp"
+#include "confy/Errors.hpp"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Value types a schema rule can require
+ */
+enum class SchemaType {
+    Any,        ///< No type constraint
+    String,
+    Integer,    ///< Signed or unsigned JSON integer
+    Number,     ///< Integer or floating point
+    Boolean,
+    Object,
+    Array,
+    Null
+};
+
+/**
+ * @brief One problem found by Schema::validate()
+ */
+struct SchemaViolation {
+    enum class Kind {
+        Missing,            ///< Required path not present (RULE M3 included)
+        WrongType,          ///< Value has the wrong SchemaType
+        OutOfRange,         ///< Number outside [min, max]
+        NotInEnum,          ///< Value not among the allowed values
+        PatternMismatch     ///< String does not match the pattern
+    };
+
+    Kind kind;
+    std::string path;
+    std::string message;
+};
+
+/**
+ * @brief Constraints attached to one dot-path
+ *
+ * Returned by Schema::field() for builder-style configuration. All
+ * setters return *this so calls can be chained.
+ */
+class FieldRule {
+public:
+    /// Mark the path as required (or not)
+    FieldRule& required(bool value = true);
+
+    /// Require a value type
+    FieldRule& type(SchemaType value);
+
+    /// Lowest allowed number (inclusive)
+    FieldRule& min(double value);
+
+    /// Highest allowed number (inclusive)
+    FieldRule& max(double value);
+
+    /// Restrict the value to a fixed set
+    FieldRule& one_of(std::vector<Value> values);
+
+    /**
+     * @brief Require strings to match a regular expression (ECMAScript)
+     *
+     * The pattern is searched for anywhere in the string; anchor it with
+     * ^ and $ to match the whole value.
+     *
+     * @throws ConfigError if the pattern is not a valid regex
+     */
+    FieldRule& pattern(const std::string& regex);
+
+    /// Value to use when no source provides the path
+    FieldRule& default_value(Value value);
+
+    /// Dot-path this rule applies to
+    const std::string& path() const { return path_; }
+
+    /// Whether the path is required
+    bool is_required() const { return required_; }
+
+private:
+    friend class Schema;
+
+    explicit FieldRule(std::string path) : path_(std::move(path)) {}
+
+    std::string path_;
+    bool required_ = false;
+    SchemaType type_ = SchemaType::Any;
+    std::optional<double> min_;
+    std::optional<double> max_;
+    std::vector<Value> enum_;
+    std::optional<std::regex> regex_;
+    std::string pattern_;
+    std::optional<Value> default_;
+};
+
+/**
+ * @brief Set of path rules compiled into a trie
+ *
+ * Example:
+ * @code
+ * auto schema = std::make_shared<Schema>();
+ * schema->field("database.host").required().type(SchemaType::String);
+ * schema->field("database.port").type(SchemaType::Integer)
+ *       .min(1).max(65535).default_value(5432);
+ * schema->field("log.level").one_of({"debug", "info", "warn", "error"});
+ *
+ * LoadOptions opts;
+ * opts.schema = schema;        // checked by Config::load()
+ * @endcode
+ */
+class Schema {
+public:
+    Schema();
+    ~Schema();
+    Schema(Schema&&) noexcept;
+    Schema& operator=(Schema&&) noexcept;
+    Schema(const Schema&) = delete;
+    Schema& operator=(const Schema&) = delete;
+
+    /**
+     * @brief Build a schema from a JSON description
+     *
+     * The description maps dot-paths to rule objects:
+     * @code
+     * {
+     *   "database.host": {"type": "string", "required": true},
+     *   "database.port": {"type": "integer", "min": 1, "max": 65535, "default": 5432},
+     *   "log.level":     {"enum": ["debug", "info", "warn", "error"]},
+     *   "service.name":  {"pattern": "^[a-z][a-z0-9-]*$"}
+     * }
+     * @endcode
+     *
+     * @param spec Schema description (must be an object)
+     * @return Compiled schema
+     * @throws ConfigError if the description is malformed
+     */
+    static Schema from_json(const Value& spec);
+
+    /**
+     * @brief Get (creating if needed) the rule for a dot-path
+     *
+     * @param path Dot-separated path
+     * @return Rule for chaining constraints; stays valid for the
+     *         lifetime of the schema
+     */
+    FieldRule& field(const std::string& path);
+
+    /**
+     * @brief Number of rules
+     */
+    size_t size() const { return rules_.size(); }
+
+    /**
+     * @brief Tree of all default values declared in the schema
+     *
+     * Config::load() and LayeredConfig::load() place it beneath the
+     * LoadOptions defaults, so it has the lowest precedence.
+     */
+    Value defaults() const;
+
+    /**
+     * @brief Check a tree against every rule in one traversal
+     *
+     * @param root Configuration tree
+     * @return All violations, ordered by rule declaration (empty if valid)
+     */
+    std::vector<SchemaViolation> validate(const Value& root) const;
+
+    /**
+     * @brief Validate and throw if anything is wrong
+     *
+     * @param root Configuration tree
+     * @throws SchemaValidationError listing every violation
+     */
+    void check(const Value& root) const;
+
+private:
+    struct Node {
+        std::map<std::string, std::unique_ptr<Node>> children;
+        const FieldRule* rule = nullptr;
+        size_t rule_index = 0;
+    };
+
+    struct Found {
+        size_t rule_index;
+        SchemaViolation violation;
+    };
+
+    /// Rules in declaration order (deque keeps references stable)
+    std::deque<FieldRule> rules_;
+
+    /// Root of the path trie
+    std::unique_ptr<Node> root_;
+
+    void visit(const Node& node, const Value* value, std::vector<Found>& out) const;
+    static void check_rule(const FieldRule& rule, size_t index, const Value& value,
+                           std::vector<Found>& out);
+};
+
+} // namespace confy
+
+#endif // CONFY_SCHEMA_HPP
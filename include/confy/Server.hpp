@@ -0,0 +1,159 @@
+/**
+ * @file Server.hpp
+ * @brief Local configuration server and client over a Unix domain socket
+ *
+ * The protocol is line-oriented and shared with `confy-cpp batch`:
+ * a request is one command line (words split by split_command_line()),
+ * a response is one line of compact JSON. Requests may be pipelined on
+ * a connection; responses come back in order.
+ *
+ * @code
+ * // Server (see `confy-cpp serve`)
+ * confy::ConfigServer server("/run/app/confy.sock", [&](std::string_view line) {
+ *     return handle(line);            // one JSON line per request
+ * });
+ * server.run();                       // until server.stop()
+ *
+ * // Client
+ * confy::ConfigClient client("/run/app/confy.sock");
+ * confy::Value r = client.request({"get", "database.host"});
+ * // {"ok": true, "value": "db.local"}
+ * @endcode
+ *
+ * Available on POSIX systems only. The server uses epoll on Linux and
+ * poll() elsewhere. On Windows the constructors throw ConfigError.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_SERVER_HPP
+#define CONFY_SERVER_HPP
+
+#include "confy/Value.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace confy {
+
+/**
+ * @brief Split a command line into words
+ *
+ * Words are separated by blanks. Single quotes keep their content
+ * verbatim and inside double quotes a backslash escapes the next
+ * character, so values such as '{"a": [1, 2]}' can be passed.
+ *
+ * @throws ConfigError on an unterminated quote
+ */
+std::vector<std::string> split_command_line(std::string_view line);
+
+/**
+ * @brief Join words into a line that split_command_line() splits back
+ */
+std::string join_command_line(const std::vector<std::string>& words);
+
+/**
+ * @brief Event-loop server answering one line per request
+ *
+ * Single-threaded: the handler and the tick callback run on the thread
+ * calling run(), so they can share state without locking.
+ */
+class ConfigServer {
+public:
+    /// Turns one request line (without newline) into one response line
+    using Handler = std::function<std::string(std::string_view request)>;
+
+    /// Longest accepted request line; longer requests close the connection
+    static constexpr size_t MAX_REQUEST_SIZE = 64 * 1024;
+
+    /// Unsent response bytes above which a connection is not read from
+    static constexpr size_t MAX_PENDING_OUTPUT = 1024 * 1024;
+
+    /**
+     * @brief Bind and listen on a socket path
+     *
+     * A stale socket file left by a dead server is replaced. The socket
+     * is created with mode 0600, so only the owning user can connect.
+     *
+     * @throws ConfigError if the path is too long, is served by a live
+     *         server, or cannot be bound
+     */
+    ConfigServer(std::string socket_path, Handler handler);
+
+    /// Closes all connections and removes the socket file
+    ~ConfigServer();
+
+    ConfigServer(const ConfigServer&) = delete;
+    ConfigServer& operator=(const ConfigServer&) = delete;
+
+    /**
+     * @brief Call @p on_tick about every @p interval while running
+     *
+     * Used by `confy-cpp serve` to watch the config file for changes.
+     */
+    void set_tick(std::chrono::milliseconds interval, std::function<void()> on_tick);
+
+    /**
+     * @brief Serve requests until stop() is called
+     */
+    void run();
+
+    /**
+     * @brief Make run() return
+     *
+     * Safe to call from another thread or a signal handler.
+     */
+    void stop() noexcept;
+
+    /// Path the server listens on
+    const std::string& socket_path() const { return socket_path_; }
+
+private:
+    struct Impl;
+    std::string socket_path_;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Blocking client for ConfigServer
+ */
+class ConfigClient {
+public:
+    /**
+     * @brief Connect to a server
+     * @throws ConfigError if the socket cannot be reached
+     */
+    explicit ConfigClient(const std::string& socket_path);
+
+    ~ConfigClient();
+
+    ConfigClient(const ConfigClient&) = delete;
+    ConfigClient& operator=(const ConfigClient&) = delete;
+
+    /**
+     * @brief Send one raw request line and return the response line
+     * @throws ConfigError on I/O failure or if the server disconnects
+     */
+    std::string request_line(std::string_view line);
+
+    /**
+     * @brief Send a command and parse the JSON response
+     *
+     * @param words Command and arguments, e.g. {"get", "database.host"}
+     * @return Response object ({"ok": ..., "value"/"error": ...})
+     * @throws ConfigError on I/O failure or a malformed response
+     */
+    Value request(const std::vector<std::string>& words);
+
+private:
+    int fd_ = -1;
+    std::string buffer_;
+};
+
+} // namespace confy
+
+#endif // CONFY_SERVER_HPP
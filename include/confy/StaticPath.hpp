@@ -0,0 +1,179 @@
+/**
+ * @file StaticPath.hpp
+ * @brief Compile-time dot-path tokenization
+ *
+ * StaticPath splits a constant dot-path at compile time into a fixed
+ * array of segments, with array indices pre-validated and pre-parsed
+ * using the same rules as is_array_index(). Lookups through the
+ * get_by_dot() overloads taking a StaticPath skip runtime path parsing.
+ *
+ * @code
+ * using namespace confy::literals;
+ *
+ * constexpr auto host = "database.host"_cpath;
+ * static_assert(host.size() == 2);
+ *
+ * const Value* v = get_by_dot(cfg, host);
+ * int first = cfg.get<int>("ports.0"_cpath, 0);
+ * @endcode
+ *
+ * With C++20 class-type template parameters, confy::path<"a.b.c"> is
+ * also available and is guaranteed to be tokenized at compile time.
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#ifndef CONFY_STATICPATH_HPP
+#define CONFY_STATICPATH_HPP
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace confy {
+
+namespace detail {
+
+/**
+ * @brief constexpr form of is_array_index()
+ *
+ * Non-empty run of ASCII digits without leading zeros ("0" allowed).
+ */
+constexpr bool is_array_index_sv(std::string_view segment) {
+    if (segment.empty()) return false;
+    if (segment[0] == '0' && segment.size() > 1) return false;
+    for (char c : segment) {
+        if (c < '0' || c > '9') return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Dot-path tokenized at compile time
+ *
+ * Splitting matches split_dot_path(): empty segments (leading, trailing
+ * or doubled dots) are dropped. The source string must outlive the
+ * StaticPath, which string literals always do.
+ */
+class StaticPath {
+public:
+    /// Maximum number of segments in a static path
+    static constexpr size_t MAX_SEGMENTS = 16;
+
+    /// Marker for segments that are not array indices
+    static constexpr size_t NOT_AN_INDEX = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Tokenize a dot-path
+     *
+     * @param path Dot-separated path
+     * @throws std::length_error if the path has more than MAX_SEGMENTS
+     *         segments (a compile error in constant evaluation)
+     */
+    constexpr explicit StaticPath(std::string_view path)
+        : path_(path)
+    {
+        size_t start = 0;
+        for (size_t i = 0; i <= path.size(); ++i) {
+            if (i < path.size() && path[i] != '.') {
+                continue;
+            }
+            if (i > start) {
+                if (count_ == MAX_SEGMENTS) {
+                    throw std::length_error("confy::StaticPath: too many segments");
+                }
+                std::string_view seg = path.substr(start, i - start);
+                segments_[count_] = seg;
+                indices_[count_] = parse_index(seg);
+                ++count_;
+            }
+            start = i + 1;
+        }
+    }
+
+    /// Original path text
+    constexpr std::string_view str() const { return path_; }
+
+    /// Number of segments
+    constexpr size_t size() const { return count_; }
+
+    /// True for the empty path (refers to the root)
+    constexpr bool empty() const { return count_ == 0; }
+
+    /// Segment text
+    constexpr std::string_view operator[](size_t i) const { return segments_[i]; }
+
+    /// Whether a segment can index into an array
+    constexpr bool is_index(size_t i) const { return indices_[i] != NOT_AN_INDEX; }
+
+    /// Pre-parsed array index of a segment (NOT_AN_INDEX if not an index)
+    constexpr size_t index(size_t i) const { return indices_[i]; }
+
+private:
+    std::string_view path_;
+    std::array<std::string_view, MAX_SEGMENTS> segments_{};
+    std::array<size_t, MAX_SEGMENTS> indices_{};
+    size_t count_ = 0;
+
+    static constexpr size_t parse_index(std::string_view seg) {
+        if (!detail::is_array_index_sv(seg)) {
+            return NOT_AN_INDEX;
+        }
+        size_t value = 0;
+        for (char c : seg) {
+            // Indices too large to represent cannot be in range anyway
+            if (value > (NOT_AN_INDEX - 1 - static_cast<size_t>(c - '0')) / 10) {
+                return NOT_AN_INDEX - 1;
+            }
+            value = value * 10 + static_cast<size_t>(c - '0');
+        }
+        return value;
+    }
+};
+
+namespace literals {
+
+/**
+ * @brief Tokenize a constant dot-path: "database.host"_cpath
+ */
+constexpr StaticPath operator""_cpath(const char* str, size_t len) {
+    return StaticPath(std::string_view(str, len));
+}
+
+} // namespace literals
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+
+namespace detail {
+
+/**
+ * @brief String literal usable as a template argument (C++20)
+ */
+template<size_t N>
+struct FixedString {
+    char data[N] = {};
+
+    constexpr FixedString(const char (&str)[N]) {
+        for (size_t i = 0; i < N; ++i) data[i] = str[i];
+    }
+
+    constexpr std::string_view view() const { return std::string_view(data, N - 1); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Path tokenized at compile time: confy::path<"database.host">
+ */
+template<detail::FixedString S>
+inline constexpr StaticPath path = StaticPath(S.view());
+
+#endif
+
+} // namespace confy
+
+#endif // CONFY_STATICPATH_HPP
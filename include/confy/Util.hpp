@@ -9,16 +9,96 @@
 #define CONFY_UTIL_HPP
 
 #include "confy/Value.hpp"
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace confy {
 
+/**
+ * @brief One leaf visited by leaves(): its dot-path and value
+ *
+ * Both refer into the iteration: the path view is valid until the
+ * iterator advances, the value as long as the traversed Value.
+ */
+struct Leaf {
+    std::string_view path;
+    const Value& value;
+};
+
+/**
+ * @brief Lazy depth-first range over the leaves of a Value
+ *
+ * Objects are descended; every non-object value (scalars, arrays) is a
+ * leaf. Empty objects yield nothing and neither does a non-object root.
+ * Nothing is copied: paths are built in one buffer reused by the
+ * iterator, so flattening is linear in the size of the tree.
+ *
+ * @code
+ * for (const auto& [path, value] : confy::leaves(cfg.data())) {
+ *     std::cout << path << " = " << value.dump() << "\n";
+ * }
+ * @endcode
+ */
+class LeafRange {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Leaf;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Leaf;
+
+        /// End iterator
+        iterator() = default;
+
+        Leaf operator*() const { return {path_, *frames_.back().it}; }
+        iterator& operator++();
+
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class LeafRange;
+
+        struct Frame {
+            Value::const_iterator it;
+            Value::const_iterator end;
+            size_t mark;    ///< Path length before this level's key
+        };
+
+        explicit iterator(const Value& root);
+        void settle();
+
+        std::vector<Frame> frames_;
+        std::string path_;
+    };
+
+    explicit LeafRange(const Value& root) : root_(&root) {}
+
+    iterator begin() const { return iterator(*root_); }
+    iterator end() const { return iterator(); }
+
+private:
+    const Value* root_;
+};
+
+/**
+ * @brief Iterate the leaves of @p data (see LeafRange)
+ */
+inline LeafRange leaves(const Value& data) {
+    return LeafRange(data);
+}
+
 /**
  * @brief Flatten a nested Value object into dot-path keys
  *
  * Converts {"a": {"b": 1}} into {"a.b": 1}
- * Useful for debugging and comparison.
+ * Useful for debugging and comparison. Copies every leaf; use leaves()
+ * to visit them in place.
  *
  * @param data Nested Value object
  * @param prefix Current path prefix (for recursion)
@@ -30,7 +110,9 @@ flatten_to_dotpaths(const Value& data, const std::string& prefix = "");
 /**
  * @brief Convert overrides dictionary to nested Value object
  *
- * Converts {"a.b": 1, "c.d": 2} into {"a": {"b": 1}, "c": {"d": 2}}
+ * Converts {"a.b": 1, "c.d": 2} into {"a": {"b": 1}, "c": {"d": 2}}.
+ * Overlapping paths resolve as in TreeBuilder: {"a": 1, "a.b": 2}
+ * gives {"a": 1} whatever the map's iteration order.
  *
  * @param overrides Map of dot-path to value
  * @return Nested Value object
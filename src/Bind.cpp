@@ -0,0 +1,90 @@
+/**
+ * @file Bind.cpp
+ * @brief Struct binding traversal plan implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/Bind.hpp"
+#include "confy/DotPath.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace confy {
+
+BindPlan::BindPlan(std::vector<std::string> paths)
+    : paths_(std::move(paths))
+{
+    segments_.reserve(paths_.size());
+    for (const auto& path : paths_) {
+        segments_.push_back(split_dot_path(path));
+    }
+
+    // Sort by segments so paths with a common prefix are adjacent
+    order_.resize(paths_.size());
+    std::iota(order_.begin(), order_.end(), size_t{0});
+    std::stable_sort(order_.begin(), order_.end(), [this](size_t a, size_t b) {
+        return segments_[a] < segments_[b];
+    });
+
+    shared_.assign(order_.size(), 0);
+    for (size_t n = 1; n < order_.size(); ++n) {
+        const auto& prev = segments_[order_[n - 1]];
+        const auto& cur = segments_[order_[n]];
+        size_t common = 0;
+        while (common < prev.size() && common < cur.size() &&
+               prev[common] == cur[common]) {
+            ++common;
+        }
+        shared_[n] = common;
+    }
+}
+
+void BindPlan::resolve(const Value& root, std::vector<Slot>& out) const {
+    out.assign(paths_.size(), Slot{});
+
+    // nodes[k] is the node reached after k segments of the current path
+    std::vector<const Value*> nodes{&root};
+
+    for (size_t n = 0; n < order_.size(); ++n) {
+        const size_t field = order_[n];
+        const auto& segs = segments_[field];
+
+        // Reuse the prefix walked for the previous path
+        nodes.resize(std::min(shared_[n] + 1, nodes.size()));
+
+        bool blocked = false;
+        while (nodes.size() <= segs.size()) {
+            const Value* current = nodes.back();
+            const auto& seg = segs[nodes.size() - 1];
+
+            if (current->is_object()) {
+                auto it = current->find(seg);
+                if (it == current->end()) {
+                    break;
+                }
+                nodes.push_back(&*it);
+            } else if (current->is_array()) {
+                if (!is_array_index(seg)) {
+                    break;
+                }
+                size_t idx = parse_array_index(seg);
+                if (idx >= current->size()) {
+                    break;
+                }
+                nodes.push_back(&(*current)[idx]);
+            } else {
+                out[field].blocked_by = current;
+                blocked = true;
+                break;
+            }
+        }
+
+        if (!blocked && nodes.size() == segs.size() + 1) {
+            out[field].value = nodes.back();
+        }
+    }
+}
+
+} // namespace confy
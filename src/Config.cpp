@@ -17,16 +17,19 @@
  */
 
 #include "confy/Config.hpp"
+#include "confy/LayeredConfig.hpp"
+#include "confy/Bind.hpp"
+#include "confy/Schema.hpp"
 #include "confy/DotPath.hpp"
 #include "confy/Merge.hpp"
-#include "confy/Loader.hpp"
-#include "confy/EnvMapper.hpp"
 #include "confy/Parse.hpp"
 
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
 #include <sstream>
-
-// For TOML serialization
-#include <toml++/toml.hpp>
+#include <utility>
 
 namespace confy {
 
@@ -34,10 +37,70 @@ namespace confy {
 // Construction
 // =============================================================================
 
-Config::Config(const Value& data) : data_(data) {
-    if (!data_.is_object()) {
-        throw TypeError("", "object", type_name(data_));
+namespace {
+
+/**
+ * @brief Shared empty tree used by default-constructed and moved-from configs
+ */
+const std::shared_ptr<Value>& empty_tree() {
+    static const std::shared_ptr<Value> empty = std::make_shared<Value>(Value::object());
+    return empty;
+}
+
+} // anonymous namespace
+
+Config::Config() : data_(empty_tree()) {}
+
+Config::Config(const Value& data) : Config(Value(data)) {}
+
+Config::Config(Value&& data) {
+    if (!data.is_object()) {
+        throw TypeError("", "object", type_name(data));
+    }
+    data_ = std::make_shared<Value>(std::move(data));
+}
+
+Config::Config(const Config& other)
+    : data_(other.unsharable_ ? std::make_shared<Value>(*other.data_) : other.data_),
+      provenance_(other.provenance_) {}
+
+Config::Config(Config&& other) noexcept
+    : data_(std::exchange(other.data_, empty_tree())),
+      provenance_(std::move(other.provenance_)),
+      unsharable_(std::exchange(other.unsharable_, false)) {}
+
+Config& Config::operator=(const Config& other) {
+    if (this != &other) {
+        data_ = other.unsharable_ ? std::make_shared<Value>(*other.data_) : other.data_;
+        provenance_ = other.provenance_;
+        unsharable_ = false;
     }
+    return *this;
+}
+
+Config& Config::operator=(Config&& other) noexcept {
+    if (this != &other) {
+        data_ = std::exchange(other.data_, empty_tree());
+        provenance_ = std::move(other.provenance_);
+        unsharable_ = std::exchange(other.unsharable_, false);
+    }
+    return *this;
+}
+
+Value& Config::writable_tree() {
+    // Copy-on-write: detach before the first modification of a shared tree
+    if (data_.use_count() > 1) {
+        data_ = std::make_shared<Value>(*data_);
+    }
+    // The caller may change anything, so origins can no longer be trusted
+    provenance_.reset();
+    return *data_;
+}
+
+Value& Config::mutable_data() {
+    // The reference outlives this call, so stop sharing the tree with copies
+    unsharable_ = true;
+    return writable_tree();
 }
 
 // =============================================================================
@@ -45,78 +108,23 @@ Config::Config(const Value& data) : data_(data) {
 // =============================================================================
 
 Config Config::load(const LoadOptions& opts) {
+    // Steps 1-5: Read every source into its own layer (precedence order
+    // defaults → file → .env/env → overrides), then merge them eagerly
     Config cfg;
+    if (opts.track_origins) {
+        auto provenance = std::make_shared<Provenance>();
+        LayeredConfig layers = LayeredConfig::from_sources(opts, provenance.get());
+        cfg.data_ = std::make_shared<Value>(layers.materialize(*provenance));
+        cfg.provenance_ = std::move(provenance);
+    } else {
+        cfg.data_ = std::make_shared<Value>(LayeredConfig::from_sources(opts).materialize());
+    }
 
-    // -------------------------------------------------------------------------
-    // Step 1: Start with defaults (lowest precedence)
-    // -------------------------------------------------------------------------
-    Value merged = opts.defaults;
-    if (!merged.is_object()) {
-        merged = Value::object();
-    }
-
-    // -------------------------------------------------------------------------
-    // Step 2: Load and merge config file
-    // -------------------------------------------------------------------------
-    Value file_data = Value::object();
-    if (!opts.file_path.empty()) {
-        // load_config_file handles RULE F6-F8:
-        // - Empty path returns empty object
-        // - Missing file throws FileNotFoundError
-        // - Auto-detects JSON/TOML by extension
-        // - TOML key promotion based on defaults
-        file_data = load_config_file(opts.file_path, merged);
-        merged = deep_merge(merged, file_data);
-    }
-
-    // -------------------------------------------------------------------------
-    // Step 3: Load .env file (populates environment, does NOT override existing)
-    // -------------------------------------------------------------------------
-    if (opts.load_dotenv_file) {
-        // RULE P4: .env does not override existing environment variables
-        std::string env_path = opts.dotenv_path;
-        if (env_path.empty()) {
-            // Search for .env in current directory
-            env_path = ".env";
-        }
-        // load_dotenv_file handles the "don't override" semantics
-        load_dotenv_file(env_path, false /* override_existing */);
-    }
-
-    // -------------------------------------------------------------------------
-    // Step 4: Load and merge environment variables
-    // -------------------------------------------------------------------------
-    if (opts.prefix.has_value()) {
-        // load_env_vars implements RULE E1-E7:
-        // - Prefix filtering (E1-E3)
-        // - Underscore transformation (E4)
-        // - Remapping against base structure (E5-E7)
-        // - Value parsing
-        //
-        // The base structure for remapping includes both defaults and file_data
-        Value env_data = load_env_vars(
-            opts.prefix.value(),    // Prefix for filtering
-            merged,                  // Base structure for remapping
-            merged,                  // Defaults (for key lookup)
-            file_data,               // File data (for key lookup)
-            false                    // Not from dotenv (conservative mode)
-        );
-        merged = deep_merge(merged, env_data);
-    }
-
-    // -------------------------------------------------------------------------
-    // Step 5: Apply overrides (highest precedence)
-    // -------------------------------------------------------------------------
-    if (!opts.overrides.empty()) {
-        Value overrides_obj = overrides_to_value(opts.overrides);
-        merged = deep_merge(merged, overrides_obj);
-    }
-
-    // -------------------------------------------------------------------------
-    // Step 6: Validate mandatory keys
-    // -------------------------------------------------------------------------
-    cfg.data_ = merged;
+    // Step 6: Validate mandatory keys, then the schema (if any)
     cfg.validate_mandatory(opts.mandatory);
+    if (opts.schema) {
+        opts.schema->check(*cfg.data_);
+    }
 
     return cfg;
 }
@@ -127,7 +135,7 @@ Config Config::load(const LoadOptions& opts) {
 
 Value Config::get(const std::string& path) const {
     // RULE D1: Strict get throws KeyError if not found
-    const Value* result = get_by_dot(data_, path);
+    const Value* result = get_by_dot(*data_, path);
     if (result == nullptr) {
         throw KeyError(path, "Key not found in configuration");
     }
@@ -135,30 +143,70 @@ Value Config::get(const std::string& path) const {
 }
 
 std::optional<Value> Config::get_optional(const std::string& path) const {
-    // Non-throwing version for optional access
-    try {
-        const Value* result = get_by_dot(data_, path);
-        if (result == nullptr) {
-            return std::nullopt;
-        }
-        return *result;
-    } catch (const TypeError&) {
+    // Non-throwing lookup; only type mismatches surface as exceptions
+    LookupResult result = try_get_by_dot(*data_, path);
+    if (result.status == LookupStatus::TypeMismatch) {
+        // RULE D2: TypeError still propagates for traversal into non-object
+        result.throw_if_error(path);
+    }
+    if (!result.found()) {
+        return std::nullopt;
+    }
+    return *result.value;
+}
+
+Value Config::get(const StaticPath& path) const {
+    // RULE D1: Strict get throws KeyError if not found
+    return *get_by_dot(*data_, path);
+}
+
+std::optional<Value> Config::get_optional(const StaticPath& path) const {
+    LookupResult result = try_get_by_dot(*data_, path);
+    if (result.status == LookupStatus::TypeMismatch) {
         // RULE D2: TypeError still propagates for traversal into non-object
-        throw;
-    } catch (...) {
+        result.throw_if_error(std::string(path.str()));
+    }
+    if (!result.found()) {
         return std::nullopt;
     }
+    return *result.value;
+}
+
+std::vector<Config::KeyResult> Config::get_many(
+    const std::vector<std::string>& paths) const {
+    // Shared-prefix traversal, same plan as struct binding
+    BindPlan plan(paths);
+    std::vector<BindPlan::Slot> slots;
+    plan.resolve(*data_, slots);
+
+    std::vector<KeyResult> results(paths.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i].value != nullptr) {
+            results[i].status = LookupStatus::Found;
+            results[i].value = *slots[i].value;
+        } else if (slots[i].blocked_by != nullptr) {
+            results[i].status = LookupStatus::TypeMismatch;
+        }
+    }
+    return results;
 }
 
 void Config::set(const std::string& path, const Value& value,
                  bool create_missing) {
     // RULE D3-D4: set semantics with create_missing option
-    set_by_dot(data_, path, value, create_missing);
+    set_by_dot(writable_tree(), path, value, create_missing);
 }
 
 bool Config::contains(const std::string& path) const {
     // RULE D5-D6: contains semantics
-    return contains_dot(data_, path);
+    return contains_dot(*data_, path);
+}
+
+std::optional<Origin> Config::origin(const std::string& path) const {
+    if (!provenance_) {
+        return std::nullopt;
+    }
+    return provenance_->origin(path);
 }
 
 // =============================================================================
@@ -167,95 +215,366 @@ bool Config::contains(const std::string& path) const {
 
 std::string Config::to_json(int indent) const {
     if (indent < 0) {
-        return data_.dump();
+        return data_->dump();
     }
-    return data_.dump(indent);
+    return data_->dump(indent);
 }
 
 namespace {
 
 /**
- * @brief Recursively convert nlohmann::json to toml::table
+ * @brief Stream buffer that hands fixed-size chunks to an OutputSink
  */
-toml::table json_to_toml(const Value& json);
-
-toml::array json_array_to_toml(const Value& json) {
-    toml::array arr;
-    for (const auto& elem : json) {
-        if (elem.is_null()) {
-            // TOML doesn't support null - convert to empty string
-            arr.push_back("");
-        } else if (elem.is_boolean()) {
-            arr.push_back(elem.get<bool>());
-        } else if (elem.is_number_integer()) {
-            arr.push_back(elem.get<int64_t>());
-        } else if (elem.is_number_float()) {
-            arr.push_back(elem.get<double>());
-        } else if (elem.is_string()) {
-            arr.push_back(elem.get<std::string>());
-        } else if (elem.is_array()) {
-            arr.push_back(json_array_to_toml(elem));
-        } else if (elem.is_object()) {
-            arr.push_back(json_to_toml(elem));
+class SinkBuffer : public std::streambuf {
+public:
+    explicit SinkBuffer(const OutputSink& sink) : sink_(sink) {
+        setp(buffer_, buffer_ + sizeof(buffer_));
+    }
+
+    /**
+     * @brief Pass any buffered output to the sink
+     */
+    void flush_to_sink() {
+        const auto pending = static_cast<size_t>(pptr() - pbase());
+        if (pending > 0) {
+            sink_(pbase(), pending);
+            setp(buffer_, buffer_ + sizeof(buffer_));
         }
     }
-    return arr;
-}
 
-toml::table json_to_toml(const Value& json) {
-    toml::table tbl;
-
-    if (!json.is_object()) {
-        return tbl;
-    }
-
-    for (auto it = json.begin(); it != json.end(); ++it) {
-        const std::string& key = it.key();
-        const Value& val = it.value();
-
-        if (val.is_null()) {
-            // TOML doesn't support null - convert to empty string
-            tbl.insert_or_assign(key, "");
-        } else if (val.is_boolean()) {
-            tbl.insert_or_assign(key, val.get<bool>());
-        } else if (val.is_number_integer()) {
-            tbl.insert_or_assign(key, val.get<int64_t>());
-        } else if (val.is_number_float()) {
-            tbl.insert_or_assign(key, val.get<double>());
-        } else if (val.is_string()) {
-            tbl.insert_or_assign(key, val.get<std::string>());
-        } else if (val.is_array()) {
-            tbl.insert_or_assign(key, json_array_to_toml(val));
-        } else if (val.is_object()) {
-            tbl.insert_or_assign(key, json_to_toml(val));
+protected:
+    int_type overflow(int_type ch) override {
+        flush_to_sink();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
         }
+        return traits_type::not_eof(ch);
     }
 
-    return tbl;
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        if (n >= static_cast<std::streamsize>(sizeof(buffer_))) {
+            // Large pieces (long strings) bypass the buffer
+            flush_to_sink();
+            sink_(s, static_cast<size_t>(n));
+            return n;
+        }
+        return std::streambuf::xsputn(s, n);
+    }
+
+    int sync() override {
+        flush_to_sink();
+        return 0;
+    }
+
+private:
+    const OutputSink& sink_;
+    char buffer_[16 * 1024];
+};
+
+} // anonymous namespace
+
+void Config::to_json(std::ostream& out, int indent) const {
+    if (indent == 0) {
+        // operator<< has no spelling for "newlines without indentation"
+        out << data_->dump(0);
+        return;
+    }
+    // nlohmann streams straight into out; width selects pretty printing
+    out << std::setw(indent < 0 ? 0 : indent) << *data_;
 }
 
+void Config::to_json(const OutputSink& sink, int indent) const {
+    SinkBuffer buffer(sink);
+    std::ostream out(&buffer);
+    // Let exceptions from the sink reach the caller
+    out.exceptions(std::ios::badbit);
+    to_json(out, indent);
+    buffer.flush_to_sink();
+}
+
+namespace {
+
+/**
+ * @brief Writes a Value tree as TOML text directly to a stream
+ *
+ * Emits the same document json_to_toml() + toml++ used to produce, without
+ * building an intermediate toml::table:
+ * - null becomes "" (TOML has no null)
+ * - Non-empty arrays whose elements are all objects become [[tables]]
+ * - Other arrays are inline; objects inside them are inline tables
+ * - A table gets a [header] if it has plain keys or is empty
+ */
+class TomlWriter {
+public:
+    explicit TomlWriter(std::ostream& out) : out_(out) {}
+
+    void write_document(const Value& root) {
+        if (!root.is_object()) {
+            return;
+        }
+        write_table_body(root, "");
+    }
+
+private:
+    std::ostream& out_;
+    bool wrote_anything_ = false;
+
+    static bool is_bare_key(const std::string& key) {
+        if (key.empty()) {
+            return false;
+        }
+        for (char c : key) {
+            const bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                            (c >= '0' && c <= '9') || c == '_' || c == '-';
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool is_table_array(const Value& val) {
+        if (!val.is_array() || val.empty()) {
+            return false;
+        }
+        for (const auto& elem : val) {
+            if (!elem.is_object()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Emitted as "key = value" inside the current table
+    static bool is_inline(const Value& val) {
+        return !val.is_object() && !is_table_array(val);
+    }
+
+    void write_string(const std::string& str) {
+        static const char hex[] = "0123456789ABCDEF";
+        out_.put('"');
+        for (char c : str) {
+            switch (c) {
+                case '"':  out_ << "\\\""; break;
+                case '\\': out_ << "\\\\"; break;
+                case '\b': out_ << "\\b"; break;
+                case '\t': out_ << "\\t"; break;
+                case '\n': out_ << "\\n"; break;
+                case '\f': out_ << "\\f"; break;
+                case '\r': out_ << "\\r"; break;
+                default: {
+                    const auto uc = static_cast<unsigned char>(c);
+                    if (uc < 0x20 || uc == 0x7F) {
+                        out_ << "\\u00" << hex[uc >> 4] << hex[uc & 0xF];
+                    } else {
+                        out_.put(c);
+                    }
+                }
+            }
+        }
+        out_.put('"');
+    }
+
+    void write_key(const std::string& key) {
+        if (is_bare_key(key)) {
+            out_ << key;
+        } else {
+            write_string(key);
+        }
+    }
+
+    void write_value(const Value& val) {
+        switch (val.type()) {
+            case Value::value_t::null:
+                // TOML doesn't support null - convert to empty string
+                out_ << "\"\"";
+                break;
+            case Value::value_t::boolean:
+                out_ << (val.get<bool>() ? "true" : "false");
+                break;
+            case Value::value_t::number_integer:
+                out_ << val.get<int64_t>();
+                break;
+            case Value::value_t::number_unsigned: {
+                // TOML integers are signed 64-bit; larger values can't be written
+                const auto u = val.get<uint64_t>();
+                if (u > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                    throw ConfigError("Cannot write " + std::to_string(u) +
+                                      " to TOML: integers are limited to 64-bit signed");
+                }
+                out_ << static_cast<int64_t>(u);
+                break;
+            }
+            case Value::value_t::number_float:
+                write_float(val.get<double>());
+                break;
+            case Value::value_t::string:
+                write_string(val.get_ref<const std::string&>());
+                break;
+            case Value::value_t::array:
+                write_inline_array(val);
+                break;
+            case Value::value_t::object:
+                write_inline_table(val);
+                break;
+            default:
+                out_ << "\"\"";
+                break;
+        }
+    }
+
+    void write_float(double d) {
+        if (std::isnan(d)) {
+            out_ << "nan";
+        } else if (std::isinf(d)) {
+            out_ << (d < 0 ? "-inf" : "inf");
+        } else {
+            // Shortest round-trip form; always has '.' or an exponent
+            out_ << Value(d).dump();
+        }
+    }
+
+    void write_inline_array(const Value& arr) {
+        if (arr.empty()) {
+            out_ << "[]";
+            return;
+        }
+        out_ << "[ ";
+        bool first = true;
+        for (const auto& elem : arr) {
+            if (!first) out_ << ", ";
+            first = false;
+            write_value(elem);
+        }
+        out_ << " ]";
+    }
+
+    void write_inline_table(const Value& obj) {
+        if (obj.empty()) {
+            out_ << "{}";
+            return;
+        }
+        out_ << "{ ";
+        bool first = true;
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            if (!first) out_ << ", ";
+            first = false;
+            write_key(it.key());
+            out_ << " = ";
+            write_value(it.value());
+        }
+        out_ << " }";
+    }
+
+    void write_header(const std::string& path, bool array_element) {
+        if (wrote_anything_) {
+            out_.put('\n');
+        }
+        out_ << (array_element ? "[[" : "[") << path << (array_element ? "]]" : "]") << '\n';
+        wrote_anything_ = true;
+    }
+
+    /// Header path of a sub-table: prefix.key (key quoted if needed)
+    static std::string child_path(const std::string& prefix, const std::string& key) {
+        std::ostringstream oss;
+        if (!prefix.empty()) {
+            oss << prefix << '.';
+        }
+        TomlWriter(oss).write_key(key);
+        return oss.str();
+    }
+
+    /**
+     * @brief Write plain keys, then sub-tables and arrays of tables
+     */
+    void write_table_body(const Value& obj, const std::string& path) {
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            if (is_inline(it.value())) {
+                write_key(it.key());
+                out_ << " = ";
+                write_value(it.value());
+                out_.put('\n');
+                wrote_anything_ = true;
+            }
+        }
+
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            const Value& val = it.value();
+            if (is_inline(val)) {
+                continue;
+            }
+
+            const std::string sub = child_path(path, it.key());
+            if (val.is_object()) {
+                write_table(val, sub);
+            } else {
+                for (const auto& elem : val) {
+                    write_header(sub, true);
+                    write_table_body(elem, sub);
+                }
+            }
+        }
+    }
+
+    void write_table(const Value& obj, const std::string& path) {
+        bool has_plain_keys = false;
+        for (const auto& val : obj) {
+            if (is_inline(val)) {
+                has_plain_keys = true;
+                break;
+            }
+        }
+
+        // Tables holding only sub-tables are implied by their children's
+        // headers; empty tables need their own to survive a round trip
+        if (has_plain_keys || obj.empty()) {
+            write_header(path, false);
+        }
+        write_table_body(obj, path);
+    }
+};
+
 } // anonymous namespace
 
 std::string Config::to_toml() const {
-    toml::table tbl = json_to_toml(data_);
     std::ostringstream oss;
-    oss << tbl;
+    to_toml(oss);
     return oss.str();
 }
 
+void Config::to_toml(std::ostream& out) const {
+    TomlWriter(out).write_document(*data_);
+}
+
+void Config::to_toml(const OutputSink& sink) const {
+    SinkBuffer buffer(sink);
+    std::ostream out(&buffer);
+    // Let exceptions from the sink reach the caller
+    out.exceptions(std::ios::badbit);
+    to_toml(out);
+    buffer.flush_to_sink();
+}
+
 // =============================================================================
 // Merge Operations
 // =============================================================================
 
 void Config::merge(const Config& other) {
-    data_ = deep_merge(data_, other.data_);
+    // deep_merge builds a fresh tree, so the previous one is left intact
+    // for any copies still sharing it
+    data_ = std::make_shared<Value>(deep_merge(*data_, *other.data_));
+    provenance_.reset();
+    unsharable_ = false;
 }
 
 void Config::merge(const Value& other) {
     if (!other.is_object()) {
         throw TypeError("", "object", type_name(other));
     }
-    data_ = deep_merge(data_, other);
+    data_ = std::make_shared<Value>(deep_merge(*data_, other));
+    provenance_.reset();
+    unsharable_ = false;
 }
 
 // =============================================================================
@@ -267,12 +586,8 @@ void Config::validate_mandatory(const std::vector<std::string>& mandatory) const
     std::vector<std::string> missing;
 
     for (const auto& key : mandatory) {
-        try {
-            if (!contains_dot(data_, key)) {
-                missing.push_back(key);
-            }
-        } catch (const TypeError&) {
-            // RULE M3: Path into non-container counts as missing
+        // RULE M3: Path into non-container counts as missing
+        if (!try_get_by_dot(*data_, key).found()) {
             missing.push_back(key);
         }
     }
@@ -289,20 +604,20 @@ void Config::validate_mandatory(const std::vector<std::string>& mandatory) const
 Value Config::overrides_to_value(
     const std::unordered_map<std::string, Value>& overrides) {
 
-    Value result = Value::object();
+    TreeBuilder tree;
+    tree.reserve(overrides.size());
 
     for (const auto& [path, value] : overrides) {
         // Parse string values using the same rules as env vars
-        Value parsed_value = value;
         if (value.is_string()) {
-            parsed_value = parse_value(value.get<std::string>());
+            tree.add(path, parse_value(value.get_ref<const std::string&>()));
+        } else {
+            tree.add(path, value);
         }
-
-        // Use set_by_dot to build nested structure
-        set_by_dot(result, path, parsed_value, true /* create_missing */);
     }
 
-    return result;
+    // Sorted by path, so the result does not depend on hash order
+    return tree.build();
 }
 
 } // namespace confy
@@ -0,0 +1,140 @@
+/**
+ * @file ConfigWatcher.cpp
+ * @brief Change-driven configuration reload implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/ConfigWatcher.hpp"
+#include "confy/EnvMapper.hpp"
+#include "confy/Loader.hpp"
+
+#include <system_error>
+#include <utility>
+
+namespace confy {
+
+ConfigWatcher::ConfigWatcher(LoadOptions opts)
+    : opts_(std::move(opts))
+{
+    load();
+}
+
+ConfigWatcher::ConfigWatcher(LoadOptions opts, Config current)
+    : opts_(std::move(opts)), config_(std::move(current))
+{
+    record();
+}
+
+ConfigWatcher::Stamp ConfigWatcher::stamp(const std::string& path) {
+    Stamp result;
+    if (path.empty()) {
+        return result;
+    }
+
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return result;
+    }
+    auto size = std::filesystem::file_size(path, ec);
+    result.exists = true;
+    result.mtime = mtime;
+    result.size = ec ? 0 : size;
+    return result;
+}
+
+std::string ConfigWatcher::dotenv_file() const {
+    if (!opts_.load_dotenv_file) {
+        return "";
+    }
+    // Same default as Config::load()
+    return opts_.dotenv_path.empty() ? ".env" : opts_.dotenv_path;
+}
+
+void ConfigWatcher::load() {
+    // Files are stamped before loading, so an edit during the load is
+    // seen by the next refresh()
+    Stamp file = stamp(opts_.file_path);
+    Stamp dotenv = stamp(dotenv_file());
+
+    // A reload may follow a change in which directories hold a .env
+    clear_dotenv_cache();
+
+    // .env does not override, so its new values only apply once the
+    // variables the previous one set are gone. Of the variables unset
+    // now, those holding their .env value after the load came from it.
+    withdraw_dotenv();
+    DotenvResult parsed;
+    if (opts_.load_dotenv_file) {
+        parsed = parse_dotenv_file(dotenv_file());
+    }
+    std::vector<bool> absent;
+    absent.reserve(parsed.entries.size());
+    for (const auto& entry : parsed.entries) {
+        absent.push_back(!has_env_var(entry.first));
+    }
+
+    auto commit = [&]() {
+        file_ = file;
+        dotenv_ = dotenv;
+        for (size_t i = 0; i < absent.size(); ++i) {
+            auto& [name, value] = parsed.entries[i];
+            if (absent[i] && get_env_var(name) == value) {
+                dotenv_vars_.emplace_back(std::move(name), std::move(value));
+            }
+        }
+        // After the load: the .env overlay is part of the environment now
+        env_ = env_fingerprint(opts_.prefix);
+    };
+
+    try {
+        config_ = Config::load(opts_);
+    } catch (...) {
+        commit();  // Do not retry the same broken sources on every poll
+        throw;
+    }
+    commit();
+}
+
+void ConfigWatcher::record() {
+    file_ = stamp(opts_.file_path);
+    dotenv_ = stamp(dotenv_file());
+    env_ = env_fingerprint(opts_.prefix);
+
+    // Loaded elsewhere: take a variable still holding its .env value as
+    // set from .env, as Config::origin() does
+    dotenv_vars_.clear();
+    if (opts_.load_dotenv_file) {
+        for (auto& [name, value] : parse_dotenv_file(dotenv_file()).entries) {
+            if (get_env_var(name) == value) {
+                dotenv_vars_.emplace_back(std::move(name), std::move(value));
+            }
+        }
+    }
+}
+
+void ConfigWatcher::withdraw_dotenv() {
+    for (const auto& [name, value] : dotenv_vars_) {
+        if (get_env_var(name) == value) {
+            unset_env_var(name);
+        }
+    }
+    dotenv_vars_.clear();
+}
+
+bool ConfigWatcher::changed() const {
+    return stamp(opts_.file_path) != file_ ||
+           stamp(dotenv_file()) != dotenv_ ||
+           env_fingerprint(opts_.prefix) != env_;
+}
+
+bool ConfigWatcher::refresh() {
+    if (!changed()) {
+        return false;
+    }
+    load();
+    return true;
+}
+
+} // namespace confy
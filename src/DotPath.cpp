@@ -4,8 +4,8 @@
  */
 
 #include "confy/DotPath.hpp"
-#include <sstream>
 #include <algorithm>
+#include <sstream>
 
 namespace confy {
 
@@ -49,123 +49,169 @@ std::string join_dot_path(const std::vector<std::string>& segments) {
     return oss.str();
 }
 
-namespace {
-    /**
-     * @brief Check if segment represents an array index
-     * @param segment The segment to check
-     * @return true if segment is a valid non-negative integer
-     */
-    bool is_array_index(const std::string& segment) {
-        if (segment.empty()) return false;
-        // Must be all digits, no leading zeros except "0" itself
-        if (segment[0] == '0' && segment.size() > 1) return false;
-        return std::all_of(segment.begin(), segment.end(), ::isdigit);
-    }
-
-    /**
-     * @brief Parse array index from segment
-     * @param segment The segment string
-     * @return The index value
-     * @pre is_array_index(segment) must be true
-     */
-    size_t parse_array_index(const std::string& segment) {
-        return std::stoull(segment);
-    }
+bool is_array_index(const std::string& segment) {
+    // Must be all digits, no leading zeros except "0" itself
+    return detail::is_array_index_sv(segment);
 }
 
-const Value* get_by_dot(const Value& data, const std::string& path) {
-    const auto segments = split_dot_path(path);
-    if (segments.empty()) {
-        return &data; // Empty path returns root
+size_t parse_array_index(std::string_view segment) noexcept {
+    size_t value = 0;
+    for (char c : segment) {
+        size_t digit = static_cast<size_t>(c - '0');
+        if (value > (StaticPath::NOT_AN_INDEX - digit) / 10) {
+            return StaticPath::NOT_AN_INDEX;
+        }
+        value = value * 10 + digit;
     }
+    return value;
+}
 
+LookupResult try_get_by_dot(const Value& data, std::string_view path) noexcept {
+    LookupResult result;
     const Value* current = &data;
-    std::string partial_path;
-
-    for (size_t i = 0; i < segments.size(); ++i) {
-        const auto& seg = segments[i];
-
-        // Build partial path for error messages
-        if (!partial_path.empty()) partial_path += '.';
-        partial_path += seg;
-
-        // Check if we can traverse into current
-        if (!current->is_object() && !current->is_array()) {
-            throw TypeError(
-                path,
-                "object or array",
-                type_name(*current)
-            );
+    const std::string_view view = path;
+
+    // Walk segments in place; empty segments are skipped like split_dot_path
+    size_t start = 0;
+    while (start <= view.size()) {
+        size_t end = view.find('.', start);
+        if (end == std::string_view::npos) {
+            end = view.size();
+        }
+        const std::string_view seg = view.substr(start, end - start);
+        start = end + 1;
+        if (seg.empty()) {
+            continue;
         }
 
         if (current->is_object()) {
-            // Object traversal
-            if (!current->contains(seg)) {
-                throw KeyError(path, seg);
+            auto it = current->find(seg);
+            if (it == current->end()) {
+                result.segment = seg;
+                return result;
             }
-            current = &(*current)[seg];
-        } else {
-            // Array traversal
-            if (!is_array_index(seg)) {
-                throw KeyError(path, seg + " (not a valid array index)");
+            current = &*it;
+        } else if (current->is_array()) {
+            if (!detail::is_array_index_sv(seg)) {
+                result.segment = seg;
+                result.detail = " (not a valid array index)";
+                return result;
             }
-
             size_t idx = parse_array_index(seg);
             if (idx >= current->size()) {
-                throw KeyError(path, seg + " (index out of range)");
+                result.segment = seg;
+                result.detail = " (index out of range)";
+                return result;
             }
             current = &(*current)[idx];
+        } else {
+            result.status = LookupStatus::TypeMismatch;
+            result.value = current;
+            return result;
         }
     }
 
-    return current;
+    result.status = LookupStatus::Found;
+    result.value = current;
+    return result;
 }
 
-const Value* get_by_dot(const Value& data, const std::string& path,
-                       const Value& default_val) {
-    const auto segments = split_dot_path(path);
-    if (segments.empty()) {
-        return &data;
+std::string LookupResult::message(const std::string& path) const {
+    switch (status) {
+        case LookupStatus::Found:
+            return "";
+        case LookupStatus::Missing:
+            return KeyError(path, std::string(segment) + detail).what();
+        case LookupStatus::TypeMismatch:
+            return TypeError(path, "object or array", type_name(*value)).what();
     }
+    return "";
+}
 
-    const Value* current = &data;
+void LookupResult::throw_if_error(const std::string& path) const {
+    switch (status) {
+        case LookupStatus::Found:
+            return;
+        case LookupStatus::Missing:
+            throw KeyError(path, std::string(segment) + detail);
+        case LookupStatus::TypeMismatch:
+            throw TypeError(path, "object or array", type_name(*value));
+    }
+}
 
-    for (size_t i = 0; i < segments.size(); ++i) {
-        const auto& seg = segments[i];
+const Value* get_by_dot(const Value& data, const std::string& path) {
+    // RULE D1: Raise KeyError/TypeError if path doesn't resolve
+    LookupResult result = try_get_by_dot(data, path);
+    result.throw_if_error(path);
+    return result.value;
+}
 
-        // Check if we can traverse into current
-        if (!current->is_object() && !current->is_array()) {
+const Value* get_by_dot(const Value& data, const std::string& path,
+                       const Value& default_val) {
+    LookupResult result = try_get_by_dot(data, path);
+    switch (result.status) {
+        case LookupStatus::Found:
+            return result.value;
+        case LookupStatus::Missing:
+            return &default_val;
+        case LookupStatus::TypeMismatch:
             // RULE D2: Still raise TypeError even with default
-            throw TypeError(
-                path,
-                "object or array",
-                type_name(*current)
-            );
-        }
+            result.throw_if_error(path);
+    }
+    return &default_val;
+}
 
+LookupResult try_get_by_dot(const Value& data, const StaticPath& path) noexcept {
+    LookupResult result;
+    const Value* current = &data;
+
+    for (size_t i = 0; i < path.size(); ++i) {
         if (current->is_object()) {
-            if (!current->contains(seg)) {
-                // Key not found - return default
-                return &default_val;
+            auto it = current->find(path[i]);
+            if (it == current->end()) {
+                result.segment = path[i];
+                return result;
             }
-            current = &(*current)[seg];
-        } else {
-            // Array traversal
-            if (!is_array_index(seg)) {
-                // Not a valid index - return default
-                return &default_val;
+            current = &*it;
+        } else if (current->is_array()) {
+            // Index validated and parsed when the path was tokenized
+            if (!path.is_index(i)) {
+                result.segment = path[i];
+                result.detail = " (not a valid array index)";
+                return result;
             }
-
-            size_t idx = parse_array_index(seg);
-            if (idx >= current->size()) {
-                // Out of range - return default
-                return &default_val;
+            if (path.index(i) >= current->size()) {
+                result.segment = path[i];
+                result.detail = " (index out of range)";
+                return result;
             }
-            current = &(*current)[idx];
+            current = &(*current)[path.index(i)];
+        } else {
+            result.status = LookupStatus::TypeMismatch;
+            result.value = current;
+            return result;
         }
     }
 
-    return current;
+    result.status = LookupStatus::Found;
+    result.value = current;
+    return result;
+}
+
+const Value* get_by_dot(const Value& data, const StaticPath& path) {
+    LookupResult result = try_get_by_dot(data, path);
+    result.throw_if_error(std::string(path.str()));
+    return result.value;
+}
+
+const Value* get_by_dot(const Value& data, const StaticPath& path,
+                       const Value& default_val) {
+    LookupResult result = try_get_by_dot(data, path);
+    if (result.status == LookupStatus::TypeMismatch) {
+        // RULE D2: Still raise TypeError even with default
+        result.throw_if_error(std::string(path.str()));
+    }
+    return result.found() ? result.value : &default_val;
 }
 
 void set_by_dot(Value& data, const std::string& path,
@@ -226,48 +272,136 @@ void set_by_dot(Value& data, const std::string& path,
     (*current)[final_seg] = value;
 }
 
-bool contains_dot(const Value& data, const std::string& path) {
-    const auto segments = split_dot_path(path);
-    if (segments.empty()) {
-        return true; // Empty path always exists (root)
+// =============================================================================
+// TreeBuilder
+// =============================================================================
+
+namespace {
+
+/// Segment-by-segment path order: '.' sorts before every other byte
+bool path_less(const std::string& a, const std::string& b) {
+    const size_t n = std::min(a.size(), b.size());
+    for (size_t i = 0; i < n; ++i) {
+        if (a[i] != b[i]) {
+            if (a[i] == '.') return true;
+            if (b[i] == '.') return false;
+            return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i]);
+        }
     }
+    return a.size() < b.size();
+}
 
-    const Value* current = &data;
+void split_views(std::string_view path, std::vector<std::string_view>& out) {
+    out.clear();
+    size_t start = 0;
+    while (start < path.size()) {
+        size_t end = path.find('.', start);
+        if (end == std::string_view::npos) end = path.size();
+        out.push_back(path.substr(start, end - start));
+        start = end + 1;
+    }
+}
 
-    for (size_t i = 0; i < segments.size(); ++i) {
-        const auto& seg = segments[i];
+/**
+ * @brief Child @p key of object @p node, created as null if absent
+ *
+ * Paths arrive sorted, so a new key usually sorts after every key the
+ * object already has and is appended without a search.
+ */
+std::pair<Value*, bool> child_of(Value& node, std::string_view key) {
+    auto& object = node.get_ref<Value::object_t&>();
+    if (object.empty() || std::string_view(object.rbegin()->first) < key) {
+        return {&object.emplace_hint(object.end(), std::string(key), Value())->second, true};
+    }
+    auto it = object.find(key);
+    if (it != object.end()) {
+        return {&it->second, false};
+    }
+    return {&object.emplace(std::string(key), Value()).first->second, true};
+}
 
-        // Check if we can traverse into current
-        if (!current->is_object() && !current->is_array()) {
-            // RULE D6: Raise error for invalid traversal
-            throw TypeError(
-                path,
-                "object or array",
-                type_name(*current)
-            );
+} // anonymous namespace
+
+void TreeBuilder::add(std::string_view path, Value value) {
+    // Normalize like split_dot_path(): no empty segments
+    std::string normalized;
+    normalized.reserve(path.size());
+    for (char c : path) {
+        if (c != '.' || (!normalized.empty() && normalized.back() != '.')) {
+            normalized += c;
         }
+    }
+    if (!normalized.empty() && normalized.back() == '.') {
+        normalized.pop_back();
+    }
+    entries_.push_back({std::move(normalized), std::move(value)});
+}
 
-        if (current->is_object()) {
-            if (!current->contains(seg)) {
-                // RULE D5: Return false for missing key (no error)
-                return false;
-            }
-            current = &(*current)[seg];
-        } else {
-            // Array traversal
-            if (!is_array_index(seg)) {
-                return false; // Not a valid index
-            }
+Value TreeBuilder::build() {
+    std::vector<Entry> entries = std::move(entries_);
+    entries_.clear();
 
-            size_t idx = parse_array_index(seg);
-            if (idx >= current->size()) {
-                return false; // Out of range
+    // Stable: the same path keeps its insertion order, so the last one wins
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry& a, const Entry& b) { return path_less(a.path, b.path); });
+
+    Value root = Value::object();
+
+    // stack[k] is the node reached through the first k segments of `previous`
+    std::vector<Value*> stack{&root};
+    std::vector<std::string_view> previous;
+    std::vector<std::string_view> segments;
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        Entry& entry = entries[i];
+        if (i + 1 < entries.size() && entries[i + 1].path == entry.path) {
+            continue;  // Superseded by a later add()
+        }
+
+        if (entry.path.empty()) {
+            root = std::move(entry.value);
+            stack.assign(1, &root);
+            previous.clear();
+            continue;
+        }
+
+        split_views(entry.path, segments);
+
+        // Reuse the nodes of the prefix shared with the previous path
+        size_t shared = 0;
+        const size_t limit = std::min({previous.size(), segments.size() - 1, stack.size() - 1});
+        while (shared < limit && previous[shared] == segments[shared]) {
+            ++shared;
+        }
+        stack.resize(shared + 1);
+
+        Value* node = stack.back();
+        for (size_t s = shared; s + 1 < segments.size() && node->is_object(); ++s) {
+            auto [child, created] = child_of(*node, segments[s]);
+            if (created) {
+                *child = Value::object();
             }
-            current = &(*current)[idx];
+            node = child;
+            stack.push_back(node);
+        }
+        previous.swap(segments);
+
+        // A non-object value above this path ends it
+        if (stack.size() == previous.size() && node->is_object()) {
+            *child_of(*node, previous.back()).first = std::move(entry.value);
         }
     }
+    return root;
+}
 
-    return true;
+bool contains_dot(const Value& data, const std::string& path) {
+    LookupResult result = try_get_by_dot(data, path);
+    if (result.status == LookupStatus::TypeMismatch) {
+        // RULE D6: Raise error for invalid traversal
+        result.throw_if_error(path);
+    }
+    // RULE D5: Missing key is simply false (no error)
+    return result.found();
 }
 
 } // namespace confy
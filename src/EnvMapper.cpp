@@ -19,11 +19,15 @@
 #include "confy/Parse.hpp"
 #include "confy/DotPath.hpp"
 #include "confy/Errors.hpp"
+#include "confy/Util.hpp"
 
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string_view>
 
 // Platform-specific environment variable access
 #ifdef _WIN32
@@ -107,16 +111,6 @@ const std::vector<std::string> SYSTEM_VAR_PREFIXES = {
 
 namespace {
 
-/**
- * @brief Convert string to uppercase.
- */
-std::string to_upper(const std::string& s) {
-    std::string result = s;
-    std::transform(result.begin(), result.end(), result.begin(),
-                   [](unsigned char c) { return std::toupper(c); });
-    return result;
-}
-
 /**
  * @brief Convert string to lowercase.
  */
@@ -130,7 +124,7 @@ std::string to_lower(const std::string& s) {
 /**
  * @brief Check if string starts with prefix (case-insensitive).
  */
-bool starts_with_icase(const std::string& str, const std::string& prefix) {
+bool starts_with_icase(std::string_view str, std::string_view prefix) {
     if (prefix.size() > str.size()) return false;
     return std::equal(prefix.begin(), prefix.end(), str.begin(),
                       [](char a, char b) {
@@ -155,77 +149,120 @@ std::string replace_all(const std::string& str,
 }
 
 /**
- * @brief Get all environment variables as (name, value) pairs.
+ * @brief Call fn(name, value) for every environment variable, in order.
+ * Nothing is copied; the views are valid until the environment changes.
  */
-std::vector<std::pair<std::string, std::string>> get_all_env_vars() {
-    std::vector<std::pair<std::string, std::string>> result;
-
+template <typename Fn>
+void for_each_env_var(Fn fn) {
 #ifdef _WIN32
     // Windows implementation using GetEnvironmentStrings
     LPCH env_block = GetEnvironmentStrings();
-    if (env_block == nullptr) return result;
+    if (env_block == nullptr) return;
 
     LPCH current = env_block;
     while (*current != '\0') {
-        std::string entry(current);
+        std::string_view entry(current);
         size_t eq_pos = entry.find('=');
-        if (eq_pos != std::string::npos && eq_pos > 0) {
-            std::string name = entry.substr(0, eq_pos);
-            std::string value = entry.substr(eq_pos + 1);
-            result.emplace_back(std::move(name), std::move(value));
+        if (eq_pos != std::string_view::npos && eq_pos > 0) {
+            fn(entry.substr(0, eq_pos), entry.substr(eq_pos + 1));
         }
         current += entry.length() + 1;
     }
     FreeEnvironmentStrings(env_block);
 #else
     // POSIX implementation using environ
-    if (environ == nullptr) return result;
+    if (environ == nullptr) return;
 
     for (char** env = environ; *env != nullptr; ++env) {
-        std::string entry(*env);
+        std::string_view entry(*env);
         size_t eq_pos = entry.find('=');
-        if (eq_pos != std::string::npos) {
-            std::string name = entry.substr(0, eq_pos);
-            std::string value = entry.substr(eq_pos + 1);
-            result.emplace_back(std::move(name), std::move(value));
+        if (eq_pos != std::string_view::npos) {
+            fn(entry.substr(0, eq_pos), entry.substr(eq_pos + 1));
         }
     }
 #endif
-
-    return result;
 }
 
 /**
- * @brief Flatten nested Value to (dot_path, value) pairs.
+ * @brief "PREFIX_" to match names against, or empty for RULE E2 (empty prefix).
  */
-std::vector<std::pair<std::string, Value>> flatten_to_pairs(
-    const Value& data,
-    const std::string& prefix = ""
-) {
-    std::vector<std::pair<std::string, Value>> result;
+std::string env_prefix_match(const std::string& prefix) {
+    if (prefix.empty()) {
+        return "";
+    }
+    // Normalize: remove trailing underscore if present
+    std::string normalized = prefix;
+    while (!normalized.empty() && normalized.back() == '_') {
+        normalized.pop_back();
+    }
+    return normalized + "_";
+}
 
-    if (!data.is_object()) {
-        if (!prefix.empty()) {
-            result.emplace_back(prefix, data);
+/**
+ * @brief RULE E2 without allocating (see is_system_variable()).
+ */
+bool is_system_name(std::string_view name) {
+    for (const auto& prefix : SYSTEM_VAR_PREFIXES) {
+        // Covers single-character prefixes like "_" matching exactly
+        if (starts_with_icase(name, prefix)) {
+            return true;
         }
-        return result;
     }
+    return false;
+}
+
+/**
+ * @brief RULE E1-E2: whether a variable belongs to the filtered environment.
+ */
+bool env_var_selected(std::string_view name, const std::string& prefix_match) {
+    if (!prefix_match.empty()) {
+        // RULE E1: Filter by prefix (case-insensitive)
+        return starts_with_icase(name, prefix_match);
+    }
+    // RULE E2: Empty prefix - include non-system vars
+    return !is_system_name(name);
+}
 
-    for (auto it = data.begin(); it != data.end(); ++it) {
-        std::string new_key = prefix.empty() ? it.key() : prefix + "." + it.key();
+/**
+ * @brief Insert every dot-path below @p node into @p keys (RULE E5).
+ */
+void collect_keys(const Value& node, std::string& path, std::set<std::string>& keys) {
+    for (auto it = node.begin(); it != node.end(); ++it) {
+        size_t mark = path.size();
+        if (mark != 0) path += '.';
+        path += it.key();
 
+        keys.insert(path);
         if (it.value().is_object()) {
-            // Add the key itself (for section matching)
-            result.emplace_back(new_key, it.value());
-            // Recurse into nested objects
-            auto nested = flatten_to_pairs(it.value(), new_key);
-            result.insert(result.end(), nested.begin(), nested.end());
-        } else {
-            result.emplace_back(new_key, it.value());
+            collect_keys(it.value(), path, keys);
         }
+        path.resize(mark);
     }
+}
 
-    return result;
+/**
+ * @brief Base keys for (defaults, file), reusing the previous load's set.
+ *
+ * Reloads usually see the same structure, so the last set is kept and
+ * verified against the layers before a new one is built.
+ */
+std::shared_ptr<const KeySet> base_keys_for(const Value& defaults, const Value& file) {
+    static std::mutex mutex;
+    static std::shared_ptr<const KeySet> last;
+
+    std::shared_ptr<const KeySet> cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cached = last;
+    }
+    if (cached && cached->same_as_layers(defaults, file)) {
+        return cached;
+    }
+
+    auto keys = std::make_shared<const KeySet>(KeySet::from_layers(defaults, file));
+    std::lock_guard<std::mutex> lock(mutex);
+    last = keys;
+    return keys;
 }
 
 } // anonymous namespace
@@ -235,25 +272,7 @@ std::vector<std::pair<std::string, Value>> flatten_to_pairs(
 // ============================================================================
 
 bool is_system_variable(const std::string& var_name) {
-    std::string var_upper = to_upper(var_name);
-
-    for (const auto& prefix : SYSTEM_VAR_PREFIXES) {
-        std::string prefix_upper = to_upper(prefix);
-
-        // For single-character prefixes like "_", check exact match
-        if (prefix.length() == 1) {
-            if (var_upper == prefix_upper) {
-                return true;
-            }
-        }
-
-        // For other prefixes, check if var starts with prefix
-        if (starts_with_icase(var_name, prefix)) {
-            return true;
-        }
-    }
-
-    return false;
+    return is_system_name(var_name);
 }
 
 std::string transform_env_name(const std::string& name) {
@@ -325,38 +344,41 @@ collect_env_vars(const std::optional<std::string>& prefix) {
         return result;
     }
 
-    const std::string& prefix_str = prefix.value();
-    std::string prefix_match;
+    const std::string prefix_match = env_prefix_match(prefix.value());
 
-    if (!prefix_str.empty()) {
-        // RULE E1: Non-empty prefix - filter by PREFIX_*
-        // Normalize: remove trailing underscore if present
-        std::string normalized = prefix_str;
-        while (!normalized.empty() && normalized.back() == '_') {
-            normalized.pop_back();
+    for_each_env_var([&](std::string_view name, std::string_view value) {
+        if (env_var_selected(name, prefix_match)) {
+            result.emplace_back(name, value);
         }
-        prefix_match = normalized + "_";
-    }
+    });
 
-    auto all_vars = get_all_env_vars();
+    return result;
+}
 
-    for (const auto& [name, value] : all_vars) {
-        bool should_include = false;
+uint64_t env_fingerprint(const std::optional<std::string>& prefix) {
+    if (!prefix.has_value()) {
+        return 0;
+    }
 
-        if (!prefix_match.empty()) {
-            // RULE E1: Filter by prefix (case-insensitive)
-            should_include = starts_with_icase(name, prefix_match);
-        } else {
-            // RULE E2: Empty prefix - include non-system vars
-            should_include = !is_system_variable(name);
-        }
+    const std::string prefix_match = env_prefix_match(prefix.value());
 
-        if (should_include) {
-            result.emplace_back(name, value);
+    // FNV-1a over "name=value\0" of each selected variable, in order
+    uint64_t h = 14695981039346656037ull;
+    auto feed = [&h](std::string_view bytes, char end) {
+        for (char c : bytes) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
         }
-    }
-
-    return result;
+        h ^= static_cast<unsigned char>(end);
+        h *= 1099511628211ull;
+    };
+    for_each_env_var([&](std::string_view name, std::string_view value) {
+        if (env_var_selected(name, prefix_match)) {
+            feed(name, '=');
+            feed(value, '\0');
+        }
+    });
+    return h;
 }
 
 std::set<std::string> flatten_keys(const Value& data, const std::string& prefix) {
@@ -369,27 +391,53 @@ std::set<std::string> flatten_keys(const Value& data, const std::string& prefix)
         return keys;
     }
 
-    for (auto it = data.begin(); it != data.end(); ++it) {
-        std::string new_key = prefix.empty() ? it.key() : prefix + "." + it.key();
-        keys.insert(new_key);
+    std::string path = prefix;
+    collect_keys(data, path, keys);
+    return keys;
+}
+
+namespace {
 
-        if (it.value().is_object()) {
-            auto nested = flatten_keys(it.value(), new_key);
-            keys.insert(nested.begin(), nested.end());
+/**
+ * @brief An ordered set of base keys with the KeySet queries
+ *
+ * Lets the std::set overload of remap_env_key() answer in O(log N)
+ * without building a KeySet on every call.
+ */
+class OrderedKeys {
+public:
+    explicit OrderedKeys(const std::set<std::string>& keys) : keys_(keys) {}
+
+    bool contains(const std::string& path) const {
+        return keys_.count(path) > 0;
+    }
+
+    bool contains_prefix(const std::string& prefix) const {
+        if (contains(prefix)) {
+            return true;
         }
+        // Keys below prefix sort together, right after "prefix."
+        std::string section = prefix + ".";
+        auto it = keys_.lower_bound(section);
+        return it != keys_.end() && it->compare(0, section.size(), section) == 0;
     }
 
-    return keys;
-}
+private:
+    const std::set<std::string>& keys_;
+};
 
-std::string remap_env_key(
+/**
+ * @brief RULE E5-E7 remapping against KeySet or OrderedKeys
+ */
+template <typename Keys>
+std::string remap_key(
     const std::string& dot_path,
-    const std::set<std::string>& base_keys,
+    const Keys& base_keys,
     const std::optional<std::string>& prefix,
     bool load_dotenv
 ) {
     // 1. Exact match? Use as-is
-    if (base_keys.count(dot_path) > 0) {
+    if (base_keys.contains(dot_path)) {
         return dot_path;
     }
 
@@ -411,13 +459,13 @@ std::string remap_env_key(
             // Replace remaining underscores with dots in 'rest'
             std::string candidate = root + "." + replace_all(rest, "_", ".");
 
-            if (base_keys.count(candidate) > 0) {
+            if (base_keys.contains(candidate)) {
                 return candidate;
             }
 
             // Also try keeping underscores in rest (for keys like feature_flags.beta_feature)
             candidate = root + "." + rest;
-            if (base_keys.count(candidate) > 0) {
+            if (base_keys.contains(candidate)) {
                 return candidate;
             }
 
@@ -427,7 +475,7 @@ std::string remap_env_key(
     }
 
     // Attempt: Check if reconstructed flat key exists directly
-    if (base_keys.count(reconstructed_flat) > 0) {
+    if (base_keys.contains(reconstructed_flat)) {
         return reconstructed_flat;
     }
 
@@ -443,30 +491,24 @@ std::string remap_env_key(
             candidate_prefix += segments[i];
         }
 
-        // Check if any base key starts with this prefix
-        for (const auto& base_key : base_keys) {
-            if (base_key == candidate_prefix ||
-                (base_key.length() > candidate_prefix.length() &&
-                 base_key.substr(0, candidate_prefix.length()) == candidate_prefix &&
-                 base_key[candidate_prefix.length()] == '.')) {
-
-                // Found potential match - reconstruct full key
-                if (prefix_len < segments.size()) {
-                    std::string remainder;
-                    for (size_t i = prefix_len; i < segments.size(); ++i) {
-                        if (!remainder.empty()) remainder += ".";
-                        remainder += segments[i];
-                    }
-                    std::string full_key = candidate_prefix + "." + remainder;
-
-                    // Verify this key or a prefix of it exists
-                    if (base_keys.count(full_key) > 0 ||
-                        base_keys.count(candidate_prefix) > 0) {
-                        return full_key;
-                    }
-                } else {
-                    return candidate_prefix;
+        // Check if any base key is this prefix or lies below it
+        if (base_keys.contains_prefix(candidate_prefix)) {
+            // Found potential match - reconstruct full key
+            if (prefix_len < segments.size()) {
+                std::string remainder;
+                for (size_t i = prefix_len; i < segments.size(); ++i) {
+                    if (!remainder.empty()) remainder += ".";
+                    remainder += segments[i];
                 }
+                std::string full_key = candidate_prefix + "." + remainder;
+
+                // Verify this key or a prefix of it exists
+                if (base_keys.contains(full_key) ||
+                    base_keys.contains(candidate_prefix)) {
+                    return full_key;
+                }
+            } else {
+                return candidate_prefix;
             }
         }
     }
@@ -494,15 +536,45 @@ std::string remap_env_key(
     return dot_path;
 }
 
-Value env_vars_to_nested(
-    const std::vector<std::pair<std::string, std::string>>& env_vars,
-    const std::optional<std::string>& prefix
+} // anonymous namespace
+
+std::string remap_env_key(
+    const std::string& dot_path,
+    const std::set<std::string>& base_keys,
+    const std::optional<std::string>& prefix,
+    bool load_dotenv
+) {
+    return remap_key(dot_path, OrderedKeys(base_keys), prefix, load_dotenv);
+}
+
+std::string remap_env_key(
+    const std::string& dot_path,
+    const KeySet& base_keys,
+    const std::optional<std::string>& prefix,
+    bool load_dotenv
 ) {
+    return remap_key(dot_path, base_keys, prefix, load_dotenv);
+}
+
+namespace {
+
+/**
+ * @brief Strip, transform and place each variable (RULE E3-E4).
+ *
+ * @param value_of Value stored for variable i: its parsed value, or the
+ *        index itself when a RemapPlan traces where each one ends up
+ */
+template <typename ValueOf>
+Value nest_env_vars(const std::vector<std::pair<std::string, std::string>>& env_vars,
+                    const std::optional<std::string>& prefix,
+                    ValueOf value_of) {
     Value result = Value::object();
 
     const std::string prefix_str = prefix.value_or("");
 
-    for (const auto& [name, raw_value] : env_vars) {
+    for (size_t i = 0; i < env_vars.size(); ++i) {
+        const std::string& name = env_vars[i].first;
+
         // Strip prefix from name
         std::string key_part;
         if (!prefix_str.empty()) {
@@ -515,12 +587,9 @@ Value env_vars_to_nested(
         // Transform using underscore rules
         std::string dot_key = transform_env_name(key_part);
 
-        // Parse value
-        Value parsed_value = parse_value(raw_value);
-
         // Set in result structure
         try {
-            set_by_dot(result, dot_key, parsed_value, true);
+            set_by_dot(result, dot_key, value_of(i), true);
         } catch (const std::exception& e) {
             // Skip variables that cause errors (e.g., invalid paths)
             continue;
@@ -530,46 +599,69 @@ Value env_vars_to_nested(
     return result;
 }
 
+/**
+ * @brief Step 4 of load_env_vars(): structure remapped pairs into a Value.
+ */
+Value structure_remapped(std::vector<std::pair<std::string, Value>> remapped) {
+    // Remapped keys are unique, and deepest-first order let a shallower
+    // key replace a deeper one; TreeBuilder keeps that outcome
+    TreeBuilder tree;
+    tree.reserve(remapped.size());
+    for (auto& [key, value] : remapped) {
+        tree.add(key, std::move(value));
+    }
+    return tree.build();
+}
+
+} // anonymous namespace
+
+Value env_vars_to_nested(
+    const std::vector<std::pair<std::string, std::string>>& env_vars,
+    const std::optional<std::string>& prefix
+) {
+    return nest_env_vars(env_vars, prefix, [&env_vars](size_t i) {
+        return parse_value(env_vars[i].second);
+    });
+}
+
 std::vector<std::pair<std::string, Value>> remap_and_flatten_env_data(
     const Value& nested_env_data,
     const Value& defaults_data,
     const Value& file_data,
     const std::optional<std::string>& prefix,
     bool load_dotenv
+) {
+    // Valid base keys: file sections laid over defaults, without merging
+    std::shared_ptr<const KeySet> base_keys = base_keys_for(defaults_data, file_data);
+    return remap_and_flatten_env_data(nested_env_data, *base_keys, prefix, load_dotenv);
+}
+
+std::vector<std::pair<std::string, Value>> remap_and_flatten_env_data(
+    const Value& nested_env_data,
+    const KeySet& base_keys,
+    const std::optional<std::string>& prefix,
+    bool load_dotenv
 ) {
     std::vector<std::pair<std::string, Value>> result;
 
-    // Combine defaults and file for base structure
-    Value base_config = defaults_data;
-    if (file_data.is_object()) {
-        for (auto it = file_data.begin(); it != file_data.end(); ++it) {
-            base_config[it.key()] = it.value();
-        }
+    // Flatten env data to (dot_path, value) leaves, values referenced in place
+    std::vector<std::pair<std::string, const Value*>> flat_items;
+    for (const auto& [dot_key, value] : leaves(nested_env_data)) {
+        flat_items.emplace_back(dot_key, &value);
     }
 
-    // Get valid base keys
-    std::set<std::string> base_keys = flatten_keys(base_config);
-
-    // Flatten env data to (dot_path, value) pairs
-    auto flat_items = flatten_to_pairs(nested_env_data);
-
     // Sort by depth (deepest first) to handle overlapping keys correctly
-    std::sort(flat_items.begin(), flat_items.end(),
-              [](const auto& a, const auto& b) {
-                  size_t depth_a = std::count(a.first.begin(), a.first.end(), '.');
-                  size_t depth_b = std::count(b.first.begin(), b.first.end(), '.');
-                  return depth_a > depth_b;
-              });
+    std::stable_sort(flat_items.begin(), flat_items.end(),
+                     [](const auto& a, const auto& b) {
+                         size_t depth_a = std::count(a.first.begin(), a.first.end(), '.');
+                         size_t depth_b = std::count(b.first.begin(), b.first.end(), '.');
+                         return depth_a > depth_b;
+                     });
 
     // Track already-set keys to avoid duplicates
     std::set<std::string> assigned_keys;
 
     for (const auto& [dot_key, value] : flat_items) {
-        // Skip object values (we only want leaf values)
-        if (value.is_object()) {
-            continue;
-        }
-
         // Attempt remapping
         std::string final_key = remap_env_key(dot_key, base_keys, prefix, load_dotenv);
 
@@ -583,24 +675,115 @@ std::vector<std::pair<std::string, Value>> remap_and_flatten_env_data(
             continue;
         }
 
-        result.emplace_back(final_key, value);
+        result.emplace_back(final_key, *value);
         assigned_keys.insert(final_key);
     }
 
     return result;
 }
 
-Value load_env_vars(
-    const std::optional<std::string>& prefix,
-    const Value& base_structure,
-    const Value& defaults_data,
-    const Value& file_data,
-    bool load_dotenv
-) {
-    // Suppress unused parameter warning - base_structure could be used for optimization
-    // but we delegate to remap_and_flatten_env_data which recomputes the merge
-    (void)base_structure;
+// ============================================================================
+// Remap Plans
+// ============================================================================
+
+RemapPlan RemapPlan::build(const EnvVars& env_vars,
+                           const KeySet& base_keys,
+                           const std::optional<std::string>& prefix,
+                           bool load_dotenv) {
+    RemapPlan plan;
+    plan.prefix_ = prefix;
+    plan.load_dotenv_ = load_dotenv;
+    plan.base_fingerprint_ = base_keys.fingerprint();
+    plan.base_size_ = base_keys.size();
+    plan.names_.reserve(env_vars.size());
+    for (const auto& entry : env_vars) {
+        plan.names_.push_back(entry.first);
+    }
+
+    // Run the pipeline with each variable's index as its value: every
+    // index that survives is a leaf placed at its final dot-path
+    Value traced = nest_env_vars(env_vars, prefix, [](size_t i) { return Value(i); });
+    for (auto& [key, value] : remap_and_flatten_env_data(traced, base_keys, prefix, load_dotenv)) {
+        plan.steps_.emplace_back(value.get<size_t>(), std::move(key));
+    }
+    return plan;
+}
+
+bool RemapPlan::matches(const EnvVars& env_vars,
+                        const KeySet& base_keys,
+                        const std::optional<std::string>& prefix,
+                        bool load_dotenv) const {
+    if (prefix != prefix_ || load_dotenv != load_dotenv_ ||
+        base_keys.fingerprint() != base_fingerprint_ || base_keys.size() != base_size_ ||
+        env_vars.size() != names_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < names_.size(); ++i) {
+        if (env_vars[i].first != names_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::optional<Value> RemapPlan::apply(const EnvVars& env_vars) const {
+    // Every value is parsed: an object anywhere adds paths the plan lacks
+    std::vector<Value> parsed;
+    parsed.reserve(env_vars.size());
+    for (const auto& entry : env_vars) {
+        parsed.push_back(parse_value(entry.second));
+        if (parsed.back().is_object()) {
+            return std::nullopt;
+        }
+    }
+
+    TreeBuilder tree;
+    tree.reserve(steps_.size());
+    for (const auto& [index, key] : steps_) {
+        tree.add(key, std::move(parsed[index]));
+    }
+    return tree.build();
+}
+
+std::vector<std::pair<std::string, std::string>> RemapPlan::targets() const {
+    std::vector<std::pair<std::string, std::string>> result;
+    result.reserve(steps_.size());
+    for (const auto& [index, key] : steps_) {
+        result.emplace_back(key, names_[index]);
+    }
+    return result;
+}
+
+// ============================================================================
+// Full Pipeline
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Env layer of a previous load and what it was built from.
+ */
+struct EnvLayer {
+    std::optional<std::string> prefix;
+    bool load_dotenv = false;
+    uint64_t env_fingerprint = 0;
+    uint64_t base_fingerprint = 0;
+    size_t base_size = 0;
+    Value data;
+
+    bool matches(const std::optional<std::string>& p, bool dotenv,
+                 uint64_t env_fp, const KeySet& base_keys) const {
+        return p == prefix && dotenv == load_dotenv && env_fp == env_fingerprint &&
+               base_keys.fingerprint() == base_fingerprint && base_keys.size() == base_size;
+    }
+};
 
+/**
+ * @brief Steps 1-4 of load_env_vars() against prebuilt base keys.
+ */
+Value build_env_layer(const std::optional<std::string>& prefix,
+                      const KeySet& base_keys,
+                      bool load_dotenv) {
     // Step 1: Collect environment variables
     auto env_vars = collect_env_vars(prefix);
 
@@ -608,26 +791,92 @@ Value load_env_vars(
         return Value::object();
     }
 
+    // Steps 2-3 for these names are usually known from the previous load
+    static std::mutex plan_mutex;
+    static std::shared_ptr<const RemapPlan> last_plan;
+
+    std::shared_ptr<const RemapPlan> plan;
+    {
+        std::lock_guard<std::mutex> lock(plan_mutex);
+        plan = last_plan;
+    }
+    if (!plan || !plan->matches(env_vars, base_keys, prefix, load_dotenv)) {
+        plan = std::make_shared<const RemapPlan>(
+            RemapPlan::build(env_vars, base_keys, prefix, load_dotenv));
+        std::lock_guard<std::mutex> lock(plan_mutex);
+        last_plan = plan;
+    }
+    if (auto result = plan->apply(env_vars)) {
+        return std::move(*result);
+    }
+
+    // A value parsed to an object: take the full pipeline
+
     // Step 2: Convert to nested structure
     Value nested_env = env_vars_to_nested(env_vars, prefix);
 
     // Step 3: Remap and flatten
-    auto remapped = remap_and_flatten_env_data(
-        nested_env, defaults_data, file_data, prefix, load_dotenv
-    );
+    auto remapped = remap_and_flatten_env_data(nested_env, base_keys, prefix, load_dotenv);
 
     // Step 4: Structure into final Value
-    Value result = Value::object();
+    return structure_remapped(std::move(remapped));
+}
 
-    for (const auto& [key, value] : remapped) {
-        try {
-            set_by_dot(result, key, value, true);
-        } catch (const std::exception& e) {
-            // Skip problematic keys
-            continue;
+} // anonymous namespace
+
+std::vector<std::pair<std::string, std::string>> env_var_origins(
+    const std::optional<std::string>& prefix,
+    const Value& defaults_data,
+    const Value& file_data,
+    bool load_dotenv
+) {
+    if (!prefix.has_value()) {
+        return {};
+    }
+    std::shared_ptr<const KeySet> base_keys = base_keys_for(defaults_data, file_data);
+    return RemapPlan::build(collect_env_vars(prefix), *base_keys, prefix, load_dotenv).targets();
+}
+
+Value load_env_vars(
+    const std::optional<std::string>& prefix,
+    const Value& base_structure,
+    const Value& defaults_data,
+    const Value& file_data,
+    bool load_dotenv
+) {
+    // Suppress unused parameter warning - base_structure could be used for optimization
+    // but we delegate to remap_and_flatten_env_data which recomputes the merge
+    (void)base_structure;
+
+    if (!prefix.has_value()) {
+        // RULE E3: nullopt disables env loading entirely
+        return Value::object();
+    }
+
+    // Unchanged environment and base keys: the previous layer still holds
+    uint64_t env_fp = env_fingerprint(prefix);
+    std::shared_ptr<const KeySet> base_keys = base_keys_for(defaults_data, file_data);
+
+    static std::mutex layer_mutex;
+    static std::shared_ptr<const EnvLayer> last_layer;
+    {
+        std::lock_guard<std::mutex> lock(layer_mutex);
+        if (last_layer && last_layer->matches(prefix, load_dotenv, env_fp, *base_keys)) {
+            return last_layer->data;
         }
     }
 
+    auto layer = std::make_shared<EnvLayer>();
+    layer->prefix = prefix;
+    layer->load_dotenv = load_dotenv;
+    layer->env_fingerprint = env_fp;
+    layer->base_fingerprint = base_keys->fingerprint();
+    layer->base_size = base_keys->size();
+    layer->data = build_env_layer(prefix, *base_keys, load_dotenv);
+
+    Value result = layer->data;
+    std::lock_guard<std::mutex> lock(layer_mutex);
+    last_layer = std::move(layer);
     return result;
 }
 
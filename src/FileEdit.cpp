@@ -0,0 +1,629 @@
+/**
+ * @file FileEdit.cpp
+ * @brief Crash-safe, minimal-rewrite editing of configuration files
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/FileEdit.hpp"
+#include "confy/Config.hpp"
+#include "confy/DotPath.hpp"
+#include "confy/Errors.hpp"
+#include "confy/Loader.hpp"
+
+#include <nlohmann/json.hpp>
+#include <toml++/toml.hpp>
+
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+    #include <process.h>
+#else
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace confy {
+
+namespace {
+
+// ============================================================================
+// Durable Writes
+// ============================================================================
+
+/**
+ * @brief Unique temporary path next to the target (same filesystem, so
+ *        the final rename is atomic)
+ */
+fs::path temp_path_for(const fs::path& target) {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    long pid = static_cast<long>(_getpid());
+#else
+    long pid = static_cast<long>(::getpid());
+#endif
+    std::string name = "." + target.filename().string() + ".tmp." +
+                       std::to_string(pid) + "." + std::to_string(counter++);
+    return target.parent_path() / name;
+}
+
+/**
+ * @brief Flush a written file's data to stable storage
+ */
+void sync_file(const fs::path& file) {
+#ifdef _WIN32
+    int fd = _wopen(file.c_str(), _O_WRONLY | _O_BINARY);
+    bool ok = fd >= 0 && _commit(fd) == 0;
+    if (fd >= 0) _close(fd);
+#else
+    int fd = ::open(file.c_str(), O_WRONLY);
+    bool ok = fd >= 0 && ::fsync(fd) == 0;
+    if (fd >= 0) ::close(fd);
+#endif
+    if (!ok) {
+        throw ConfigError("Cannot flush file to disk: " + file.string());
+    }
+}
+
+/**
+ * @brief Give a replacement file the owner and group of the file it replaces
+ *
+ * Best effort: only a privileged process may give a file away, so
+ * EPERM leaves the temporary file owned by the caller.
+ */
+void copy_owner(const fs::path& file, const fs::path& original) {
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(original.c_str(), &st) != 0) {
+        return;
+    }
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        (void)::fchown(fd, st.st_uid, st.st_gid);
+        ::close(fd);
+    }
+#else
+    (void)file;
+    (void)original;
+#endif
+}
+
+/**
+ * @brief Persist a rename by syncing the containing directory
+ *
+ * Best effort: not every platform or filesystem supports it.
+ */
+void sync_directory(const fs::path& dir) {
+#ifndef _WIN32
+    int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)dir;
+#endif
+}
+
+// ============================================================================
+// JSON Scanning
+// ============================================================================
+
+/**
+ * @brief Forward-only cursor that skips over JSON values without
+ *        building them
+ */
+class JsonCursor {
+public:
+    explicit JsonCursor(std::string_view text) : text_(text) {}
+
+    size_t pos() const { return pos_; }
+
+    void skip_ws() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+                text_[pos_] == '\r' || text_[pos_] == '\n')) {
+            ++pos_;
+        }
+    }
+
+    /// Skip whitespace and test the next character
+    bool at(char c) {
+        skip_ws();
+        return pos_ < text_.size() && text_[pos_] == c;
+    }
+
+    /// Skip whitespace and consume @p c if it is next
+    bool consume(char c) {
+        if (!at(c)) return false;
+        ++pos_;
+        return true;
+    }
+
+    /// Read a (possibly escaped) string, positioned at its opening quote
+    bool read_string(std::string& out) {
+        size_t start = pos_;
+        if (!skip_string()) return false;
+        std::string_view raw = text_.substr(start, pos_ - start);
+        if (raw.find('\\') == std::string_view::npos) {
+            out.assign(raw.substr(1, raw.size() - 2));
+            return true;
+        }
+        try {
+            out = Value::parse(raw).get<std::string>();
+            return true;
+        } catch (const nlohmann::json::exception&) {
+            return false;
+        }
+    }
+
+    /// Move past one complete value
+    bool skip_value() {
+        skip_ws();
+        if (pos_ >= text_.size()) return false;
+
+        char c = text_[pos_];
+        if (c == '"') {
+            return skip_string();
+        }
+        if (c == '{' || c == '[') {
+            size_t depth = 0;
+            while (pos_ < text_.size()) {
+                char ch = text_[pos_];
+                if (ch == '"') {
+                    if (!skip_string()) return false;
+                    continue;
+                }
+                if (ch == '{' || ch == '[') {
+                    ++depth;
+                } else if (ch == '}' || ch == ']') {
+                    if (--depth == 0) {
+                        ++pos_;
+                        return true;
+                    }
+                }
+                ++pos_;
+            }
+            return false;
+        }
+
+        // Number or literal
+        size_t start = pos_;
+        while (pos_ < text_.size() && std::strchr(",]} \t\r\n", text_[pos_]) == nullptr) {
+            ++pos_;
+        }
+        return pos_ > start;
+    }
+
+private:
+    bool skip_string() {
+        ++pos_;  // opening quote
+        while (pos_ < text_.size()) {
+            char ch = text_[pos_++];
+            if (ch == '\\') {
+                ++pos_;
+            } else if (ch == '"') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+// ============================================================================
+// TOML Scanning
+// ============================================================================
+
+bool is_bare_key_char(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+           (c >= '0' && c <= '9') || c == '_' || c == '-';
+}
+
+void skip_blanks(std::string_view line, size_t& i) {
+    while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) ++i;
+}
+
+/// True if only blanks or a comment remain from @p i
+bool rest_is_trivia(std::string_view line, size_t i) {
+    while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) ++i;
+    return i == line.size() || line[i] == '#';
+}
+
+/**
+ * @brief Parse one bare or quoted key starting at @p i
+ *
+ * Quoted keys with escape sequences are not decoded; they make the
+ * caller give up, which falls back to a full rewrite.
+ */
+bool parse_toml_key(std::string_view line, size_t& i, std::string& out) {
+    if (i >= line.size()) return false;
+
+    char quote = line[i];
+    if (quote == '"' || quote == '\'') {
+        size_t close = line.find(quote, i + 1);
+        if (close == std::string_view::npos) return false;
+        std::string_view inner = line.substr(i + 1, close - i - 1);
+        if (quote == '"' && inner.find('\\') != std::string_view::npos) return false;
+        out.assign(inner);
+        i = close + 1;
+        return true;
+    }
+
+    size_t start = i;
+    while (i < line.size() && is_bare_key_char(line[i])) ++i;
+    if (i == start) return false;
+    out.assign(line.substr(start, i - start));
+    return true;
+}
+
+/**
+ * @brief Parse a `[a.b."c"]` header line into its key segments
+ */
+bool parse_toml_header(std::string_view line, size_t i, std::vector<std::string>& out) {
+    ++i;  // '['
+    out.clear();
+    while (true) {
+        skip_blanks(line, i);
+        std::string key;
+        if (!parse_toml_key(line, i, key)) return false;
+        out.push_back(std::move(key));
+        skip_blanks(line, i);
+        if (i < line.size() && line[i] == '.') {
+            ++i;
+            continue;
+        }
+        if (i < line.size() && line[i] == ']') {
+            return rest_is_trivia(line, i + 1);
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief End of a single-line TOML value starting at @p i, or npos
+ */
+size_t toml_value_end(std::string_view line, size_t i) {
+    if (i >= line.size()) return std::string_view::npos;
+
+    std::string_view rest = line.substr(i);
+    if (rest.substr(0, 3) == "\"\"\"" || rest.substr(0, 3) == "'''") {
+        return std::string_view::npos;  // multi-line string
+    }
+
+    char c = line[i];
+    if (c == '"') {
+        for (size_t j = i + 1; j < line.size(); ++j) {
+            if (line[j] == '\\') {
+                ++j;
+            } else if (line[j] == '"') {
+                return j + 1;
+            }
+        }
+        return std::string_view::npos;
+    }
+    if (c == '\'') {
+        size_t close = line.find('\'', i + 1);
+        return close == std::string_view::npos ? close : close + 1;
+    }
+    if (c == '[' || c == '{') {
+        size_t depth = 0;
+        for (size_t j = i; j < line.size(); ++j) {
+            char ch = line[j];
+            if (ch == '"' || ch == '\'') {
+                size_t end = toml_value_end(line, j);
+                if (end == std::string_view::npos) return end;
+                j = end - 1;
+            } else if (ch == '#') {
+                return std::string_view::npos;  // comment inside a multi-line array
+            } else if (ch == '[' || ch == '{') {
+                ++depth;
+            } else if ((ch == ']' || ch == '}') && --depth == 0) {
+                return j + 1;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    // Number, boolean or date-time; stop at blanks and comments
+    size_t j = i;
+    while (j < line.size() && std::strchr(" \t\r#", line[j]) == nullptr) ++j;
+    return j;
+}
+
+/// Number of `"""` / `'''` delimiters on a line (odd = a multi-line string opens or closes)
+size_t count_delimiters(std::string_view line, std::string_view delim) {
+    size_t n = 0;
+    for (size_t p = line.find(delim); p != std::string_view::npos; p = line.find(delim, p + 3)) {
+        ++n;
+    }
+    return n;
+}
+
+/**
+ * @brief Inline TOML form of a value (the right-hand side of `key = ...`)
+ *
+ * Produced by Config::to_toml() so the text matches a full rewrite.
+ * Tables and arrays of tables have no single-line form here.
+ */
+std::optional<std::string> toml_inline_value(const Value& value) {
+    if (value.is_object()) {
+        return std::nullopt;
+    }
+    std::string doc = Config(Value{{"v", value}}).to_toml();
+    if (doc.compare(0, 4, "v = ") != 0 || doc.find('\n') != doc.size() - 1) {
+        return std::nullopt;
+    }
+    return doc.substr(4, doc.size() - 5);
+}
+
+// ============================================================================
+// Documents
+// ============================================================================
+
+Value parse_document(bool is_json, const std::string& text, const std::string& path) {
+    if (is_json) {
+        try {
+            return Value::parse(text);
+        } catch (const nlohmann::json::parse_error& e) {
+            throw ConfigParseError(path, e.what());
+        }
+    }
+
+    try {
+        toml::table table = toml::parse(text);
+        return toml_to_json(&table);
+    } catch (const toml::parse_error& e) {
+        std::ostringstream msg;
+        msg << "line " << e.source().begin.line
+            << ", column " << e.source().begin.column
+            << ": " << e.description();
+        throw ConfigParseError(path, msg.str());
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Atomic Writes
+// ============================================================================
+
+void write_file_atomic(const std::string& path,
+                       const std::function<void(std::ostream&)>& write) {
+    // Replace the file a symlink points to, not the link itself, and
+    // create the temporary file beside it so the rename stays within
+    // one filesystem
+    std::error_code resolve_ec;
+    fs::path target = fs::weakly_canonical(fs::path(path), resolve_ec);
+    if (resolve_ec) {
+        target = fs::path(path);
+    }
+    fs::path temp = temp_path_for(target);
+
+    try {
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw ConfigError("Cannot open file for writing: " + temp.string());
+            }
+            write(out);
+            out.flush();
+            if (!out) {
+                throw ConfigError("Failed to write file: " + temp.string());
+            }
+        }
+        sync_file(temp);
+
+        // Keep the owner, group and permissions of the file being
+        // replaced; ownership first, since chown may clear set-id bits
+        copy_owner(temp, target);
+        std::error_code ec;
+        auto status = fs::status(target, ec);
+        if (!ec && fs::exists(status)) {
+            fs::permissions(temp, status.permissions(), ec);
+        }
+
+        fs::rename(temp, target);
+    } catch (const fs::filesystem_error& e) {
+        std::error_code ignored;
+        fs::remove(temp, ignored);
+        throw ConfigError(std::string("Cannot replace file: ") + e.what());
+    } catch (...) {
+        std::error_code ignored;
+        fs::remove(temp, ignored);
+        throw;
+    }
+
+    sync_directory(target.parent_path());
+}
+
+void write_file_atomic(const std::string& path, std::string_view content) {
+    write_file_atomic(path, [content](std::ostream& out) {
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    });
+}
+
+// ============================================================================
+// Value Location
+// ============================================================================
+
+std::optional<TextSpan> find_json_value_span(std::string_view text, const std::string& path) {
+    JsonCursor cur(text);
+
+    for (const auto& seg : split_dot_path(path)) {
+        if (cur.consume('{')) {
+            if (cur.at('}')) return std::nullopt;
+            while (true) {
+                std::string key;
+                if (!cur.at('"') || !cur.read_string(key) || !cur.consume(':')) {
+                    return std::nullopt;
+                }
+                if (key == seg) break;
+                if (!cur.skip_value() || !cur.consume(',')) return std::nullopt;
+            }
+        } else if (cur.consume('[')) {
+            size_t index = 0;
+            if (!is_array_index(seg) ||
+                std::from_chars(seg.data(), seg.data() + seg.size(), index).ec != std::errc{}) {
+                return std::nullopt;
+            }
+            if (cur.at(']')) return std::nullopt;
+            for (size_t i = 0; i < index; ++i) {
+                if (!cur.skip_value() || !cur.consume(',')) return std::nullopt;
+            }
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    cur.skip_ws();
+    size_t begin = cur.pos();
+    if (!cur.skip_value()) return std::nullopt;
+    return TextSpan{begin, cur.pos()};
+}
+
+std::optional<TextSpan> find_toml_value_span(std::string_view text, const std::string& path) {
+    std::vector<std::string> table = split_dot_path(path);
+    if (table.empty()) return std::nullopt;
+    std::string key = std::move(table.back());
+    table.pop_back();
+
+    bool in_table = table.empty();  // top-level keys precede any header
+    std::string_view open_delim;    // non-empty inside a multi-line string
+    std::vector<std::string> header;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        std::string_view line = text.substr(pos, eol - pos);
+        size_t line_start = pos;
+        pos = eol + 1;
+
+        if (!open_delim.empty()) {
+            if (count_delimiters(line, open_delim) % 2 == 1) open_delim = {};
+            continue;
+        }
+
+        size_t i = 0;
+        skip_blanks(line, i);
+
+        if (i < line.size() && line[i] == '[') {
+            // Arrays of tables ([[x]]) are never matched
+            in_table = line.substr(i, 2) != "[[" &&
+                       parse_toml_header(line, i, header) && header == table;
+            continue;
+        }
+
+        if (in_table) {
+            size_t k = i;
+            std::string name;
+            if (parse_toml_key(line, k, name)) {
+                skip_blanks(line, k);
+                if (k < line.size() && line[k] == '=' && name == key) {
+                    ++k;
+                    skip_blanks(line, k);
+                    size_t end = toml_value_end(line, k);
+                    if (end == std::string_view::npos || !rest_is_trivia(line, end)) {
+                        return std::nullopt;
+                    }
+                    return TextSpan{line_start + k, line_start + end};
+                }
+            }
+        }
+
+        for (std::string_view delim : {std::string_view("\"\"\""), std::string_view("'''")}) {
+            if (count_delimiters(line, delim) % 2 == 1) {
+                open_delim = delim;
+                break;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+// ============================================================================
+// File Updates
+// ============================================================================
+
+FileUpdateResult update_config_file(const std::string& path,
+                                    const std::vector<std::pair<std::string, Value>>& assignments) {
+    std::string ext = get_file_extension(path);
+    bool is_json = ext == ".json";
+    if (!is_json && ext != ".toml") {
+        throw ConfigError("Unsupported file format: " + ext + " (expected .json or .toml)");
+    }
+
+    // Load the existing document (a missing file is created)
+    std::string text;
+    Value data = Value::object();
+    bool exists = false;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (in) {
+            std::ostringstream ss;
+            ss << in.rdbuf();
+            text = ss.str();
+            exists = true;
+        }
+    }
+    if (exists) {
+        data = parse_document(is_json, text, path);
+    }
+
+    // Apply to the tree, and patch the text while every value allows it
+    bool patchable = exists;
+    for (const auto& [key, value] : assignments) {
+        set_by_dot(data, key, value, true);
+        if (!patchable) continue;
+
+        auto span = is_json ? find_json_value_span(text, key) : find_toml_value_span(text, key);
+        auto rendered = is_json ? std::optional<std::string>(value.dump()) : toml_inline_value(value);
+        if (!span || !rendered) {
+            patchable = false;
+            continue;
+        }
+        text.replace(span->begin, span->end - span->begin, *rendered);
+    }
+
+    // The scanners are conservative, but only trust a patch that
+    // round-trips to exactly the updated tree
+    if (patchable) {
+        try {
+            patchable = parse_document(is_json, text, path) == data;
+        } catch (const ConfigParseError&) {
+            patchable = false;
+        }
+    }
+
+    if (patchable) {
+        write_file_atomic(path, text);
+        return {true};
+    }
+
+    if (is_json) {
+        write_file_atomic(path, [&data](std::ostream& out) {
+            out << std::setw(2) << data << '\n';
+        });
+    } else {
+        Config cfg(std::move(data));
+        write_file_atomic(path, [&cfg](std::ostream& out) { cfg.to_toml(out); });
+    }
+    return {false};
+}
+
+} // namespace confy
@@ -0,0 +1,74 @@
+/**
+ * @file Intern.cpp
+ * @brief Key interning table implementation
+ */
+
+#include "confy/Intern.hpp"
+
+#include <cstring>
+
+namespace confy {
+
+std::string_view KeyTable::store(std::string_view key) {
+    // Oversized keys get a dedicated block so they don't waste the tail
+    // of the current one.
+    if (key.size() > BLOCK_SIZE / 4) {
+        auto block = std::make_unique<char[]>(key.size());
+        std::memcpy(block.get(), key.data(), key.size());
+        std::string_view stored(block.get(), key.size());
+        blocks_.insert(blocks_.end() - (blocks_.empty() ? 0 : 1), std::move(block));
+        storage_bytes_ += key.size();
+        return stored;
+    }
+
+    if (block_used_ + key.size() > BLOCK_SIZE) {
+        blocks_.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+        block_used_ = 0;
+        storage_bytes_ += BLOCK_SIZE;
+    }
+
+    char* dest = blocks_.back().get() + block_used_;
+    std::memcpy(dest, key.data(), key.size());
+    block_used_ += key.size();
+    return std::string_view(dest, key.size());
+}
+
+InternedKey KeyTable::intern(std::string_view key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        return InternedKey(*it);
+    }
+
+    std::string_view stored = key.empty() ? std::string_view() : store(key);
+    index_.insert(stored);
+    return InternedKey(stored);
+}
+
+InternedKey KeyTable::find(std::string_view key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return InternedKey();
+    }
+    return InternedKey(*it);
+}
+
+size_t KeyTable::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.size();
+}
+
+size_t KeyTable::storage_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return storage_bytes_;
+}
+
+KeyTable& KeyTable::global() {
+    static KeyTable table;
+    return table;
+}
+
+} // namespace confy
@@ -0,0 +1,373 @@
+/**
+ * @file Interpolator.cpp
+ * @brief Lazy ${...} expansion implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/Interpolator.hpp"
+#include "confy/DotPath.hpp"
+#include "confy/Errors.hpp"
+#include "confy/Loader.hpp"
+#include "confy/Parse.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace confy {
+
+namespace {
+
+bool has_reference(const std::string& text) {
+    return text.find("${") != std::string::npos;
+}
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+/**
+ * @brief Append the dot-paths where @p before and @p after differ
+ *
+ * Objects are compared key by key; anything else is compared whole.
+ */
+void diff_trees(const Value& before, const Value& after, std::string& path,
+                std::vector<std::string>& out) {
+    if (!before.is_object() || !after.is_object()) {
+        if (before != after) {
+            out.push_back(path);
+        }
+        return;
+    }
+
+    for (auto it = before.begin(); it != before.end(); ++it) {
+        size_t mark = path.size();
+        if (mark != 0) path += '.';
+        path += it.key();
+        auto other = after.find(it.key());
+        if (other == after.end()) {
+            out.push_back(path);
+        } else {
+            diff_trees(it.value(), *other, path, out);
+        }
+        path.resize(mark);
+    }
+    for (auto it = after.begin(); it != after.end(); ++it) {
+        if (!before.contains(it.key())) {
+            out.push_back(path.empty() ? it.key() : path + '.' + it.key());
+        }
+    }
+}
+
+/// Remove every occurrence of @p value from @p list
+void remove_from(std::vector<std::string>& list, const std::string& value) {
+    list.erase(std::remove(list.begin(), list.end(), value), list.end());
+}
+
+} // anonymous namespace
+
+Interpolator::Interpolator(Config snapshot)
+    : snapshot_(std::move(snapshot)) {}
+
+// =============================================================================
+// Value Access
+// =============================================================================
+
+Value Interpolator::get(const std::string& path) {
+    // RULE D1: KeyError / TypeError exactly as Config::get()
+    LookupResult found = try_get_by_dot(std::as_const(snapshot_).data(), path);
+    found.throw_if_error(path);
+    return expand_tree(path, *found.value);
+}
+
+std::optional<Value> Interpolator::get_optional(const std::string& path) {
+    LookupResult found = try_get_by_dot(std::as_const(snapshot_).data(), path);
+    if (found.status == LookupStatus::TypeMismatch) {
+        // RULE D2: TypeError still propagates for traversal into non-object
+        found.throw_if_error(path);
+    }
+    if (!found.found()) {
+        return std::nullopt;
+    }
+    return expand_tree(path, *found.value);
+}
+
+Value Interpolator::resolve_all() {
+    return expand_tree("", std::as_const(snapshot_).data());
+}
+
+// =============================================================================
+// Expansion
+// =============================================================================
+
+Value Interpolator::expand_tree(const std::string& path, const Value& value) {
+    if (value.is_string()) {
+        const auto& text = value.get_ref<const std::string&>();
+        return has_reference(text) ? expand_string(path, text) : value;
+    }
+    if (!value.is_structured()) {
+        return value;
+    }
+
+    Value result = value;
+    std::string buffer = path;
+    expand_in_place(result, buffer);
+    return result;
+}
+
+void Interpolator::expand_in_place(Value& node, std::string& path) {
+    if (node.is_string()) {
+        if (has_reference(node.get_ref<const std::string&>())) {
+            node = expand_string(path, node.get_ref<const std::string&>());
+        }
+        return;
+    }
+
+    size_t mark = path.size();
+    if (node.is_object()) {
+        for (auto it = node.begin(); it != node.end(); ++it) {
+            if (mark != 0) path += '.';
+            path += it.key();
+            expand_in_place(it.value(), path);
+            path.resize(mark);
+        }
+    } else if (node.is_array()) {
+        for (size_t i = 0; i < node.size(); ++i) {
+            if (mark != 0) path += '.';
+            path += std::to_string(i);
+            expand_in_place(node[i], path);
+            path.resize(mark);
+        }
+    }
+}
+
+const Value& Interpolator::expand_string(const std::string& path, const std::string& text) {
+    auto cached = cache_.find(path);
+    if (cached != cache_.end()) {
+        return cached->second.value;
+    }
+
+    auto active = std::find(expanding_.begin(), expanding_.end(), path);
+    if (active != expanding_.end()) {
+        std::string chain;
+        for (auto it = active; it != expanding_.end(); ++it) {
+            chain += *it + " -> ";
+        }
+        throw InterpolationError(path, "reference cycle " + chain + path);
+    }
+
+    // Pop on every exit, including a failed nested expansion
+    struct Frame {
+        std::vector<std::string>& stack;
+        ~Frame() { stack.pop_back(); }
+    };
+    expanding_.push_back(path);
+    Frame frame{expanding_};
+
+    Node node;
+    node.value = expand_text(path, text, node);
+
+    // Record the edges of the dependency graph
+    for (auto* list : {&node.refs, &node.env}) {
+        std::sort(list->begin(), list->end());
+        list->erase(std::unique(list->begin(), list->end()), list->end());
+    }
+    for (const auto& ref : node.refs) {
+        dependents_[ref].push_back(path);
+    }
+    for (const auto& name : node.env) {
+        env_[name].second.push_back(path);
+    }
+    return cache_.emplace(path, std::move(node)).first->second.value;
+}
+
+Value Interpolator::expand_text(const std::string& path, const std::string& text, Node& node) {
+    std::string out;
+    out.reserve(text.size());
+    size_t references = 0;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t dollar = text.find('$', pos);
+        if (dollar == std::string::npos) {
+            out.append(text, pos, std::string::npos);
+            break;
+        }
+        out.append(text, pos, dollar - pos);
+
+        if (text.compare(dollar, 3, "$${") == 0) {
+            out += "${";
+            pos = dollar + 3;
+            continue;
+        }
+        if (text.compare(dollar, 2, "${") != 0) {
+            out += '$';
+            pos = dollar + 1;
+            continue;
+        }
+
+        size_t close = text.find('}', dollar + 2);
+        if (close == std::string::npos) {
+            throw InterpolationError(path, "unterminated reference in \"" + text + "\"");
+        }
+        std::string ref = text.substr(dollar + 2, close - dollar - 2);
+        if (ref.empty()) {
+            throw InterpolationError(path, "empty reference ${}");
+        }
+
+        bool is_env = false;
+        Value value = lookup(path, ref, node, is_env);
+
+        if (dollar == 0 && close + 1 == text.size()) {
+            // The whole string is one reference: keep the referenced type
+            return is_env ? parse_value(value.get_ref<const std::string&>()) : value;
+        }
+        if (value.is_string()) {
+            out += value.get_ref<const std::string&>();
+        } else {
+            out += value.dump();
+        }
+        ++references;
+        pos = close + 1;
+    }
+
+    // Spliced text is typed like an env value; escapes alone stay a string
+    return references > 0 ? parse_value(out) : Value(std::move(out));
+}
+
+Value Interpolator::lookup(const std::string& path, const std::string& ref,
+                           Node& node, bool& is_env) {
+    if (starts_with(ref, "env:")) {
+        is_env = true;
+        std::string name = ref.substr(4);
+        std::optional<std::string> value = get_env_var(name);
+        env_[name].first = value;
+        node.env.push_back(name);
+        if (!value) {
+            throw InterpolationError(path, "environment variable '" + name + "' is not set");
+        }
+        return Value(std::move(*value));
+    }
+
+    node.refs.push_back(ref);
+    LookupResult found = try_get_by_dot(std::as_const(snapshot_).data(), ref);
+    if (!found.found()) {
+        throw InterpolationError(path, "unresolved reference ${" + ref + "}: " + found.message(ref));
+    }
+    return expand_tree(ref, *found.value);
+}
+
+// =============================================================================
+// Reload
+// =============================================================================
+
+size_t Interpolator::update(Config next) {
+    std::vector<std::string> work;
+    size_t before = cache_.size();
+
+    // Referenced environment variables whose value changed
+    std::vector<std::string> stale;
+    for (const auto& [name, entry] : env_) {
+        if (get_env_var(name) != entry.first) {
+            stale.push_back(name);
+        }
+    }
+    for (const auto& name : stale) {
+        auto it = env_.find(name);
+        if (it == env_.end()) {
+            continue;  // Emptied by an earlier drop()
+        }
+        std::vector<std::string> users = std::move(it->second.second);
+        env_.erase(it);
+        for (const auto& user : users) {
+            auto cached = cache_.find(user);
+            if (cached != cache_.end()) {
+                drop(cached, work);
+            }
+        }
+    }
+
+    // Keys that differ between the snapshots
+    if (!next.shares_data_with(snapshot_)) {
+        std::string path;
+        diff_trees(std::as_const(snapshot_).data(), std::as_const(next).data(), path, work);
+    }
+    snapshot_ = std::move(next);
+
+    invalidate(std::move(work));
+    return before - cache_.size();
+}
+
+void Interpolator::invalidate(std::vector<std::string> work) {
+    while (!work.empty()) {
+        std::string changed = std::move(work.back());
+        work.pop_back();
+        const std::string below = changed + '.';
+
+        // Cached strings at or below the changed path
+        auto self = cache_.find(changed);
+        if (self != cache_.end()) {
+            drop(self, work);
+        }
+        for (auto it = cache_.lower_bound(below);
+             it != cache_.end() && starts_with(it->first, below);) {
+            auto next = std::next(it);
+            drop(it, work);
+            it = next;
+        }
+
+        // Strings referring to it, to a section holding it, or to
+        // something below it
+        std::vector<std::string> users;
+        auto take = [&](std::map<std::string, std::vector<std::string>>::iterator it) {
+            users.insert(users.end(), it->second.begin(), it->second.end());
+            return dependents_.erase(it);
+        };
+        for (std::string section = changed;;) {
+            auto it = dependents_.find(section);
+            if (it != dependents_.end()) {
+                take(it);
+            }
+            size_t dot = section.rfind('.');
+            if (dot == std::string::npos) break;
+            section.resize(dot);
+        }
+        for (auto it = dependents_.lower_bound(below);
+             it != dependents_.end() && starts_with(it->first, below);) {
+            it = take(it);
+        }
+
+        for (const auto& user : users) {
+            auto cached = cache_.find(user);
+            if (cached != cache_.end()) {
+                drop(cached, work);
+            }
+        }
+    }
+}
+
+void Interpolator::drop(std::map<std::string, Node>::iterator it,
+                        std::vector<std::string>& work) {
+    const std::string& path = it->first;
+    for (const auto& ref : it->second.refs) {
+        auto edge = dependents_.find(ref);
+        if (edge != dependents_.end()) {
+            remove_from(edge->second, path);
+            if (edge->second.empty()) dependents_.erase(edge);
+        }
+    }
+    for (const auto& name : it->second.env) {
+        auto edge = env_.find(name);
+        if (edge != env_.end()) {
+            remove_from(edge->second.second, path);
+            if (edge->second.second.empty()) env_.erase(edge);
+        }
+    }
+
+    // Whatever referred to this string is stale too
+    work.push_back(path);
+    cache_.erase(it);
+}
+
+} // namespace confy
@@ -0,0 +1,200 @@
+/**
+ * @file KeySet.cpp
+ * @brief Compact hashed dot-path set implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/KeySet.hpp"
+
+namespace confy {
+
+namespace {
+
+/// FNV-1a, 64-bit
+uint64_t hash_path(std::string_view path) {
+    uint64_t h = 14695981039346656037ull;
+    for (char c : path) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/// splitmix64 finalizer, spreads hashes before they are summed
+uint64_t mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+/**
+ * @brief Call fn(path) for every dot-path below @p node, parents first
+ * @return false as soon as fn does
+ */
+template <typename Fn>
+bool visit_paths(const Value& node, std::string& path, Fn& fn) {
+    for (auto it = node.begin(); it != node.end(); ++it) {
+        size_t mark = path.size();
+        if (mark != 0) path += '.';
+        path += it.key();
+
+        bool ok = fn(std::string_view(path)) &&
+                  (!it.value().is_object() || visit_paths(it.value(), path, fn));
+        path.resize(mark);
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Visit the paths of @p defaults with @p file sections laid over it
+ */
+template <typename Fn>
+bool visit_layers(const Value& defaults, const Value& file, Fn fn) {
+    std::string path;
+    bool file_is_object = file.is_object();
+
+    if (defaults.is_object()) {
+        for (auto it = defaults.begin(); it != defaults.end(); ++it) {
+            if (file_is_object && file.contains(it.key())) {
+                continue;  // Replaced by the file section
+            }
+            path = it.key();
+            if (!fn(std::string_view(path)) ||
+                (it.value().is_object() && !visit_paths(it.value(), path, fn))) {
+                return false;
+            }
+        }
+    }
+
+    if (file_is_object) {
+        path.clear();
+        return visit_paths(file, path, fn);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+KeySet::KeySet(const Value& data) {
+    visit_layers(data, Value(), [this](std::string_view path) {
+        insert(path);
+        return true;
+    });
+}
+
+KeySet::KeySet(std::initializer_list<std::string_view> paths) {
+    for (std::string_view path : paths) {
+        insert(path);
+    }
+}
+
+KeySet KeySet::from_layers(const Value& defaults, const Value& file) {
+    KeySet keys;
+    visit_layers(defaults, file, [&keys](std::string_view path) {
+        keys.insert(path);
+        return true;
+    });
+    return keys;
+}
+
+bool KeySet::same_as_layers(const Value& defaults, const Value& file) const {
+    // Every visited path must be a key, and every key must be visited
+    std::vector<char> seen(slots_.size(), 0);
+    size_t distinct = 0;
+    bool all_known = visit_layers(defaults, file, [&](std::string_view path) {
+        if (slots_.empty()) {
+            return false;
+        }
+        size_t i = find_slot(path, hash_path(path));
+        if (!(slots_[i].flags & KEY)) {
+            return false;
+        }
+        if (!seen[i]) {
+            seen[i] = 1;
+            ++distinct;
+        }
+        return true;
+    });
+    return all_known && distinct == size_;
+}
+
+void KeySet::insert(std::string_view path) {
+    mark(path, KEY);
+
+    // Sections answer contains_prefix() for paths that are not keys
+    // themselves, e.g. "a" for a literal "a.b" key
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (path[i] == '.') {
+            mark(path.substr(0, i), SECTION);
+        }
+    }
+}
+
+bool KeySet::contains(std::string_view path) const {
+    return !slots_.empty() && (slots_[find_slot(path, hash_path(path))].flags & KEY);
+}
+
+bool KeySet::contains_prefix(std::string_view prefix) const {
+    return !slots_.empty() && slots_[find_slot(prefix, hash_path(prefix))].flags != 0;
+}
+
+size_t KeySet::find_slot(std::string_view path, uint64_t hash) const {
+    // Linear probing; the characters are compared only on a full hash match
+    size_t mask = slots_.size() - 1;
+    for (size_t i = static_cast<size_t>(mix(hash)) & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots_[i];
+        if (slot.flags == 0) {
+            return i;
+        }
+        if (slot.hash == hash &&
+            std::string_view(chars_.data() + slot.offset, slot.length) == path) {
+            return i;
+        }
+    }
+}
+
+void KeySet::mark(std::string_view path, uint8_t flag) {
+    // Keep the load factor at or below 0.7
+    if ((used_ + 1) * 10 > slots_.size() * 7) {
+        grow();
+    }
+
+    uint64_t hash = hash_path(path);
+    Slot& slot = slots_[find_slot(path, hash)];
+    if (slot.flags == 0) {
+        slot = {hash, static_cast<uint32_t>(chars_.size()),
+                static_cast<uint32_t>(path.size()), 0};
+        chars_.append(path);
+        ++used_;
+    }
+    if ((flag & KEY) && !(slot.flags & KEY)) {
+        ++size_;
+        fingerprint_ += mix(hash ^ 0x9e3779b97f4a7c15ull);
+    }
+    slot.flags |= flag;
+}
+
+void KeySet::grow() {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(old.empty() ? 16 : old.size() * 2, Slot{0, 0, 0, 0});
+
+    size_t mask = slots_.size() - 1;
+    for (const Slot& slot : old) {
+        if (slot.flags == 0) {
+            continue;
+        }
+        size_t i = static_cast<size_t>(mix(slot.hash)) & mask;
+        while (slots_[i].flags != 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = slot;
+    }
+}
+
+} // namespace confy
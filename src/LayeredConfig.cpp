@@ -0,0 +1,407 @@
+/**
+ * @file LayeredConfig.cpp
+ * @brief Lazy layered configuration implementation
+ *
+ * Loads each source into its own layer (shared with Config::load()) and
+ * resolves dot-paths across layers without materializing the merged tree.
+ *
+ * Implements:
+ * - RULE P1: Precedence ordering (layer order)
+ * - RULE P2-P3: Merge semantics, applied per requested subtree
+ * - RULE D1-D6: Dot-path semantics on the effective tree
+ * - RULE M1-M3: Mandatory key validation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/LayeredConfig.hpp"
+#include "confy/DotPath.hpp"
+#include "confy/Merge.hpp"
+#include "confy/Loader.hpp"
+#include "confy/EnvMapper.hpp"
+#include "confy/Schema.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace confy {
+
+namespace {
+
+/**
+ * @brief Reduce the values present at one node to the contributing sources
+ *
+ * Candidates are ordered lowest precedence first. Mirrors deep_merge():
+ * the highest non-null candidate wins; if it is an object, it merges with
+ * the objects directly below it, down to the first non-null non-object.
+ *
+ * @param candidates Values present at this node, lowest precedence first
+ * @param out Receives the contributing sources, lowest precedence first
+ */
+void collapse(const std::vector<const Value*>& candidates,
+              std::vector<const Value*>& out) {
+    out.clear();
+
+    // Highest non-null candidate (null never overrides)
+    size_t top = candidates.size();
+    while (top > 0 && candidates[top - 1]->is_null()) {
+        --top;
+    }
+    if (top == 0) {
+        // Only nulls present: the effective value is null
+        out.push_back(candidates.back());
+        return;
+    }
+
+    const Value* winner = candidates[top - 1];
+    if (!winner->is_object()) {
+        // RULE P3: Non-object replaces everything below
+        out.push_back(winner);
+        return;
+    }
+
+    // RULE P2: Objects merge with the run of objects below them
+    size_t low = top - 1;
+    while (low > 0) {
+        const Value* below = candidates[low - 1];
+        if (!below->is_null() && !below->is_object()) {
+            break;
+        }
+        --low;
+    }
+    for (size_t i = low; i < top; ++i) {
+        if (candidates[i]->is_object()) {
+            out.push_back(candidates[i]);
+        }
+    }
+}
+
+/**
+ * @brief File content for provenance line lookups, empty if unreadable
+ */
+std::string read_text(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Static Factories
+// =============================================================================
+
+LayeredConfig LayeredConfig::from_sources(const LoadOptions& opts,
+                                          Provenance* provenance) {
+    LayeredConfig result;
+
+    // -------------------------------------------------------------------------
+    // Layer 1: Defaults (lowest precedence)
+    // -------------------------------------------------------------------------
+    Value defaults = opts.defaults;
+    if (!defaults.is_object()) {
+        defaults = Value::object();
+    }
+    if (opts.schema) {
+        // Schema defaults sit beneath the caller's defaults
+        defaults = deep_merge(opts.schema->defaults(), defaults);
+    }
+
+    // -------------------------------------------------------------------------
+    // Layer 2: Config file
+    // -------------------------------------------------------------------------
+    Value file_data = Value::object();
+    if (!opts.file_path.empty()) {
+        // load_config_file handles RULE F6-F8:
+        // - Empty path returns empty object
+        // - Missing file throws FileNotFoundError
+        // - Auto-detects JSON/TOML by extension
+        // - TOML key promotion based on defaults
+        file_data = load_config_file(opts.file_path, defaults);
+    }
+
+    // -------------------------------------------------------------------------
+    // .env file (populates environment, does NOT override existing)
+    // -------------------------------------------------------------------------
+    std::string env_path;
+    if (opts.load_dotenv_file) {
+        // RULE P4: .env does not override existing environment variables
+        env_path = opts.dotenv_path;
+        if (env_path.empty()) {
+            // Search for .env in current directory
+            env_path = ".env";
+        }
+        // load_dotenv_file handles the "don't override" semantics
+        load_dotenv_file(env_path, false /* override_existing */);
+    }
+
+    // -------------------------------------------------------------------------
+    // Layer 3: Environment variables
+    // -------------------------------------------------------------------------
+    Value env_data;
+    if (opts.prefix.has_value()) {
+        // load_env_vars implements RULE E1-E7:
+        // - Prefix filtering (E1-E3)
+        // - Underscore transformation (E4)
+        // - Remapping against base structure (E5-E7)
+        // - Value parsing
+        //
+        // The remap base is the file's top-level sections laid over the
+        // defaults, which is what the merged defaults+file tree reduces to
+        // once file sections replace their counterparts, so no merge is
+        // needed here. A non-object file replaces the defaults outright.
+        const Value& base = (file_data.is_object() || file_data.is_null())
+            ? defaults : file_data;
+        env_data = load_env_vars(
+            opts.prefix.value(),    // Prefix for filtering
+            base,                    // Base structure for remapping
+            base,                    // Defaults (for key lookup)
+            file_data,               // File data (for key lookup)
+            false                    // Not from dotenv (conservative mode)
+        );
+    }
+
+    // -------------------------------------------------------------------------
+    // Layer 4: Overrides (highest precedence)
+    // -------------------------------------------------------------------------
+    Value overrides_obj;
+    if (!opts.overrides.empty()) {
+        overrides_obj = Config::overrides_to_value(opts.overrides);
+    }
+
+    // -------------------------------------------------------------------------
+    // Provenance: what each loader knows about its layer's values
+    // -------------------------------------------------------------------------
+    if (provenance != nullptr) {
+        provenance->add_layer(Source::Defaults);
+        if (!opts.file_path.empty()) {
+            provenance->add_layer(Source::File, opts.file_path, read_text(opts.file_path));
+        }
+        if (opts.prefix.has_value()) {
+            uint8_t layer = provenance->add_layer(Source::Env);
+
+            // A variable still holding its .env value was set from .env
+            DotenvResult dotenv;
+            if (!env_path.empty()) {
+                dotenv = parse_dotenv_file(env_path);
+            }
+            std::unordered_map<std::string, std::string> from_dotenv(
+                dotenv.entries.begin(), dotenv.entries.end());
+
+            const Value& base = (file_data.is_object() || file_data.is_null())
+                ? defaults : file_data;
+            for (auto& [path, name] : env_var_origins(opts.prefix, base, file_data, false)) {
+                Origin origin;
+                origin.source = Source::Env;
+                auto entry = from_dotenv.find(name);
+                if (entry != from_dotenv.end() && get_env_var(name) == entry->second) {
+                    origin.source = Source::Dotenv;
+                    origin.file = dotenv.loaded_path;
+                }
+                origin.name = std::move(name);
+                provenance->set_origin(layer, std::move(path), std::move(origin));
+            }
+        }
+        if (!opts.overrides.empty()) {
+            uint8_t layer = provenance->add_layer(Source::Override);
+            for (const auto& entry : opts.overrides) {
+                Origin origin;
+                origin.source = Source::Override;
+                origin.name = entry.first;
+                provenance->set_origin(layer, entry.first, std::move(origin));
+            }
+        }
+    }
+
+    // Layers are stored as-is: a non-object file (e.g. a top-level JSON
+    // array) replaces the lower layers exactly as deep_merge would.
+    result.layers_.push_back({"defaults", std::move(defaults)});
+    if (!opts.file_path.empty()) {
+        result.layers_.push_back({"file", std::move(file_data)});
+    }
+    if (opts.prefix.has_value()) {
+        result.layers_.push_back({"env", std::move(env_data)});
+    }
+    if (!opts.overrides.empty()) {
+        result.layers_.push_back({"overrides", std::move(overrides_obj)});
+    }
+
+    return result;
+}
+
+LayeredConfig LayeredConfig::load(const LoadOptions& opts) {
+    LayeredConfig result = from_sources(opts);
+    result.validate_mandatory(opts.mandatory);
+    if (opts.schema) {
+        // Schema rules span the whole tree, so check the merged view
+        opts.schema->check(result.materialize());
+    }
+    return result;
+}
+
+// =============================================================================
+// Layers
+// =============================================================================
+
+void LayeredConfig::add_layer(Value data, std::string name) {
+    if (!data.is_object()) {
+        throw TypeError("", "object", type_name(data));
+    }
+    layers_.push_back({std::move(name), std::move(data)});
+}
+
+// =============================================================================
+// Resolution
+// =============================================================================
+
+LookupStatus LayeredConfig::resolve(const std::string& path, Resolved& out,
+                                    std::string& missing) const {
+    static const Value empty_root = Value::object();
+
+    std::vector<const Value*> candidates;
+    candidates.reserve(layers_.size());
+    for (const auto& layer : layers_) {
+        candidates.push_back(&layer.data);
+    }
+    if (candidates.empty()) {
+        candidates.push_back(&empty_root);
+    }
+    collapse(candidates, out.sources);
+
+    for (const auto& seg : split_dot_path(path)) {
+        const Value* single = out.sources.size() == 1 ? out.sources[0] : nullptr;
+
+        if (single != nullptr && !single->is_object()) {
+            if (!single->is_array()) {
+                return LookupStatus::TypeMismatch;  // out.sources holds the scalar
+            }
+
+            // Arrays are never merged across layers: index the winner
+            if (!is_array_index(seg)) {
+                missing = seg + " (not a valid array index)";
+                return LookupStatus::Missing;
+            }
+            size_t idx = parse_array_index(seg);
+            if (idx >= single->size()) {
+                missing = seg + " (index out of range)";
+                return LookupStatus::Missing;
+            }
+            out.sources[0] = &(*single)[idx];
+            continue;
+        }
+
+        // Probe every contributing object for this key
+        candidates.clear();
+        for (const Value* source : out.sources) {
+            auto it = source->find(seg);
+            if (it != source->end()) {
+                candidates.push_back(&*it);
+            }
+        }
+        if (candidates.empty()) {
+            missing = seg;
+            return LookupStatus::Missing;
+        }
+        collapse(candidates, out.sources);
+    }
+
+    return LookupStatus::Found;
+}
+
+Value LayeredConfig::merge_sources(const Resolved& node) {
+    Value result = *node.sources[0];
+    for (size_t i = 1; i < node.sources.size(); ++i) {
+        result = deep_merge(result, *node.sources[i]);
+    }
+    return result;
+}
+
+// =============================================================================
+// Value Access
+// =============================================================================
+
+Value LayeredConfig::get(const std::string& path) const {
+    // RULE D1: Strict get throws KeyError if not found
+    Resolved node;
+    std::string missing;
+    LookupStatus status = resolve(path, node, missing);
+    if (status == LookupStatus::Missing) {
+        throw KeyError(path, missing);
+    }
+    if (status == LookupStatus::TypeMismatch) {
+        throw TypeError(path, "object or array", type_name(*node.sources[0]));
+    }
+    return merge_sources(node);
+}
+
+std::optional<Value> LayeredConfig::get_optional(const std::string& path) const {
+    // RULE D2: TypeError still propagates for traversal into non-object
+    Resolved node;
+    std::string missing;
+    LookupStatus status = resolve(path, node, missing);
+    if (status == LookupStatus::TypeMismatch) {
+        throw TypeError(path, "object or array", type_name(*node.sources[0]));
+    }
+    if (status == LookupStatus::Missing) {
+        return std::nullopt;
+    }
+    return merge_sources(node);
+}
+
+bool LayeredConfig::contains(const std::string& path) const {
+    // RULE D5-D6: contains semantics
+    Resolved node;
+    std::string missing;
+    LookupStatus status = resolve(path, node, missing);
+    if (status == LookupStatus::TypeMismatch) {
+        throw TypeError(path, "object or array", type_name(*node.sources[0]));
+    }
+    return status == LookupStatus::Found;
+}
+
+Value LayeredConfig::materialize() const {
+    if (layers_.empty()) {
+        return Value::object();
+    }
+
+    Value merged = layers_[0].data;
+    for (size_t i = 1; i < layers_.size(); ++i) {
+        merged = deep_merge(merged, layers_[i].data);
+    }
+    return merged;
+}
+
+Value LayeredConfig::materialize(Provenance& provenance) const {
+    // Starting from an empty object attributes every leaf of the first
+    // layer as well
+    Value merged = Value::object();
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        merged = deep_merge(merged, layers_[i].data, provenance, static_cast<uint8_t>(i));
+    }
+    return merged;
+}
+
+// =============================================================================
+// Mandatory Validation
+// =============================================================================
+
+void LayeredConfig::validate_mandatory(const std::vector<std::string>& mandatory) const {
+    // RULE M1-M2: Check all mandatory keys, collect ALL missing
+    std::vector<std::string> missing;
+
+    Resolved node;
+    std::string segment;
+    for (const auto& key : mandatory) {
+        // RULE M3: Path into non-container counts as missing
+        if (resolve(key, node, segment) != LookupStatus::Found) {
+            missing.push_back(key);
+        }
+    }
+
+    if (!missing.empty()) {
+        throw MissingMandatoryConfig(missing);
+    }
+}
+
+} // namespace confy
@@ -24,12 +24,19 @@
 #include <filesystem>
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
 #include <cstdlib>
+#include <mutex>
 #include <set>
+#include <string_view>
+#include <unordered_map>
 
 #ifdef _WIN32
     #include <windows.h>
 #else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
     #include <unistd.h>
 #endif
 
@@ -53,58 +60,6 @@ std::string to_lower(const std::string& s) {
     return result;
 }
 
-/**
- * @brief Trim whitespace from both ends of string.
- */
-std::string trim(const std::string& s) {
-    auto start = s.find_first_not_of(" \t\r\n");
-    if (start == std::string::npos) return "";
-    auto end = s.find_last_not_of(" \t\r\n");
-    return s.substr(start, end - start + 1);
-}
-
-/**
- * @brief Remove quotes from a quoted string value.
- */
-std::string unquote(const std::string& s) {
-    if (s.length() < 2) return s;
-
-    char first = s.front();
-    char last = s.back();
-
-    // Handle single quotes
-    if (first == '\'' && last == '\'') {
-        return s.substr(1, s.length() - 2);
-    }
-
-    // Handle double quotes with escape processing
-    if (first == '"' && last == '"') {
-        std::string content = s.substr(1, s.length() - 2);
-        std::string result;
-        result.reserve(content.length());
-
-        for (size_t i = 0; i < content.length(); ++i) {
-            if (content[i] == '\\' && i + 1 < content.length()) {
-                char next = content[i + 1];
-                switch (next) {
-                    case 'n': result += '\n'; ++i; break;
-                    case 'r': result += '\r'; ++i; break;
-                    case 't': result += '\t'; ++i; break;
-                    case '\\': result += '\\'; ++i; break;
-                    case '"': result += '"'; ++i; break;
-                    case '\'': result += '\''; ++i; break;
-                    default: result += content[i]; break;
-                }
-            } else {
-                result += content[i];
-            }
-        }
-        return result;
-    }
-
-    return s;
-}
-
 /**
  * @brief Check if file exists.
  */
@@ -127,6 +82,382 @@ std::string read_file(const std::string& path) {
     return ss.str();
 }
 
+/**
+ * @brief Read-only view of a whole file, memory-mapped only when large.
+ *
+ * Files below MMAP_THRESHOLD are read into a buffer with read(), so a
+ * file truncated or rewritten while it is scanned (an editor saving, a
+ * deploy script, a ConfigWatcher reload racing the write) yields short
+ * or mixed text, never a fault. A mapping would raise SIGBUS on access
+ * past the new end of file; only files too large to copy cheaply, which
+ * .env files in practice never are, take that risk.
+ *
+ * Falls back to reading through a stream when the file cannot be opened
+ * or mapped (and always on Windows). ok() is false if the file cannot be
+ * opened.
+ */
+class MappedText {
+public:
+    /// Smallest file that is mapped instead of copied
+    static constexpr size_t MMAP_THRESHOLD = 4 * 1024 * 1024;
+
+    explicit MappedText(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            size_t size = static_cast<size_t>(st.st_size);
+            if (size >= MMAP_THRESHOLD) {
+                void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr != MAP_FAILED) {
+                    mapped_ = addr;
+                    view_ = std::string_view(static_cast<const char*>(addr), size);
+                    ok_ = true;
+                }
+            } else {
+                ok_ = read_all(fd, size);
+            }
+        }
+        ::close(fd);
+        if (ok_) {
+            return;
+        }
+#endif
+        // Unmappable file
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return;
+        }
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        owned_ = ss.str();
+        view_ = owned_;
+        ok_ = true;
+    }
+
+    ~MappedText() {
+#ifndef _WIN32
+        if (mapped_ != nullptr) {
+            ::munmap(mapped_, view_.size());
+        }
+#endif
+    }
+
+    MappedText(const MappedText&) = delete;
+    MappedText& operator=(const MappedText&) = delete;
+
+    bool ok() const { return ok_; }
+    std::string_view view() const { return view_; }
+
+private:
+#ifndef _WIN32
+    /// Read to end of file, expecting @p size bytes (one read() unless it changed)
+    bool read_all(int fd, size_t size) {
+        owned_.resize(size + 1);  // one spare byte detects growth
+        size_t used = 0;
+        while (true) {
+            if (used == owned_.size()) {
+                owned_.resize(owned_.size() * 2);
+            }
+            ssize_t n = ::read(fd, owned_.data() + used, owned_.size() - used);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                owned_.clear();
+                return false;
+            }
+            if (n == 0) break;
+            used += static_cast<size_t>(n);
+        }
+        owned_.resize(used);
+        view_ = owned_;
+        return true;
+    }
+#endif
+
+    void* mapped_ = nullptr;
+    std::string owned_;
+    std::string_view view_;
+    bool ok_ = false;
+};
+
+/**
+ * @brief Single-pass .env scanner over a text buffer.
+ *
+ * Mirrors python-dotenv's parser: each call to next() yields one
+ * binding with its key and raw value as views into the buffer. Quoted
+ * values may span lines; a line that does not parse is skipped.
+ */
+class DotenvScanner {
+public:
+    struct Binding {
+        std::string_view key;
+        std::string_view value;   ///< Between the quotes, if quoted
+        char quote = 0;           ///< '\'', '"' or 0
+        bool has_value = false;   ///< false for a bare KEY line
+        bool escaped = false;     ///< value contains a backslash
+    };
+
+    explicit DotenvScanner(std::string_view text) : text_(text) {}
+
+    /// Next well-formed binding, or false at the end of the buffer
+    bool next(Binding& out) {
+        while (true) {
+            // Blank lines and leading whitespace
+            while (pos_ < text_.size() && is_space(text_[pos_])) ++pos_;
+            if (pos_ >= text_.size()) {
+                return false;
+            }
+            if (text_[pos_] == '#') {
+                skip_line();
+                continue;
+            }
+            if (parse_binding(out)) {
+                return true;
+            }
+            skip_line();
+        }
+    }
+
+private:
+    static bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+    static bool is_blank(char c) {
+        return c == ' ' || c == '\t' || c == '\v' || c == '\f';
+    }
+
+    char peek() const { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+    void skip_blanks() {
+        while (pos_ < text_.size() && is_blank(text_[pos_])) ++pos_;
+    }
+
+    void skip_line() {
+        while (pos_ < text_.size() && text_[pos_] != '\n' && text_[pos_] != '\r') ++pos_;
+    }
+
+    /// Optional trailing blanks and comment, then the end of the line
+    bool end_of_line() {
+        skip_blanks();
+        if (peek() == '#') {
+            skip_line();
+        }
+        if (pos_ >= text_.size()) return true;
+        if (text_[pos_] == '\r') {
+            ++pos_;
+            if (peek() == '\n') ++pos_;
+            return true;
+        }
+        if (text_[pos_] == '\n') {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Body of a quoted string starting after the opening quote. As with
+     * python-dotenv's pattern, the string ends at the first quote without
+     * a backslash before it, or failing that at the last escaped one.
+     */
+    bool quoted(char quote, std::string_view& body, bool& escaped) {
+        size_t start = pos_;
+        size_t last_escaped = std::string_view::npos;
+        while (pos_ < text_.size()) {
+            char c = text_[pos_];
+            if (c == '\\') {
+                escaped = true;
+                if (pos_ + 1 < text_.size() && text_[pos_ + 1] == quote) {
+                    last_escaped = pos_ + 1;
+                    pos_ += 2;
+                } else {
+                    ++pos_;
+                }
+                continue;
+            }
+            if (c == quote) {
+                body = text_.substr(start, pos_ - start);
+                ++pos_;
+                return true;
+            }
+            ++pos_;
+        }
+        if (last_escaped != std::string_view::npos) {
+            body = text_.substr(start, last_escaped - start);
+            pos_ = last_escaped + 1;
+            return true;
+        }
+        return false;  // Unterminated
+    }
+
+    bool parse_binding(Binding& out) {
+        out = Binding{};
+        size_t line_start = pos_;
+
+        // "export" followed by blanks; case-insensitive
+        constexpr std::string_view kExport = "export";
+        if (text_.size() - pos_ > kExport.size() && is_blank(text_[pos_ + kExport.size()])) {
+            bool match = true;
+            for (size_t i = 0; i < kExport.size(); ++i) {
+                if (std::tolower(static_cast<unsigned char>(text_[pos_ + i])) != kExport[i]) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) {
+                pos_ += kExport.size();
+                skip_blanks();
+            }
+        }
+
+        // Key: 'quoted' or a run without '=', '#' and whitespace
+        if (peek() == '\'') {
+            ++pos_;
+            size_t start = pos_;
+            while (pos_ < text_.size() && text_[pos_] != '\'') ++pos_;
+            if (pos_ >= text_.size()) {
+                pos_ = line_start;
+                return false;
+            }
+            out.key = text_.substr(start, pos_ - start);
+            ++pos_;
+        } else {
+            size_t start = pos_;
+            while (pos_ < text_.size() && text_[pos_] != '=' && text_[pos_] != '#' &&
+                   !is_space(text_[pos_])) {
+                ++pos_;
+            }
+            out.key = text_.substr(start, pos_ - start);
+        }
+        if (out.key.empty()) {
+            return false;
+        }
+
+        skip_blanks();
+        if (peek() != '=') {
+            // Bare KEY: no value
+            return end_of_line();
+        }
+        ++pos_;
+        skip_blanks();
+        out.has_value = true;
+
+        char c = peek();
+        if (c == '\'' || c == '"') {
+            ++pos_;
+            out.quote = c;
+            if (!quoted(c, out.value, out.escaped)) {
+                pos_ = line_start;
+                return false;
+            }
+            return end_of_line();
+        }
+
+        // Unquoted: rest of the line, cut at whitespace + '#', right-trimmed
+        size_t start = pos_;
+        skip_line();
+        std::string_view rest = text_.substr(start, pos_ - start);
+        for (size_t i = 1; i < rest.size(); ++i) {
+            if (rest[i] == '#' && is_blank(rest[i - 1])) {
+                rest = rest.substr(0, i);
+                break;
+            }
+        }
+        while (!rest.empty() && is_space(rest.back())) rest.remove_suffix(1);
+        out.value = rest;
+        return end_of_line();
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+/**
+ * @brief Decode the escapes python-dotenv recognizes in a quoted value.
+ */
+std::string decode_dotenv_escapes(std::string_view body, char quote) {
+    std::string out;
+    out.reserve(body.size());
+    for (size_t i = 0; i < body.size(); ++i) {
+        char c = body[i];
+        if (c != '\\' || i + 1 >= body.size()) {
+            out += c;
+            continue;
+        }
+        char next = body[i + 1];
+        char decoded = 0;
+        if (next == '\\' || next == '\'') {
+            decoded = next;
+        } else if (quote == '"') {
+            switch (next) {
+                case '"': decoded = '"'; break;
+                case 'a': decoded = '\a'; break;
+                case 'b': decoded = '\b'; break;
+                case 'f': decoded = '\f'; break;
+                case 'n': decoded = '\n'; break;
+                case 'r': decoded = '\r'; break;
+                case 't': decoded = '\t'; break;
+                case 'v': decoded = '\v'; break;
+                default: break;
+            }
+        }
+        if (decoded != 0) {
+            out += decoded;
+            ++i;
+        } else {
+            out += c;  // Unknown escape: kept as written
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Expand ${NAME} and ${NAME:-default} in a .env value.
+ *
+ * @param resolve Returns the value of NAME, or nullopt if it has none
+ */
+template <typename Resolve>
+std::string expand_dotenv_value(std::string_view value, Resolve&& resolve) {
+    std::string out;
+    out.reserve(value.size());
+    size_t pos = 0;
+    while (pos < value.size()) {
+        size_t open = value.find("${", pos);
+        size_t close = open == std::string_view::npos ? open : value.find('}', open + 2);
+        if (close == std::string_view::npos) {
+            out.append(value.substr(pos));
+            break;
+        }
+        out.append(value.substr(pos, open - pos));
+
+        std::string_view inner = value.substr(open + 2, close - open - 2);
+        std::string_view name = inner;
+        std::optional<std::string_view> fallback;
+        size_t colon = inner.find(':');
+        if (colon != std::string_view::npos) {
+            if (inner.substr(colon, 2) != ":-") {
+                // Not a reference python-dotenv recognizes: keep verbatim
+                out.append(value.substr(open, close + 1 - open));
+                pos = close + 1;
+                continue;
+            }
+            name = inner.substr(0, colon);
+            fallback = inner.substr(colon + 2);
+        }
+
+        if (std::optional<std::string> found = resolve(name)) {
+            out += *found;
+        } else if (fallback) {
+            out.append(*fallback);
+        }
+        pos = close + 1;
+    }
+    return out;
+}
+
 /**
  * @brief Convert toml++ value to nlohmann::json.
  */
@@ -220,6 +551,10 @@ Value load_json_file(const std::string& path) {
 // TOML File Loading
 // ============================================================================
 
+Value toml_to_json(const void* toml_table) {
+    return toml_value_to_json(*static_cast<const toml::table*>(toml_table));
+}
+
 Value load_toml_file(const std::string& path, const Value& defaults) {
     // Check file exists
     if (!file_exists(path)) {
@@ -332,7 +667,7 @@ Value load_config_file(const std::string& path, const Value& defaults) {
 // .env File Loading
 // ============================================================================
 
-DotenvResult parse_dotenv_file(const std::string& path) {
+DotenvResult parse_dotenv_file(const std::string& path, const DotenvOptions& options) {
     DotenvResult result;
     result.loaded_path = path;
     result.found = false;
@@ -341,104 +676,166 @@ DotenvResult parse_dotenv_file(const std::string& path) {
         return result;
     }
 
-    std::ifstream file(path);
-    if (!file) {
+    MappedText text(path);
+    if (!text.ok()) {
         return result;
     }
-
     result.found = true;
-    std::string line;
-
-    while (std::getline(file, line)) {
-        // Trim the line
-        std::string trimmed = trim(line);
 
-        // Skip empty lines and comments
-        if (trimmed.empty() || trimmed[0] == '#') {
-            continue;
+    // Keys of the entries so far (views into the mapped text); indexed
+    // only once a ${VAR} needs an earlier entry
+    std::vector<std::string_view> keys;
+    std::unordered_map<std::string_view, size_t> defined;
+    size_t indexed = 0;
+    auto resolve = [&](std::string_view name) -> std::optional<std::string> {
+        auto from_file = [&]() -> std::optional<std::string> {
+            for (; indexed < keys.size(); ++indexed) {
+                defined[keys[indexed]] = indexed;  // Later entries win
+            }
+            auto it = defined.find(name);
+            if (it == defined.end()) return std::nullopt;
+            return result.entries[it->second].second;
+        };
+        if (options.override_existing) {
+            if (auto value = from_file()) return value;
+            return get_env_var(std::string(name));
         }
-
-        // Handle 'export' prefix
-        const std::string export_prefix = "export ";
-        if (trimmed.length() > export_prefix.length() &&
-            to_lower(trimmed.substr(0, export_prefix.length())) == export_prefix) {
-            trimmed = trim(trimmed.substr(export_prefix.length()));
+        if (auto value = get_env_var(std::string(name))) return value;
+        return from_file();
+    };
+
+    DotenvScanner scanner(text.view());
+    DotenvScanner::Binding binding;
+    while (scanner.next(binding)) {
+        if (!binding.has_value) {
+            continue;  // Bare KEY: python-dotenv yields None, which is not loaded
         }
 
-        // Find the = sign
-        size_t eq_pos = trimmed.find('=');
-        if (eq_pos == std::string::npos || eq_pos == 0) {
-            continue;  // Invalid line, skip
+        std::string value = binding.escaped
+            ? decode_dotenv_escapes(binding.value, binding.quote)
+            : std::string(binding.value);
+        if (options.interpolate && binding.quote != '\'' &&
+            value.find("${") != std::string::npos) {
+            value = expand_dotenv_value(value, resolve);
         }
 
-        // Extract key and value
-        std::string key = trim(trimmed.substr(0, eq_pos));
-        std::string value = trimmed.substr(eq_pos + 1);
+        keys.push_back(binding.key);
+        result.entries.emplace_back(std::string(binding.key), std::move(value));
+    }
 
-        // Handle inline comments (but not inside quotes)
-        bool in_single_quote = false;
-        bool in_double_quote = false;
-        size_t comment_pos = std::string::npos;
+    return result;
+}
 
-        for (size_t i = 0; i < value.length(); ++i) {
-            char c = value[i];
-            if (c == '\'' && !in_double_quote) {
-                in_single_quote = !in_single_quote;
-            } else if (c == '"' && !in_single_quote) {
-                in_double_quote = !in_double_quote;
-            } else if (c == '#' && !in_single_quote && !in_double_quote) {
-                comment_pos = i;
-                break;
-            }
-        }
+namespace {
+
+/// Process-wide find_dotenv() hits: search key -> path of the .env found
+struct DotenvCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::string> found;
+};
+
+DotenvCache& dotenv_cache() {
+    static DotenvCache cache;
+    return cache;
+}
 
-        if (comment_pos != std::string::npos) {
-            value = value.substr(0, comment_pos);
+/// Absolute, normalized directory without a trailing separator
+fs::path directory_key(const fs::path& dir) {
+    std::error_code ec;
+    fs::path result = fs::absolute(dir, ec);
+    if (ec) {
+        result = dir;
+    }
+    result = result.lexically_normal();
+    if (!result.has_filename() && result != result.root_path()) {
+        result = result.parent_path();
+    }
+    return result;
+}
+
+std::string search_dotenv(const fs::path& start, const fs::path& stop, const std::string& marker) {
+    for (fs::path dir = start;;) {
+        // One stat() answers both "exists" and "is a regular file"
+        std::error_code ec;
+        fs::path candidate = dir / ".env";
+        if (fs::is_regular_file(fs::status(candidate, ec))) {
+            return candidate.string();
         }
 
-        // Trim and unquote value
-        value = trim(value);
-        value = unquote(value);
+        if (dir == stop) {
+            break;
+        }
+        if (!marker.empty() && fs::exists(fs::status(dir / marker, ec))) {
+            break;
+        }
 
-        // Add to results
-        if (!key.empty()) {
-            result.entries.emplace_back(std::move(key), std::move(value));
+        fs::path parent = dir.parent_path();
+        if (parent.empty() || parent == dir) {
+            break;  // Reached the root
         }
+        dir = std::move(parent);
     }
-
-    return result;
+    return "";
 }
 
-std::string find_dotenv(const std::string& start_dir) {
-    fs::path search_path;
+} // anonymous namespace
 
-    if (start_dir.empty()) {
+std::string find_dotenv(const DotenvSearch& search) {
+    fs::path start;
+    if (search.start_dir.empty()) {
         std::error_code ec;
-        search_path = fs::current_path(ec);
+        start = fs::current_path(ec);
         if (ec) return "";
     } else {
-        search_path = start_dir;
+        start = search.start_dir;
     }
-
-    // Search current directory and parent directories
-    while (!search_path.empty()) {
-        fs::path dotenv_path = search_path / ".env";
-
+    start = directory_key(start);
+    fs::path stop = search.stop_dir.empty() ? fs::path() : directory_key(search.stop_dir);
+
+    std::string key = start.string();
+    key += '\0';
+    key += stop.string();
+    key += '\0';
+    key += search.stop_marker;
+
+    // Only hits are cached, and each is confirmed with one stat(), so a
+    // .env that is created later or deleted is never hidden
+    DotenvCache& cache = dotenv_cache();
+    std::string cached;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.found.find(key);
+        if (it != cache.found.end()) {
+            cached = it->second;
+        }
+    }
+    if (!cached.empty()) {
         std::error_code ec;
-        if (fs::exists(dotenv_path, ec) && fs::is_regular_file(dotenv_path, ec)) {
-            return dotenv_path.string();
+        if (fs::is_regular_file(fs::status(cached, ec))) {
+            return cached;
         }
+    }
 
-        // Move to parent directory
-        fs::path parent = search_path.parent_path();
-        if (parent == search_path) {
-            // Reached root, stop
-            break;
-        }
-        search_path = parent;
+    std::string result = search_dotenv(start, stop, search.stop_marker);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (result.empty()) {
+        cache.found.erase(key);
+    } else {
+        cache.found[std::move(key)] = result;
     }
+    return result;
+}
 
-    return "";
+std::string find_dotenv(const std::string& start_dir) {
+    DotenvSearch search;
+    search.start_dir = start_dir;
+    return find_dotenv(search);
+}
+
+void clear_dotenv_cache() {
+    DotenvCache& cache = dotenv_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.found.clear();
 }
 
 bool set_env_var(const std::string& name, const std::string& value, bool overwrite) {
@@ -486,6 +883,15 @@ bool has_env_var(const std::string& name) {
 #endif
 }
 
+void unset_env_var(const std::string& name) {
+#ifdef _WIN32
+    // Windows: a null value deletes the variable
+    SetEnvironmentVariableA(name.c_str(), nullptr);
+#else
+    unsetenv(name.c_str());
+#endif
+}
+
 bool load_dotenv_file(const std::string& path, bool override_existing) {
     std::string dotenv_path = path;
 
@@ -497,8 +903,10 @@ bool load_dotenv_file(const std::string& path, bool override_existing) {
         }
     }
 
-    // Parse the file
-    DotenvResult result = parse_dotenv_file(dotenv_path);
+    // Parse the file; ${VAR} resolves in the order the entries will apply
+    DotenvOptions options;
+    options.override_existing = override_existing;
+    DotenvResult result = parse_dotenv_file(dotenv_path, options);
 
     if (!result.found) {
         return false;
@@ -4,9 +4,218 @@
  */
 
 #include "confy/Merge.hpp"
+#include "confy/Provenance.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace confy {
 
+namespace {
+
+/// Erase the recorded leaves of @p node at @p path
+void forget_leaves(const Value& node, std::string& path, Provenance& provenance) {
+    if (!node.is_object()) {
+        provenance.erase(path);
+        return;
+    }
+    for (auto it = node.begin(); it != node.end(); ++it) {
+        size_t mark = path.size();
+        if (mark != 0) path += '.';
+        path += it.key();
+        forget_leaves(it.value(), path, provenance);
+        path.resize(mark);
+    }
+}
+
+/// Assign the leaves of @p node at @p path to @p layer
+void assign_leaves(const Value& node, std::string& path, Provenance& provenance, uint8_t layer) {
+    if (!node.is_object()) {
+        provenance.assign(path, layer);
+        return;
+    }
+    for (auto it = node.begin(); it != node.end(); ++it) {
+        size_t mark = path.size();
+        if (mark != 0) path += '.';
+        path += it.key();
+        assign_leaves(it.value(), path, provenance, layer);
+        path.resize(mark);
+    }
+}
+
+/// deep_merge() at @p path, keeping @p provenance in step
+Value traced_merge(const Value& base, const Value& override_val, std::string& path,
+                   Provenance& provenance, uint8_t layer) {
+    // Null doesn't override
+    if (override_val.is_null()) {
+        return base;
+    }
+
+    // RULE P2: Both are objects → recursive merge
+    if (base.is_object() && override_val.is_object()) {
+        Value result = base;
+        for (auto it = override_val.begin(); it != override_val.end(); ++it) {
+            size_t mark = path.size();
+            if (mark != 0) path += '.';
+            path += it.key();
+
+            auto existing = result.find(it.key());
+            if (existing != result.end()) {
+                *existing = traced_merge(*existing, it.value(), path, provenance, layer);
+            } else {
+                assign_leaves(it.value(), path, provenance, layer);
+                result[it.key()] = it.value();
+            }
+            path.resize(mark);
+        }
+        return result;
+    }
+
+    // RULE P3 (and a null base): the override replaces base entirely
+    forget_leaves(base, path, provenance);
+    assign_leaves(override_val, path, provenance, layer);
+    return override_val;
+}
+
+using Object = Value::object_t;
+
+/**
+ * @brief Walk two sorted key ranges in step, emitting the merged entries
+ *
+ * Keys only in base or only in override are copied; keys in both are
+ * passed to @p merge_both. Entries come out in key order.
+ */
+template <typename MergeBoth, typename Emit>
+void merge_sorted(Object::const_iterator b, Object::const_iterator b_end,
+                  Object::const_iterator o, Object::const_iterator o_end,
+                  MergeBoth&& merge_both, Emit&& emit) {
+    while (b != b_end || o != o_end) {
+        if (o == o_end || (b != b_end && b->first < o->first)) {
+            emit(b->first, Value(b->second));
+            ++b;
+        } else if (b == b_end || o->first < b->first) {
+            // Copied as-is, null included, like deep_merge()
+            emit(o->first, Value(o->second));
+            ++o;
+        } else {
+            emit(b->first, merge_both(b->second, o->second));
+            ++b;
+            ++o;
+        }
+    }
+}
+
+/**
+ * @brief Merge two wide objects by splitting their keys across threads
+ *
+ * The larger object's keys are cut into ranges of equal size; each range
+ * (and the matching part of the other object) is merged sequentially into
+ * its own slice, and the slices are then moved into the result in order.
+ */
+Value merge_wide(const Object& base, const Object& over, size_t threads) {
+    const Object& larger = base.size() >= over.size() ? base : over;
+
+    // A few ranges per thread so that uneven subtrees balance out
+    size_t parts = std::min(larger.size(), threads * 4);
+    std::vector<const std::string*> bounds;
+    bounds.reserve(parts);
+    size_t step = larger.size() / parts;
+    size_t index = 0;
+    for (auto it = larger.begin(); it != larger.end() && bounds.size() < parts; ++it, ++index) {
+        if (index % step == 0) {
+            bounds.push_back(&it->first);
+        }
+    }
+    parts = bounds.size();
+    threads = std::min(threads, parts);
+
+    auto range_begin = [&](const Object& obj, size_t part) {
+        return part == 0 ? obj.begin() : obj.lower_bound(*bounds[part]);
+    };
+    auto range_end = [&](const Object& obj, size_t part) {
+        return part + 1 == parts ? obj.end() : obj.lower_bound(*bounds[part + 1]);
+    };
+
+    using Slice = std::vector<std::pair<std::string, Value>>;
+    std::vector<Slice> slices(parts);
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(threads);
+
+    auto work = [&](size_t worker) {
+        try {
+            for (size_t part; (part = next.fetch_add(1)) < parts;) {
+                Slice& slice = slices[part];
+                merge_sorted(range_begin(base, part), range_end(base, part),
+                             range_begin(over, part), range_end(over, part),
+                             [](const Value& b, const Value& o) { return deep_merge(b, o); },
+                             [&](const std::string& key, Value value) {
+                                 slice.emplace_back(key, std::move(value));
+                             });
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            next.store(parts);  // Stop handing out ranges
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& w : workers) {
+        w.join();
+    }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    Value result = Value::object();
+    Object& merged = result.get_ref<Object&>();
+    for (Slice& slice : slices) {
+        for (auto& [key, value] : slice) {
+            merged.emplace_hint(merged.end(), std::move(key), std::move(value));
+        }
+    }
+    return result;
+}
+
+/// deep_merge() that hands wide objects to merge_wide()
+Value parallel_merge(const Value& base, const Value& override_val,
+                     size_t threads, size_t min_keys) {
+    if (!base.is_object() || !override_val.is_object()) {
+        return deep_merge(base, override_val);
+    }
+
+    const Object& b = base.get_ref<const Object&>();
+    const Object& o = override_val.get_ref<const Object&>();
+    // Combined width: a wide base with a small override is still worth
+    // splitting, since every base key has to be copied
+    if (b.size() + o.size() >= min_keys) {
+        return merge_wide(b, o, threads);
+    }
+
+    // Narrow level: built key by key so that a wide child is never
+    // copied from base only to be replaced
+    Value result = Value::object();
+    Object& merged = result.get_ref<Object&>();
+    merge_sorted(b.begin(), b.end(), o.begin(), o.end(),
+                 [&](const Value& bv, const Value& ov) {
+                     return parallel_merge(bv, ov, threads, min_keys);
+                 },
+                 [&](const std::string& key, Value value) {
+                     merged.emplace_hint(merged.end(), key, std::move(value));
+                 });
+    return result;
+}
+
+} // anonymous namespace
+
 Value deep_merge(const Value& base, const Value& override_val) {
     // If override is null, return base (null doesn't override)
     if (override_val.is_null()) {
@@ -48,6 +257,23 @@ Value deep_merge(const Value& base, const Value& override_val) {
     return override_val;
 }
 
+Value deep_merge(const Value& base, const Value& override_val,
+                 Provenance& provenance, uint8_t layer) {
+    std::string path;
+    return traced_merge(base, override_val, path, provenance, layer);
+}
+
+Value deep_merge_parallel(const Value& base, const Value& override_val,
+                          const ParallelMergeOptions& options) {
+    size_t threads = options.threads != 0
+        ? options.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    if (threads == 1) {
+        return deep_merge(base, override_val);
+    }
+    return parallel_merge(base, override_val, threads, std::max<size_t>(options.min_keys, 1));
+}
+
 Value deep_merge_all(const std::vector<Value>& sources) {
     if (sources.empty()) {
         return Value::object();
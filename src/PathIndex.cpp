@@ -0,0 +1,128 @@
+/**
+ * @file PathIndex.cpp
+ * @brief Sorted dot-path index implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/PathIndex.hpp"
+#include "confy/Util.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace confy {
+
+namespace {
+
+/// ASCII lower-case; trigrams are case-folded so one index serves both modes
+inline uint32_t fold(char c) {
+    auto b = static_cast<unsigned char>(c);
+    return (b >= 'A' && b <= 'Z') ? b - 'A' + 'a' : b;
+}
+
+inline uint32_t trigram(const char* p) {
+    return (fold(p[0]) << 16) | (fold(p[1]) << 8) | fold(p[2]);
+}
+
+} // anonymous namespace
+
+PathIndex::PathIndex(const Config& cfg, bool trigrams)
+    : snapshot_(cfg), keys_(std::make_shared<KeyTable>()), trigrams_(trigrams)
+{
+    for (const auto& [path, value] : leaves(std::as_const(snapshot_).data())) {
+        entries_.push_back({keys_->intern(path).view(), &value});
+    }
+    std::sort(entries_.begin(), entries_.end(),
+              [](const Entry& a, const Entry& b) { return a.path < b.path; });
+
+    if (!trigrams_) {
+        return;
+    }
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        std::string_view path = entries_[i].path;
+        auto id = static_cast<uint32_t>(i);
+        for (size_t j = 0; j + 3 <= path.size(); ++j) {
+            auto& list = postings_[trigram(path.data() + j)];
+            if (list.empty() || list.back() != id) {
+                list.push_back(id);  // ascending, once per path
+            }
+        }
+    }
+}
+
+std::vector<const PathIndex::Entry*> PathIndex::with_prefix(std::string_view prefix) const {
+    auto lo = std::lower_bound(entries_.begin(), entries_.end(), prefix,
+                               [](const Entry& e, std::string_view p) { return e.path < p; });
+    std::vector<const Entry*> out;
+    for (auto it = lo; it != entries_.end() && it->path.compare(0, prefix.size(), prefix) == 0; ++it) {
+        out.push_back(&*it);
+    }
+    return out;
+}
+
+std::vector<size_t> PathIndex::candidates(const Pattern& pattern) const {
+    // Sorted range sharing the literal prefix
+    size_t lo = 0;
+    size_t hi = entries_.size();
+    std::string prefix = pattern.literal_prefix();
+    if (!prefix.empty()) {
+        auto first = std::lower_bound(entries_.begin(), entries_.end(), prefix,
+                                      [](const Entry& e, std::string_view p) { return e.path < p; });
+        auto last = std::find_if(first, entries_.end(), [&prefix](const Entry& e) {
+            return e.path.compare(0, prefix.size(), prefix) != 0;
+        });
+        lo = static_cast<size_t>(first - entries_.begin());
+        hi = static_cast<size_t>(last - entries_.begin());
+    }
+
+    // Posting lists of every trigram a match must contain, shortest first
+    std::vector<const std::vector<uint32_t>*> lists;
+    if (trigrams_) {
+        static const std::vector<uint32_t> none;
+        for (const std::string& literal : pattern.required_literals()) {
+            for (size_t j = 0; j + 3 <= literal.size(); ++j) {
+                auto it = postings_.find(trigram(literal.data() + j));
+                lists.push_back(it == postings_.end() ? &none : &it->second);
+            }
+        }
+        std::sort(lists.begin(), lists.end(),
+                  [](const auto* a, const auto* b) { return a->size() < b->size(); });
+    }
+
+    std::vector<size_t> out;
+    if (lists.empty()) {
+        out.resize(hi - lo);
+        for (size_t i = lo; i < hi; ++i) {
+            out[i - lo] = i;
+        }
+        return out;
+    }
+
+    std::vector<uint32_t> ids;
+    for (uint32_t id : *lists[0]) {
+        if (id >= lo && id < hi) ids.push_back(id);
+    }
+    std::vector<uint32_t> next;
+    for (size_t k = 1; k < lists.size() && !ids.empty(); ++k) {
+        next.clear();
+        std::set_intersection(ids.begin(), ids.end(), lists[k]->begin(), lists[k]->end(),
+                              std::back_inserter(next));
+        ids.swap(next);
+    }
+    out.assign(ids.begin(), ids.end());
+    return out;
+}
+
+std::vector<const PathIndex::Entry*> PathIndex::find(const Pattern& pattern) const {
+    std::vector<const Entry*> out;
+    for (size_t i : candidates(pattern)) {
+        if (pattern.matches(entries_[i].path)) {
+            out.push_back(&entries_[i]);
+        }
+    }
+    return out;
+}
+
+} // namespace confy
@@ -0,0 +1,251 @@
+/**
+ * @file Pattern.cpp
+ * @brief Pre-compiled search pattern implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/Pattern.hpp"
+
+#include <algorithm>
+
+namespace confy {
+
+namespace {
+
+/// ASCII lower-case, matching the "C" locale std::tolower
+inline char fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+inline unsigned char byte(char c) {
+    return static_cast<unsigned char>(c);
+}
+
+/**
+ * @brief Literal text a regex must start with ("^db\\.host" -> "db.host")
+ *
+ * Conservative: gives up on alternation and drops a character that is
+ * followed by a quantifier.
+ */
+std::string anchored_prefix(std::string_view re) {
+    std::string prefix;
+    if (re.empty() || re[0] != '^' || re.find('|') != std::string_view::npos) {
+        return prefix;
+    }
+    for (size_t i = 1; i < re.size(); ++i) {
+        char c = re[i];
+        size_t next = i + 1;
+        if (c == '\\' && next < re.size() &&
+            std::string_view(".-_/:[](){}*+?^$|\\").find(re[next]) != std::string_view::npos) {
+            c = re[next];
+            ++next;
+        } else if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                     (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '/' || c == ':')) {
+            break;
+        }
+        if (next < re.size() && std::string_view("*+?{").find(re[next]) != std::string_view::npos) {
+            break;  // quantified: this character may be absent or repeated
+        }
+        prefix += c;
+        i = next - 1;
+    }
+    return prefix;
+}
+
+} // anonymous namespace
+
+Pattern::Pattern(std::string_view pattern, bool ignore_case)
+    : ignore_case_(ignore_case)
+{
+    if (pattern.find_first_of("*?[") != std::string_view::npos) {
+        if (compile_glob(pattern)) {
+            kind_ = Kind::Glob;
+            return;
+        }
+        atoms_.clear();
+        classes_.clear();
+    } else if (pattern.find_first_of("^$|(+") != std::string_view::npos) {
+        try {
+            auto flags = std::regex::ECMAScript;
+            if (ignore_case) flags |= std::regex::icase;
+            regex_.emplace(pattern.begin(), pattern.end(), flags);
+            regex_prefix_ = anchored_prefix(pattern);
+            if (ignore_case) {
+                std::transform(regex_prefix_.begin(), regex_prefix_.end(),
+                               regex_prefix_.begin(), fold);
+            }
+            kind_ = Kind::Regex;
+            return;
+        } catch (const std::regex_error&) {
+            // Fall back to a substring search
+        }
+    }
+
+    kind_ = Kind::Substring;
+    text_.assign(pattern);
+    if (ignore_case_) {
+        std::transform(text_.begin(), text_.end(), text_.begin(), fold);
+    }
+}
+
+bool Pattern::compile_glob(std::string_view pattern) {
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '*') {
+            if (atoms_.empty() || atoms_.back().type != Atom::AnyRun) {
+                atoms_.push_back({Atom::AnyRun, 0, 0});
+            }
+        } else if (c == '?') {
+            atoms_.push_back({Atom::AnyChar, 0, 0});
+        } else if (c == '[') {
+            size_t close = pattern.find(']', i + 1);
+            if (close == std::string_view::npos) {
+                return false;
+            }
+
+            // A leading '!' or '^' negates the class ("[!]" alone is literal)
+            std::array<bool, 256> set{};
+            std::string_view body = pattern.substr(i + 1, close - i - 1);
+            bool negate = body.size() > 1 && (body[0] == '!' || body[0] == '^');
+            if (negate) {
+                body.remove_prefix(1);
+            }
+            for (size_t j = 0; j < body.size(); ++j) {
+                unsigned char lo = byte(body[j]);
+                unsigned char hi = lo;
+                if (j + 2 < body.size() && body[j + 1] == '-') {
+                    hi = byte(body[j + 2]);
+                    j += 2;
+                }
+                for (unsigned v = lo; v <= hi; ++v) {
+                    set[v] = true;
+                }
+            }
+            if (ignore_case_) {
+                for (unsigned v = 'A'; v <= 'Z'; ++v) {
+                    set[v + ('a' - 'A')] = set[v + ('a' - 'A')] || set[v];
+                }
+            }
+            if (negate) {
+                for (bool& member : set) {
+                    member = !member;
+                }
+            }
+
+            atoms_.push_back({Atom::Class, 0, classes_.size()});
+            classes_.push_back(set);
+            i = close;
+        } else {
+            atoms_.push_back({Atom::Char, ignore_case_ ? fold(c) : c, 0});
+        }
+    }
+    return true;
+}
+
+bool Pattern::match_glob(std::string_view text) const {
+    // Greedy matching, backtracking only to the most recent '*'
+    constexpr size_t NONE = static_cast<size_t>(-1);
+    size_t p = 0;
+    size_t t = 0;
+    size_t star_p = NONE;
+    size_t star_t = 0;
+
+    while (t < text.size()) {
+        if (p < atoms_.size()) {
+            const Atom& atom = atoms_[p];
+            char c = ignore_case_ ? fold(text[t]) : text[t];
+            bool ok = false;
+            switch (atom.type) {
+                case Atom::Char:    ok = atom.ch == c; break;
+                case Atom::AnyChar: ok = true; break;
+                case Atom::Class:   ok = classes_[atom.index][byte(c)]; break;
+                case Atom::AnyRun:
+                    star_p = p++;
+                    star_t = t;
+                    continue;
+            }
+            if (ok) {
+                ++p;
+                ++t;
+                continue;
+            }
+        }
+        if (star_p == NONE) {
+            return false;
+        }
+        p = star_p + 1;
+        t = ++star_t;
+    }
+
+    while (p < atoms_.size() && atoms_[p].type == Atom::AnyRun) {
+        ++p;
+    }
+    return p == atoms_.size();
+}
+
+bool Pattern::match_substring(std::string_view text) const {
+    if (!ignore_case_ || text_.empty()) {
+        return text.find(text_) != std::string_view::npos;
+    }
+    return std::search(text.begin(), text.end(), text_.begin(), text_.end(),
+                       [](char a, char b) { return fold(a) == b; }) != text.end();
+}
+
+bool Pattern::matches(std::string_view text) const {
+    switch (kind_) {
+        case Kind::Glob:
+            return match_glob(text);
+        case Kind::Regex:
+            return std::regex_search(text.begin(), text.end(), *regex_);
+        case Kind::Substring:
+            break;
+    }
+    return match_substring(text);
+}
+
+std::string Pattern::literal_prefix() const {
+    if (ignore_case_) {
+        return {};
+    }
+    if (kind_ == Kind::Regex) {
+        return regex_prefix_;
+    }
+
+    std::string prefix;
+    if (kind_ == Kind::Glob) {
+        for (const Atom& atom : atoms_) {
+            if (atom.type != Atom::Char) break;
+            prefix += atom.ch;
+        }
+    }
+    return prefix;
+}
+
+std::vector<std::string> Pattern::required_literals() const {
+    std::vector<std::string> out;
+    switch (kind_) {
+        case Kind::Substring:
+            out.push_back(text_);
+            break;
+        case Kind::Regex:
+            if (!regex_prefix_.empty()) out.push_back(regex_prefix_);
+            break;
+        case Kind::Glob: {
+            std::string run;
+            for (const Atom& atom : atoms_) {
+                if (atom.type == Atom::Char) {
+                    run += atom.ch;
+                } else if (!run.empty()) {
+                    out.push_back(std::move(run));
+                    run.clear();
+                }
+            }
+            if (!run.empty()) out.push_back(std::move(run));
+            break;
+        }
+    }
+    return out;
+}
+
+} // namespace confy
@@ -0,0 +1,138 @@
+/**
+ * @file Provenance.cpp
+ * @brief Per-leaf source tracking implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/Provenance.hpp"
+#include "confy/Errors.hpp"
+#include "confy/FileEdit.hpp"
+#include "confy/Loader.hpp"
+
+#include <algorithm>
+
+namespace confy {
+
+namespace {
+
+/**
+ * @brief Find @p path with @p lookup, or else its nearest recorded ancestor
+ *
+ * @p lookup returns an iterator into @p map or map.end().
+ */
+template <typename Map, typename Lookup>
+typename Map::const_iterator find_or_ancestor(const Map& map, std::string_view path, Lookup lookup) {
+    auto it = lookup(path);
+    while (it == map.end()) {
+        size_t dot = path.rfind('.');
+        if (dot == std::string_view::npos) {
+            return map.end();
+        }
+        path = path.substr(0, dot);
+        it = lookup(path);
+    }
+    return it;
+}
+
+/**
+ * @brief 1-based line of the value at @p path in a config file, 0 if not found
+ */
+size_t line_of(const std::string& file, const std::string& text, const std::string& path) {
+    std::optional<TextSpan> span = get_file_extension(file) == ".toml"
+        ? find_toml_value_span(text, path)
+        : find_json_value_span(text, path);
+    if (!span) {
+        return 0;
+    }
+    return 1 + static_cast<size_t>(
+        std::count(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(span->begin), '\n'));
+}
+
+} // anonymous namespace
+
+const char* source_name(Source source) {
+    switch (source) {
+        case Source::Defaults: return "defaults";
+        case Source::File:     return "file";
+        case Source::Dotenv:   return ".env";
+        case Source::Env:      return "env";
+        case Source::Override: return "override";
+    }
+    return "unknown";
+}
+
+std::string Origin::to_string() const {
+    std::string out = source_name(source);
+    if (!name.empty()) {
+        out += ' ';
+        out += name;
+    }
+    if (!file.empty()) {
+        if (source == Source::File) {
+            out += ' ';
+            out += file;
+            if (line != 0) {
+                out += ':' + std::to_string(line);
+            }
+        } else {
+            out += " (" + file + ")";
+        }
+    }
+    return out;
+}
+
+uint8_t Provenance::add_layer(Source source, std::string file, std::string text) {
+    if (layers_.size() >= MAX_LAYERS) {
+        throw ConfigError("Provenance supports at most " + std::to_string(MAX_LAYERS) + " layers");
+    }
+    layers_.push_back({source, std::move(file), std::move(text), {}});
+    return static_cast<uint8_t>(layers_.size() - 1);
+}
+
+void Provenance::set_origin(uint8_t layer, std::string path, Origin origin) {
+    layers_.at(layer).origins[std::move(path)] = std::move(origin);
+}
+
+void Provenance::assign(std::string_view path, uint8_t layer) {
+    leaves_[keys_->intern(path)] = layer;
+}
+
+void Provenance::erase(std::string_view path) {
+    // A path that was never interned was never assigned
+    InternedKey key = keys_->find(path);
+    if (!key.empty()) {
+        leaves_.erase(key);
+    }
+}
+
+std::optional<Origin> Provenance::origin(std::string_view path) const {
+    // The leaf itself, or the array a path inside it indexes
+    auto leaf = find_or_ancestor(leaves_, path, [&](std::string_view p) {
+        InternedKey key = keys_->find(p);
+        return key.empty() ? leaves_.end() : leaves_.find(key);
+    });
+    if (leaf == leaves_.end()) {
+        return std::nullopt;
+    }
+
+    const Layer& layer = layers_[leaf->second];
+    std::string_view leaf_path = leaf->first.view();
+    auto named = find_or_ancestor(layer.origins, leaf_path, [&](std::string_view p) {
+        return layer.origins.find(std::string(p));
+    });
+    if (named != layer.origins.end()) {
+        return named->second;
+    }
+
+    Origin result;
+    result.source = layer.source;
+    result.file = layer.file;
+    if (layer.source == Source::File && !layer.text.empty()) {
+        // Located on demand: one scan of the file per query
+        result.line = line_of(layer.file, layer.text, std::string(leaf_path));
+    }
+    return result;
+}
+
+} // namespace confy
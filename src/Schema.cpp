@@ -0,0 +1,300 @@
+/**
+ * @file Schema.cpp
+ * @brief Compiled configuration schema implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/Schema.hpp"
+#include "confy/DotPath.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace confy {
+
+namespace {
+
+const char* schema_type_name(SchemaType type) {
+    switch (type) {
+        case SchemaType::Any:     return "any";
+        case SchemaType::String:  return "string";
+        case SchemaType::Integer: return "integer";
+        case SchemaType::Number:  return "number";
+        case SchemaType::Boolean: return "boolean";
+        case SchemaType::Object:  return "object";
+        case SchemaType::Array:   return "array";
+        case SchemaType::Null:    return "null";
+    }
+    return "any";
+}
+
+std::optional<SchemaType> parse_schema_type(const std::string& name) {
+    static const SchemaType all[] = {
+        SchemaType::Any, SchemaType::String, SchemaType::Integer,
+        SchemaType::Number, SchemaType::Boolean, SchemaType::Object,
+        SchemaType::Array, SchemaType::Null
+    };
+    for (SchemaType type : all) {
+        if (name == schema_type_name(type)) {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+
+bool matches_type(const Value& value, SchemaType type) {
+    switch (type) {
+        case SchemaType::Any:     return true;
+        case SchemaType::String:  return value.is_string();
+        case SchemaType::Integer: return value.is_number_integer();
+        case SchemaType::Number:  return value.is_number();
+        case SchemaType::Boolean: return value.is_boolean();
+        case SchemaType::Object:  return value.is_object();
+        case SchemaType::Array:   return value.is_array();
+        case SchemaType::Null:    return value.is_null();
+    }
+    return true;
+}
+
+std::string format_number(double value) {
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// FieldRule
+// =============================================================================
+
+FieldRule& FieldRule::required(bool value) {
+    required_ = value;
+    return *this;
+}
+
+FieldRule& FieldRule::type(SchemaType value) {
+    type_ = value;
+    return *this;
+}
+
+FieldRule& FieldRule::min(double value) {
+    min_ = value;
+    return *this;
+}
+
+FieldRule& FieldRule::max(double value) {
+    max_ = value;
+    return *this;
+}
+
+FieldRule& FieldRule::one_of(std::vector<Value> values) {
+    enum_ = std::move(values);
+    return *this;
+}
+
+FieldRule& FieldRule::pattern(const std::string& regex) {
+    try {
+        regex_.emplace(regex, std::regex::ECMAScript);
+    } catch (const std::regex_error& e) {
+        throw ConfigError("Invalid schema pattern for '" + path_ + "': " + e.what());
+    }
+    pattern_ = regex;
+    return *this;
+}
+
+FieldRule& FieldRule::default_value(Value value) {
+    default_ = std::move(value);
+    return *this;
+}
+
+// =============================================================================
+// Schema Construction
+// =============================================================================
+
+Schema::Schema() : root_(std::make_unique<Node>()) {}
+Schema::~Schema() = default;
+Schema::Schema(Schema&&) noexcept = default;
+Schema& Schema::operator=(Schema&&) noexcept = default;
+
+FieldRule& Schema::field(const std::string& path) {
+    Node* node = root_.get();
+    for (const auto& seg : split_dot_path(path)) {
+        auto& child = node->children[seg];
+        if (!child) {
+            child = std::make_unique<Node>();
+        }
+        node = child.get();
+    }
+
+    if (node->rule == nullptr) {
+        rules_.push_back(FieldRule(path));
+        node->rule = &rules_.back();
+        node->rule_index = rules_.size() - 1;
+    }
+    return rules_[node->rule_index];
+}
+
+Schema Schema::from_json(const Value& spec) {
+    if (!spec.is_object()) {
+        throw ConfigError("Schema description must be an object, got " + type_name(spec));
+    }
+
+    Schema schema;
+    for (auto it = spec.begin(); it != spec.end(); ++it) {
+        const std::string& path = it.key();
+        const Value& rule_spec = it.value();
+        if (!rule_spec.is_object()) {
+            throw ConfigError("Schema rule for '" + path + "' must be an object");
+        }
+
+        FieldRule& rule = schema.field(path);
+        for (auto r = rule_spec.begin(); r != rule_spec.end(); ++r) {
+            const std::string& name = r.key();
+            const Value& arg = r.value();
+
+            if (name == "required" && arg.is_boolean()) {
+                rule.required(arg.get<bool>());
+            } else if (name == "type" && arg.is_string()) {
+                auto type = parse_schema_type(arg.get<std::string>());
+                if (!type) {
+                    throw ConfigError("Unknown schema type '" + arg.get<std::string>() +
+                                      "' for '" + path + "'");
+                }
+                rule.type(*type);
+            } else if (name == "min" && arg.is_number()) {
+                rule.min(arg.get<double>());
+            } else if (name == "max" && arg.is_number()) {
+                rule.max(arg.get<double>());
+            } else if (name == "enum" && arg.is_array()) {
+                rule.one_of(std::vector<Value>(arg.begin(), arg.end()));
+            } else if (name == "pattern" && arg.is_string()) {
+                rule.pattern(arg.get<std::string>());
+            } else if (name == "default") {
+                rule.default_value(arg);
+            } else {
+                throw ConfigError("Invalid schema entry '" + name + "' for '" + path + "'");
+            }
+        }
+    }
+    return schema;
+}
+
+// =============================================================================
+// Defaults
+// =============================================================================
+
+Value Schema::defaults() const {
+    Value result = Value::object();
+    for (const auto& rule : rules_) {
+        if (rule.default_.has_value()) {
+            set_by_dot(result, rule.path_, *rule.default_, true);
+        }
+    }
+    return result;
+}
+
+// =============================================================================
+// Validation
+// =============================================================================
+
+void Schema::check_rule(const FieldRule& rule, size_t index, const Value& value,
+                        std::vector<Found>& out) {
+    using Kind = SchemaViolation::Kind;
+
+    if (!matches_type(value, rule.type_)) {
+        out.push_back({index, {Kind::WrongType, rule.path_,
+            std::string("expected ") + schema_type_name(rule.type_) +
+            ", got " + type_name(value)}});
+        return;
+    }
+
+    if (value.is_number() && (rule.min_ || rule.max_)) {
+        double number = value.get<double>();
+        if ((rule.min_ && number < *rule.min_) || (rule.max_ && number > *rule.max_)) {
+            out.push_back({index, {Kind::OutOfRange, rule.path_,
+                value.dump() + " is outside [" +
+                (rule.min_ ? format_number(*rule.min_) : std::string("-inf")) + ", " +
+                (rule.max_ ? format_number(*rule.max_) : std::string("inf")) + "]"}});
+        }
+    }
+
+    if (!rule.enum_.empty() &&
+        std::find(rule.enum_.begin(), rule.enum_.end(), value) == rule.enum_.end()) {
+        out.push_back({index, {Kind::NotInEnum, rule.path_,
+            value.dump() + " is not one of " + Value(rule.enum_).dump()}});
+    }
+
+    if (rule.regex_ && value.is_string() &&
+        !std::regex_search(value.get_ref<const std::string&>(), *rule.regex_)) {
+        out.push_back({index, {Kind::PatternMismatch, rule.path_,
+            value.dump() + " does not match /" + rule.pattern_ + "/"}});
+    }
+}
+
+void Schema::visit(const Node& node, const Value* value, std::vector<Found>& out) const {
+    if (node.rule != nullptr) {
+        if (value != nullptr) {
+            check_rule(*node.rule, node.rule_index, *value, out);
+        } else if (node.rule->required_) {
+            out.push_back({node.rule_index, {SchemaViolation::Kind::Missing,
+                node.rule->path_, "required key is missing"}});
+        }
+    }
+
+    for (const auto& [seg, child] : node.children) {
+        const Value* next = nullptr;
+        if (value != nullptr) {
+            if (value->is_object()) {
+                auto it = value->find(seg);
+                if (it != value->end()) {
+                    next = &*it;
+                }
+            } else if (value->is_array() && is_array_index(seg)) {
+                size_t idx = parse_array_index(seg);
+                if (idx < value->size()) {
+                    next = &(*value)[idx];
+                }
+            }
+            // RULE M3: Anything below a non-container is missing
+        }
+        visit(*child, next, out);
+    }
+}
+
+std::vector<SchemaViolation> Schema::validate(const Value& root) const {
+    std::vector<Found> found;
+    visit(*root_, &root, found);
+
+    // Report in rule declaration order, not trie order
+    std::stable_sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+        return a.rule_index < b.rule_index;
+    });
+
+    std::vector<SchemaViolation> result;
+    result.reserve(found.size());
+    for (auto& f : found) {
+        result.push_back(std::move(f.violation));
+    }
+    return result;
+}
+
+void Schema::check(const Value& root) const {
+    auto violations = validate(root);
+    if (violations.empty()) {
+        return;
+    }
+
+    std::vector<std::string> messages;
+    std::vector<std::string> missing;
+    for (const auto& v : violations) {
+        messages.push_back(v.path + ": " + v.message);
+        if (v.kind == SchemaViolation::Kind::Missing) {
+            missing.push_back(v.path);
+        }
+    }
+    throw SchemaValidationError(std::move(messages), std::move(missing));
+}
+
+} // namespace confy
@@ -0,0 +1,581 @@
+/**
+ * @file Server.cpp
+ * @brief Local configuration server and client implementation
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include "confy/Server.hpp"
+#include "confy/Errors.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/epoll.h>
+    #else
+        #include <poll.h>
+    #endif
+#endif
+
+namespace confy {
+
+// ============================================================================
+// Command Lines
+// ============================================================================
+
+std::vector<std::string> split_command_line(std::string_view line) {
+    std::vector<std::string> words;
+    std::string word;
+    bool in_word = false;
+
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (c == ' ' || c == '\t' || c == '\r') {
+            if (in_word) {
+                words.push_back(std::move(word));
+                word.clear();
+                in_word = false;
+            }
+            continue;
+        }
+
+        in_word = true;
+        if (c == '\'') {
+            size_t close = line.find('\'', i + 1);
+            if (close == std::string_view::npos) {
+                throw ConfigError("Unterminated single quote");
+            }
+            word.append(line.substr(i + 1, close - i - 1));
+            i = close;
+        } else if (c == '"') {
+            for (++i; i < line.size() && line[i] != '"'; ++i) {
+                if (line[i] == '\\' && i + 1 < line.size()) ++i;
+                word += line[i];
+            }
+            if (i >= line.size()) {
+                throw ConfigError("Unterminated double quote");
+            }
+        } else {
+            word += c;
+        }
+    }
+    if (in_word) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+std::string join_command_line(const std::vector<std::string>& words) {
+    std::string line;
+    for (const auto& word : words) {
+        if (word.find_first_of("\r\n") != std::string::npos) {
+            throw ConfigError("Command words cannot contain line breaks");
+        }
+        if (!line.empty()) {
+            line += ' ';
+        }
+
+        bool plain = !word.empty() && word[0] != '#' &&
+                     word.find_first_of(" \t\"'\\") == std::string::npos;
+        if (plain) {
+            line += word;
+            continue;
+        }
+        line += '"';
+        for (char c : word) {
+            if (c == '"' || c == '\\') line += '\\';
+            line += c;
+        }
+        line += '"';
+    }
+    return line;
+}
+
+#ifndef _WIN32
+
+namespace {
+
+// ============================================================================
+// Descriptor Helpers
+// ============================================================================
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+void set_nonblocking(int fd) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+void set_cloexec(int fd) {
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+int open_socket() {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw ConfigError(std::string("Cannot create socket: ") + std::strerror(errno));
+    }
+    set_cloexec(fd);
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    return fd;
+}
+
+sockaddr_un make_address(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        throw ConfigError("Invalid socket path: '" + path + "'");
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+bool connect_to(int fd, const sockaddr_un& addr) {
+    return ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+}
+
+/// Write as much of @p data as the socket accepts; false on a hard error
+bool send_some(int fd, std::string& data) {
+    while (!data.empty()) {
+        ssize_t n = ::send(fd, data.data(), data.size(), SEND_FLAGS);
+        if (n > 0) {
+            data.erase(0, static_cast<size_t>(n));
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+    }
+    return true;
+}
+
+std::string error_response(const char* message) {
+    return Value{{"ok", false}, {"error", message}}.dump();
+}
+
+// ============================================================================
+// Readiness Polling
+// ============================================================================
+
+struct Ready {
+    int fd;
+    bool readable;
+    bool writable;
+};
+
+/**
+ * @brief Minimal readiness interface over epoll (Linux) or poll()
+ */
+class Poller {
+public:
+#ifdef __linux__
+    Poller() : epfd_(::epoll_create1(EPOLL_CLOEXEC)) {
+        if (epfd_ < 0) {
+            throw ConfigError(std::string("Cannot create epoll instance: ") + std::strerror(errno));
+        }
+    }
+    ~Poller() { ::close(epfd_); }
+
+    void add(int fd) { control(EPOLL_CTL_ADD, fd, true, false); }
+    void watch(int fd, bool want_read, bool want_write) {
+        control(EPOLL_CTL_MOD, fd, want_read, want_write);
+    }
+    void remove(int fd) { ::epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr); }
+
+    void wait(std::vector<Ready>& out, int timeout_ms) {
+        epoll_event events[64];
+        out.clear();
+        int n = ::epoll_wait(epfd_, events, 64, timeout_ms);
+        for (int i = 0; i < n; ++i) {
+            uint32_t ev = events[i].events;
+            out.push_back({events[i].data.fd,
+                           (ev & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0,
+                           (ev & EPOLLOUT) != 0});
+        }
+    }
+
+private:
+    void control(int op, int fd, bool want_read, bool want_write) {
+        epoll_event ev{};
+        ev.events = (want_read ? EPOLLIN : 0u) | (want_write ? EPOLLOUT : 0u);
+        ev.data.fd = fd;
+        ::epoll_ctl(epfd_, op, fd, &ev);
+    }
+
+    int epfd_;
+#else
+    void add(int fd) { fds_.push_back({fd, POLLIN, 0}); }
+
+    void watch(int fd, bool want_read, bool want_write) {
+        for (auto& p : fds_) {
+            if (p.fd == fd) {
+                p.events = static_cast<short>((want_read ? POLLIN : 0) | (want_write ? POLLOUT : 0));
+            }
+        }
+    }
+
+    void remove(int fd) {
+        for (size_t i = 0; i < fds_.size(); ++i) {
+            if (fds_[i].fd == fd) {
+                fds_[i] = fds_.back();
+                fds_.pop_back();
+                return;
+            }
+        }
+    }
+
+    void wait(std::vector<Ready>& out, int timeout_ms) {
+        out.clear();
+        if (::poll(fds_.data(), fds_.size(), timeout_ms) <= 0) {
+            return;
+        }
+        for (const auto& p : fds_) {
+            if (p.revents != 0) {
+                out.push_back({p.fd, (p.revents & (POLLIN | POLLHUP | POLLERR)) != 0,
+                               (p.revents & POLLOUT) != 0});
+            }
+        }
+    }
+
+private:
+    std::vector<pollfd> fds_;
+#endif
+};
+
+} // anonymous namespace
+
+// ============================================================================
+// ConfigServer
+// ============================================================================
+
+struct ConfigServer::Impl {
+    struct Connection {
+        std::string in;
+        std::string out;
+        bool eof = false;
+        bool reading = true;    ///< Registered for readability
+        bool writing = false;   ///< Registered for writability
+    };
+
+    Handler handler;
+    int listen_fd = -1;
+    int wake_read = -1;
+    int wake_write = -1;
+    Poller poller;
+    std::unordered_map<int, Connection> connections;
+
+    std::chrono::milliseconds tick_interval{0};
+    std::function<void()> on_tick;
+
+    void accept_all() {
+        while (true) {
+            int fd = ::accept(listen_fd, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                return;  // EAGAIN: backlog drained
+            }
+            set_cloexec(fd);
+            set_nonblocking(fd);
+            poller.add(fd);
+            connections.emplace(fd, Connection{});
+        }
+    }
+
+    /// Read what the socket has, up to one maximal request beyond a full buffer
+    bool read_input(int fd, Connection& conn) {
+        char buf[4096];
+        while (conn.in.size() <= MAX_REQUEST_SIZE) {
+            ssize_t n = ::read(fd, buf, sizeof(buf));
+            if (n > 0) {
+                conn.in.append(buf, static_cast<size_t>(n));
+            } else if (n == 0) {
+                conn.eof = true;
+                break;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Answer complete request lines until MAX_PENDING_OUTPUT is queued
+    void answer_lines(Connection& conn) {
+        size_t start = 0;
+        for (size_t nl = conn.in.find('\n');
+             nl != std::string::npos && conn.out.size() < MAX_PENDING_OUTPUT;
+             nl = conn.in.find('\n', start)) {
+            std::string_view line(conn.in.data() + start, nl - start);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            try {
+                conn.out += handler(line);
+            } catch (const std::exception& e) {
+                conn.out += error_response(e.what());
+            }
+            conn.out += '\n';
+            start = nl + 1;
+        }
+        conn.in.erase(0, start);
+    }
+
+    /**
+     * @brief Read, answer complete lines, flush; false once the connection is done
+     *
+     * A client that pipelines requests without reading the responses is
+     * not read from while MAX_PENDING_OUTPUT bytes are queued for it, so
+     * its requests back up in the kernel instead of in conn.out.
+     */
+    bool service(int fd, Connection& conn, bool readable) {
+        if (readable && conn.out.size() < MAX_PENDING_OUTPUT && !read_input(fd, conn)) {
+            return false;
+        }
+
+        while (true) {
+            answer_lines(conn);
+            if (!send_some(fd, conn.out)) {
+                return false;
+            }
+            // Lines held back by the cap can go once the socket took the output
+            if (!conn.out.empty() || conn.in.find('\n') == std::string::npos) {
+                break;
+            }
+        }
+        if (conn.in.size() > MAX_REQUEST_SIZE && conn.in.find('\n') == std::string::npos) {
+            return false;  // Request line too long
+        }
+        if (conn.out.empty() && conn.eof) {
+            return false;
+        }
+
+        bool want_read = !conn.eof && conn.out.size() < MAX_PENDING_OUTPUT;
+        bool want_write = !conn.out.empty();
+        if (want_read != conn.reading || want_write != conn.writing) {
+            poller.watch(fd, want_read, want_write);
+            conn.reading = want_read;
+            conn.writing = want_write;
+        }
+        return true;
+    }
+
+    void close_connection(int fd) {
+        poller.remove(fd);
+        ::close(fd);
+        connections.erase(fd);
+    }
+};
+
+ConfigServer::ConfigServer(std::string socket_path, Handler handler)
+    : socket_path_(std::move(socket_path)), impl_(std::make_unique<Impl>())
+{
+    impl_->handler = std::move(handler);
+    sockaddr_un addr = make_address(socket_path_);
+
+    // Refuse to take over a live server; replace a stale socket file
+    struct stat st{};
+    if (::lstat(socket_path_.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            throw ConfigError("Path exists and is not a socket: " + socket_path_);
+        }
+        int probe = open_socket();
+        bool live = connect_to(probe, addr);
+        ::close(probe);
+        if (live) {
+            throw ConfigError("Socket is already served: " + socket_path_);
+        }
+        ::unlink(socket_path_.c_str());
+    }
+
+    // The server hands out the merged config, secrets from env and .env
+    // included, so only the owner may connect. The mode is set before
+    // listen(), while connection attempts still fail.
+    impl_->listen_fd = open_socket();
+    if (::bind(impl_->listen_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(impl_->listen_fd);
+        throw ConfigError("Cannot listen on " + socket_path_ + ": " + reason);
+    }
+    if (::chmod(socket_path_.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+        ::listen(impl_->listen_fd, SOMAXCONN) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(impl_->listen_fd);
+        ::unlink(socket_path_.c_str());
+        throw ConfigError("Cannot listen on " + socket_path_ + ": " + reason);
+    }
+    set_nonblocking(impl_->listen_fd);
+
+    int pipe_fds[2];
+    if (::pipe(pipe_fds) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(impl_->listen_fd);
+        ::unlink(socket_path_.c_str());
+        throw ConfigError("Cannot create wake-up pipe: " + reason);
+    }
+    impl_->wake_read = pipe_fds[0];
+    impl_->wake_write = pipe_fds[1];
+    for (int fd : pipe_fds) {
+        set_cloexec(fd);
+        set_nonblocking(fd);
+    }
+
+    impl_->poller.add(impl_->listen_fd);
+    impl_->poller.add(impl_->wake_read);
+}
+
+ConfigServer::~ConfigServer() {
+    for (const auto& entry : impl_->connections) {
+        ::close(entry.first);
+    }
+    ::close(impl_->listen_fd);
+    ::close(impl_->wake_read);
+    ::close(impl_->wake_write);
+    ::unlink(socket_path_.c_str());
+}
+
+void ConfigServer::set_tick(std::chrono::milliseconds interval, std::function<void()> on_tick) {
+    impl_->tick_interval = interval;
+    impl_->on_tick = std::move(on_tick);
+}
+
+void ConfigServer::run() {
+    using Clock = std::chrono::steady_clock;
+    Impl& s = *impl_;
+    auto next_tick = Clock::now() + s.tick_interval;
+    std::vector<Ready> ready;
+
+    while (true) {
+        int timeout_ms = -1;
+        if (s.on_tick) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                next_tick - Clock::now()).count();
+            timeout_ms = left > 0 ? static_cast<int>(left) : 0;
+        }
+
+        s.poller.wait(ready, timeout_ms);
+        for (const Ready& r : ready) {
+            if (r.fd == s.wake_read) {
+                char drain[64];
+                while (::read(s.wake_read, drain, sizeof(drain)) > 0) {}
+                return;
+            }
+            if (r.fd == s.listen_fd) {
+                s.accept_all();
+                continue;
+            }
+            auto it = s.connections.find(r.fd);
+            if (it != s.connections.end() && !s.service(r.fd, it->second, r.readable)) {
+                s.close_connection(r.fd);
+            }
+        }
+
+        if (s.on_tick && Clock::now() >= next_tick) {
+            s.on_tick();
+            next_tick = Clock::now() + s.tick_interval;
+        }
+    }
+}
+
+void ConfigServer::stop() noexcept {
+    char byte = 1;
+    ssize_t ignored = ::write(impl_->wake_write, &byte, 1);
+    (void)ignored;
+}
+
+// ============================================================================
+// ConfigClient
+// ============================================================================
+
+ConfigClient::ConfigClient(const std::string& socket_path) {
+    sockaddr_un addr = make_address(socket_path);
+    fd_ = open_socket();
+    if (!connect_to(fd_, addr)) {
+        std::string reason = std::strerror(errno);
+        ::close(fd_);
+        throw ConfigError("Cannot connect to " + socket_path + ": " + reason);
+    }
+}
+
+ConfigClient::~ConfigClient() {
+    ::close(fd_);
+}
+
+std::string ConfigClient::request_line(std::string_view line) {
+    std::string out(line);
+    out += '\n';
+    if (!send_some(fd_, out) || !out.empty()) {
+        throw ConfigError(std::string("Failed to send request: ") + std::strerror(errno));
+    }
+
+    size_t nl;
+    while ((nl = buffer_.find('\n')) == std::string::npos) {
+        char buf[4096];
+        ssize_t n = ::read(fd_, buf, sizeof(buf));
+        if (n > 0) {
+            buffer_.append(buf, static_cast<size_t>(n));
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            throw ConfigError("Server closed the connection");
+        }
+    }
+
+    std::string response = buffer_.substr(0, nl);
+    buffer_.erase(0, nl + 1);
+    return response;
+}
+
+Value ConfigClient::request(const std::vector<std::string>& words) {
+    std::string response = request_line(join_command_line(words));
+    try {
+        return Value::parse(response);
+    } catch (const nlohmann::json::parse_error& e) {
+        throw ConfigError(std::string("Malformed server response: ") + e.what());
+    }
+}
+
+#else  // _WIN32
+
+struct ConfigServer::Impl {};
+
+ConfigServer::ConfigServer(std::string socket_path, Handler)
+    : socket_path_(std::move(socket_path))
+{
+    throw ConfigError("ConfigServer requires Unix domain sockets (POSIX only)");
+}
+
+ConfigServer::~ConfigServer() = default;
+void ConfigServer::set_tick(std::chrono::milliseconds, std::function<void()>) {}
+void ConfigServer::run() {}
+void ConfigServer::stop() noexcept {}
+
+ConfigClient::ConfigClient(const std::string&) {
+    throw ConfigError("ConfigClient requires Unix domain sockets (POSIX only)");
+}
+
+ConfigClient::~ConfigClient() = default;
+
+std::string ConfigClient::request_line(std::string_view) { return {}; }
+Value ConfigClient::request(const std::vector<std::string>&) { return {}; }
+
+#endif
+
+} // namespace confy
@@ -8,6 +8,53 @@
 
 namespace confy {
 
+LeafRange::iterator::iterator(const Value& root) {
+    if (root.is_object()) {
+        frames_.push_back({root.cbegin(), root.cend(), 0});
+        settle();
+    }
+}
+
+LeafRange::iterator& LeafRange::iterator::operator++() {
+    ++frames_.back().it;
+    settle();
+    return *this;
+}
+
+void LeafRange::iterator::settle() {
+    // Advance to the next non-object value, descending and unwinding as needed
+    while (!frames_.empty()) {
+        Frame& top = frames_.back();
+        if (top.it == top.end) {
+            frames_.pop_back();
+            if (!frames_.empty()) {
+                ++frames_.back().it;
+            }
+            continue;
+        }
+
+        path_.resize(top.mark);
+        if (top.mark != 0) {
+            path_ += '.';
+        }
+        path_ += top.it.key();
+
+        const Value& value = *top.it;
+        if (!value.is_object()) {
+            return;
+        }
+        frames_.push_back({value.cbegin(), value.cend(), path_.size()});
+    }
+}
+
+bool LeafRange::iterator::operator==(const iterator& other) const {
+    if (frames_.empty() || other.frames_.empty()) {
+        return frames_.empty() && other.frames_.empty();
+    }
+    return frames_.size() == other.frames_.size() &&
+           frames_.back().it == other.frames_.back().it;
+}
+
 std::vector<std::pair<std::string, Value>>
 flatten_to_dotpaths(const Value& data, const std::string& prefix) {
     std::vector<std::pair<std::string, Value>> result;
@@ -18,20 +65,11 @@ flatten_to_dotpaths(const Value& data, const std::string& prefix) {
         return result;
     }
 
-    // Recursively flatten object
-    for (auto it = data.begin(); it != data.end(); ++it) {
-        const auto& key = it.key();
-        const auto& value = it.value();
-
-        std::string new_prefix = prefix.empty() ? key : prefix + "." + key;
-
-        if (value.is_object()) {
-            // Recurse into nested object
-            auto nested = flatten_to_dotpaths(value, new_prefix);
-            result.insert(result.end(), nested.begin(), nested.end());
+    for (const auto& [path, value] : leaves(data)) {
+        if (prefix.empty()) {
+            result.emplace_back(std::string(path), value);
         } else {
-            // Leaf value
-            result.emplace_back(new_prefix, value);
+            result.emplace_back(prefix + "." + std::string(path), value);
         }
     }
 
@@ -39,13 +77,12 @@ flatten_to_dotpaths(const Value& data, const std::string& prefix) {
 }
 
 Value overrides_dict_to_value(const std::unordered_map<std::string, Value>& overrides) {
-    Value result = Value::object();
-
+    TreeBuilder tree;
+    tree.reserve(overrides.size());
     for (const auto& [path, value] : overrides) {
-        set_by_dot(result, path, value, true);
+        tree.add(path, value);
     }
-
-    return result;
+    return tree.build();
 }
 
 } // namespace confy
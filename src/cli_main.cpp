@@ -3,7 +3,7 @@
  * @brief CLI tool entry point (Phase 4)
  *
  * Command-line interface for confy-cpp.
- * Provides: get, set, exists, search, dump, convert commands.
+ * Provides: get, set, exists, explain, search, dump, convert, batch, serve commands.
  *
  * Usage:
  *   confy-cpp [GLOBAL OPTIONS] COMMAND [ARGS]
@@ -16,15 +16,19 @@
  *   --mandatory TEXT       Comma-separated mandatory keys
  *   --dotenv-path PATH     Explicit .env file path
  *   --no-dotenv            Disable .env loading
+ *   --socket PATH          Unix socket of a running server (client mode)
  *   -h, --help             Show help
  *
  * Commands:
- *   get KEY                Get value at dot-path
- *   set KEY VALUE          Set value in config file
+ *   get KEY [KEY...]       Get value(s) at dot-path(s)
+ *   set KEY VALUE [...]    Set value(s) in config file
  *   exists KEY             Check if key exists
+ *   explain KEY            Show which source set each value at KEY
  *   search [OPTIONS]       Search keys/values
  *   dump                   Print entire config
  *   convert --to FORMAT    Convert to JSON/TOML
+ *   batch [FILE]           Run many commands, one JSON result per line
+ *   serve --socket PATH    Serve lookups over a Unix socket
  *
  * @see CONFY_DESIGN_SPECIFICATION.md Section 6
  * @copyright (c) 2026. MIT License.
@@ -37,14 +41,25 @@
 #include "confy/DotPath.hpp"
 #include "confy/Parse.hpp"
 #include "confy/Errors.hpp"
+#include "confy/FileEdit.hpp"
+#include "confy/Server.hpp"
+#include "confy/Pattern.hpp"
+#include "confy/PathIndex.hpp"
+#include "confy/ConfigWatcher.hpp"
+#include "confy/Util.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <regex>
 #include <algorithm>
 #include <cctype>
 #include <filesystem>
+#include <csignal>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
 
 namespace fs = std::filesystem;
 
@@ -218,133 +233,84 @@ confy::Value load_defaults_file(const std::string& path) {
 }
 
 /**
- * @brief Flatten nested config to dot-path -> value map.
+ * @brief Collect the entries whose key and value match the patterns.
+ *
+ * Patterns are compiled once (see confy::Pattern) and the key pattern
+ * first narrows the candidates through the index. Large candidate sets
+ * are scanned on several threads; the result does not depend on it.
+ *
+ * @return Matches as a nested object (empty if none)
  */
-std::vector<std::pair<std::string, confy::Value>> flatten_config(
-    const confy::Value& data,
-    const std::string& prefix = ""
-) {
-    std::vector<std::pair<std::string, confy::Value>> result;
-
-    if (!data.is_object()) {
-        if (!prefix.empty()) {
-            result.emplace_back(prefix, data);
-        }
-        return result;
-    }
-
-    for (auto it = data.begin(); it != data.end(); ++it) {
-        std::string key = prefix.empty() ? it.key() : prefix + "." + it.key();
-
-        if (it.value().is_object()) {
-            auto nested = flatten_config(it.value(), key);
-            result.insert(result.end(), nested.begin(), nested.end());
-        } else {
-            result.emplace_back(key, it.value());
+confy::Value search_config(const confy::PathIndex& index,
+                           const std::string& key_pattern,
+                           const std::string& val_pattern,
+                           bool ignore_case) {
+    std::optional<confy::Pattern> key_re;
+    std::optional<confy::Pattern> val_re;
+    if (!key_pattern.empty()) key_re.emplace(key_pattern, ignore_case);
+    if (!val_pattern.empty()) val_re.emplace(val_pattern, ignore_case);
+
+    const auto& entries = index.entries();
+    std::vector<size_t> candidates;
+    if (key_re) {
+        candidates = index.candidates(*key_re);
+    } else {
+        candidates.resize(entries.size());
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            candidates[i] = i;
         }
     }
 
-    return result;
-}
-
-/**
- * @brief Match text against pattern (glob, regex, or exact).
- *
- * Pattern detection:
- * - Contains *, ?, [ or ] -> glob
- * - Contains regex special chars -> regex
- * - Otherwise -> exact substring match
- */
-bool match_pattern(const std::string& pattern, const std::string& text, bool ignore_case) {
-    std::string pat = ignore_case ? to_lower(pattern) : pattern;
-    std::string txt = ignore_case ? to_lower(text) : text;
-
-    // 1. Glob pattern?
-    if (pat.find('*') != std::string::npos ||
-        pat.find('?') != std::string::npos ||
-        pat.find('[') != std::string::npos) {
-
-        // Convert glob to regex
-        std::string regex_pat;
-        for (char c : pat) {
-            switch (c) {
-                case '*': regex_pat += ".*"; break;
-                case '?': regex_pat += "."; break;
-                case '.': regex_pat += "\\."; break;
-                case '[': regex_pat += "["; break;
-                case ']': regex_pat += "]"; break;
-                case '(': regex_pat += "\\("; break;
-                case ')': regex_pat += "\\)"; break;
-                case '+': regex_pat += "\\+"; break;
-                case '^': regex_pat += "\\^"; break;
-                case '$': regex_pat += "\\$"; break;
-                case '|': regex_pat += "\\|"; break;
-                case '\\': regex_pat += "\\\\"; break;
-                default: regex_pat += c; break;
+    std::vector<char> hit(candidates.size(), 0);
+    auto scan = [&](size_t begin, size_t end) {
+        std::string dumped;
+        for (size_t i = begin; i < end; ++i) {
+            const auto& [k, v] = entries[candidates[i]];
+            if (key_re && !key_re->matches(k)) {
+                continue;
             }
+            if (val_re) {
+                std::string_view text;
+                if (v->is_string()) {
+                    text = v->get_ref<const std::string&>();
+                } else {
+                    dumped = v->dump();
+                    text = dumped;
+                }
+                if (!val_re->matches(text)) {
+                    continue;
+                }
+            }
+            hit[i] = 1;
         }
-
-        try {
-            std::regex re("^" + regex_pat + "$");
-            return std::regex_match(txt, re);
-        } catch (const std::regex_error&) {
-            // Fallback to exact match if regex fails
-            return txt.find(pat) != std::string::npos;
+    };
+
+    // Split the scan only when each thread gets a worthwhile share
+    constexpr size_t MIN_ENTRIES_PER_THREAD = 16384;
+    size_t threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                      candidates.size() / MIN_ENTRIES_PER_THREAD);
+    if (threads <= 1) {
+        scan(0, candidates.size());
+    } else {
+        std::vector<std::thread> workers;
+        size_t chunk = (candidates.size() + threads - 1) / threads;
+        for (size_t begin = 0; begin < candidates.size(); begin += chunk) {
+            workers.emplace_back(scan, begin, std::min(candidates.size(), begin + chunk));
         }
-    }
-
-    // 2. Regex pattern? (contains regex-specific chars)
-    if (pat.find('^') != std::string::npos ||
-        pat.find('$') != std::string::npos ||
-        pat.find('|') != std::string::npos ||
-        pat.find('(') != std::string::npos ||
-        pat.find('+') != std::string::npos) {
-
-        try {
-            std::regex re(pat);
-            return std::regex_search(txt, re);
-        } catch (const std::regex_error&) {
-            // Fallback to exact match
-            return txt.find(pat) != std::string::npos;
+        for (auto& w : workers) {
+            w.join();
         }
     }
 
-    // 3. Exact substring match
-    return txt.find(pat) != std::string::npos;
-}
-
-/**
- * @brief Get file extension (lowercase).
- */
-std::string get_extension(const std::string& path) {
-    fs::path p(path);
-    std::string ext = p.extension().string();
-    return to_lower(ext);
-}
-
-/**
- * @brief Write JSON to file.
- */
-void write_json_file(const std::string& path, const confy::Value& data) {
-    std::ofstream file(path);
-    if (!file) {
-        throw std::runtime_error("Cannot open file for writing: " + path);
-    }
-    file << data.dump(2) << std::endl;
-}
-
-/**
- * @brief Write TOML to file (using confy's to_toml).
- */
-void write_toml_file(const std::string& path, const confy::Value& data) {
-    std::ofstream file(path);
-    if (!file) {
-        throw std::runtime_error("Cannot open file for writing: " + path);
+    // Build nested structure for output
+    confy::Value matches = confy::Value::object();
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (hit[i]) {
+            const auto& entry = entries[candidates[i]];
+            confy::set_by_dot(matches, std::string(entry.path), *entry.value, true);
+        }
     }
-
-    // Use Config's to_toml method
-    confy::Config cfg(data);
-    file << cfg.to_toml();
+    return matches;
 }
 
 } // anonymous namespace
@@ -372,61 +338,71 @@ int cmd_get(confy::Config& cfg, const std::string& key) {
 }
 
 /**
- * @brief CMD: set KEY VALUE
- * Update a key in the source config file.
+ * @brief CMD: get KEY KEY...
+ * Print the requested values as one JSON object keyed by dot-path.
+ * All keys are resolved in a single traversal.
  */
-int cmd_set(const std::string& file_path, const std::string& key, const std::string& value_str) {
+int cmd_get_many(confy::Config& cfg, const std::vector<std::string>& keys) {
+    auto results = cfg.get_many(keys);
+
+    confy::Value out = confy::Value::object();
+    int rc = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        switch (results[i].status) {
+            case confy::LookupStatus::Found:
+                out[keys[i]] = std::move(results[i].value);
+                break;
+            case confy::LookupStatus::Missing:
+                std::cerr << color::yellow("Key not found: " + keys[i]) << std::endl;
+                rc = 1;
+                break;
+            case confy::LookupStatus::TypeMismatch:
+                std::cerr << color::red("Error: ") << "Cannot traverse into non-container at path '"
+                          << keys[i] << "'" << std::endl;
+                rc = 1;
+                break;
+        }
+    }
+
+    std::cout << out.dump(2) << std::endl;
+    return rc;
+}
+
+/**
+ * @brief CMD: set KEY VALUE [KEY VALUE...]
+ * Update keys in the source config file. Values are patched in place
+ * where possible and the file is always replaced atomically.
+ */
+int cmd_set(const std::string& file_path, const std::vector<std::string>& args) {
     if (file_path.empty()) {
         std::cerr << color::red("Error: --config/-c is required for 'set' command") << std::endl;
         return 1;
     }
 
-    // Load existing file
-    confy::Value data;
-    std::string ext = get_extension(file_path);
+    // Parse the values
+    std::vector<std::pair<std::string, confy::Value>> assignments;
+    for (size_t i = 0; i + 1 < args.size(); i += 2) {
+        assignments.emplace_back(args[i], confy::parse_value(args[i + 1]));
+    }
 
+    // Apply all assignments with a single read and a single write
     try {
-        if (ext == ".json") {
-            data = confy::load_json_file(file_path);
-        } else if (ext == ".toml") {
-            data = confy::load_toml_file(file_path);
-        } else {
-            std::cerr << color::red("Error: Unsupported file format: " + ext) << std::endl;
-            return 1;
-        }
-    } catch (const confy::FileNotFoundError&) {
-        // Create new file
-        data = confy::Value::object();
-    } catch (const std::exception& e) {
+        confy::update_config_file(file_path, assignments);
+    } catch (const confy::ConfigParseError& e) {
         std::cerr << color::red("Error loading file: ") << e.what() << std::endl;
         return 1;
-    }
-
-    // Parse the value
-    confy::Value parsed_value = confy::parse_value(value_str);
-
-    // Set the value
-    try {
-        confy::set_by_dot(data, key, parsed_value, true);
-    } catch (const std::exception& e) {
-        std::cerr << color::red("Error setting value: ") << e.what() << std::endl;
+    } catch (const confy::ConfigError& e) {
+        std::cerr << color::red("Error: ") << e.what() << std::endl;
         return 1;
-    }
-
-    // Write back
-    try {
-        if (ext == ".json") {
-            write_json_file(file_path, data);
-        } else if (ext == ".toml") {
-            write_toml_file(file_path, data);
-        }
     } catch (const std::exception& e) {
         std::cerr << color::red("Error writing file: ") << e.what() << std::endl;
         return 1;
     }
 
-    std::cout << "Set " << key << " = " << parsed_value.dump()
-              << " in " << file_path << std::endl;
+    for (const auto& [key, value] : assignments) {
+        std::cout << "Set " << key << " = " << value.dump()
+                  << " in " << file_path << std::endl;
+    }
     return 0;
 }
 
@@ -446,6 +422,43 @@ int cmd_exists(confy::Config& cfg, const std::string& key) {
     }
 }
 
+/**
+ * @brief CMD: explain KEY
+ * Print each leaf at or below KEY with the source that set it.
+ * The config must be loaded with origin tracking.
+ */
+int cmd_explain(const confy::Config& cfg, const std::string& key) {
+    confy::LookupResult found = cfg.find(key);
+    if (found.status == confy::LookupStatus::TypeMismatch) {
+        std::cerr << color::red("Error: ") << found.message(key) << std::endl;
+        return 1;
+    }
+    if (!found) {
+        std::cerr << color::yellow("Key not found: " + key) << std::endl;
+        return 1;
+    }
+
+    auto explain = [&cfg](const std::string& path, const confy::Value& value) {
+        auto origin = cfg.origin(path);
+        std::cout << path << " = " << value.dump() << "  <- "
+                  << (origin ? origin->to_string() : "unknown") << "\n";
+    };
+
+    if (!found.value->is_object()) {
+        explain(key, *found.value);
+        return 0;
+    }
+    bool any = false;
+    for (const auto& [path, value] : confy::leaves(*found.value)) {
+        explain(key + "." + std::string(path), value);
+        any = true;
+    }
+    if (!any) {
+        std::cout << key << " = {}\n";
+    }
+    return 0;
+}
+
 /**
  * @brief CMD: search [--key PAT] [--val PAT] [-i]
  * Search for keys/values matching patterns.
@@ -460,26 +473,8 @@ int cmd_search(confy::Config& cfg,
         return 1;
     }
 
-    // Flatten config
-    auto flat = flatten_config(cfg.data());
-
-    // Find matches
-    confy::Value matches = confy::Value::object();
-
-    for (const auto& [k, v] : flat) {
-        bool key_match = key_pattern.empty() || match_pattern(key_pattern, k, ignore_case);
-
-        bool val_match = true;
-        if (!val_pattern.empty() && key_match) {
-            std::string val_str = v.is_string() ? v.get<std::string>() : v.dump();
-            val_match = match_pattern(val_pattern, val_str, ignore_case);
-        }
-
-        if (key_match && val_match) {
-            // Build nested structure for output
-            confy::set_by_dot(matches, k, v, true);
-        }
-    }
+    confy::PathIndex index(cfg);
+    confy::Value matches = search_config(index, key_pattern, val_pattern, ignore_case);
 
     if (matches.empty()) {
         std::cout << "No matches found." << std::endl;
@@ -495,7 +490,8 @@ int cmd_search(confy::Config& cfg,
  * Pretty-print entire config as JSON.
  */
 int cmd_dump(confy::Config& cfg) {
-    std::cout << cfg.to_json(2) << std::endl;
+    cfg.to_json(std::cout, 2);
+    std::cout << std::endl;
     return 0;
 }
 
@@ -508,31 +504,342 @@ int cmd_convert(confy::Config& cfg,
                 const std::string& output_file) {
 
     std::string fmt = to_lower(format);
-    std::string output;
 
-    if (fmt == "json") {
-        output = cfg.to_json(2);
-    } else if (fmt == "toml") {
-        output = cfg.to_toml();
-    } else {
+    if (fmt != "json" && fmt != "toml") {
         std::cerr << color::red("Error: Unknown format '" + format + "'. Use 'json' or 'toml'.") << std::endl;
         return 1;
     }
 
+    // Write to stdout, or to file
+    std::ofstream file;
+    std::ostream* out = &std::cout;
+    if (!output_file.empty()) {
+        file.open(output_file);
+        if (!file) {
+            std::cerr << color::red("Error: Cannot open file for writing: " + output_file) << std::endl;
+            return 1;
+        }
+        out = &file;
+    }
+
+    if (fmt == "json") {
+        cfg.to_json(*out, 2);
+    } else {
+        cfg.to_toml(*out);
+    }
+
     if (output_file.empty()) {
-        // Write to stdout
-        std::cout << output << std::endl;
+        std::cout << std::endl;
     } else {
-        // Write to file
-        std::ofstream file(output_file);
+        std::cout << "Wrote " << fmt << " output to " << output_file << std::endl;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Execute one batch or server command against the loaded config.
+ * @param opts Options @p cfg was loaded with; 'set' writes opts.file_path
+ *        and reloads from them
+ * @param index Path index of @p cfg, built by the first search and
+ *        reset whenever @p cfg changes
+ * @param read_only Reject 'set' (used by 'serve')
+ * @return Result object: {"ok": true, "value": ...} (value omitted for set).
+ *         A failed 'get' also lists its keys under "missing" (not found)
+ *         and "type_errors" (key -> message), so a client can report
+ *         them as the local get does.
+ * @throws std::exception on any failure (reported by the caller)
+ */
+confy::Value run_batch_command(confy::Config& cfg,
+                               const confy::LoadOptions& opts,
+                               std::optional<confy::PathIndex>& index,
+                               const std::vector<std::string>& words,
+                               bool read_only = false) {
+    std::string cmd = to_lower(words[0]);
+    std::vector<std::string> args(words.begin() + 1, words.end());
+    confy::Value result = {{"ok", true}};
+
+    if (cmd == "get") {
+        if (args.empty()) {
+            throw std::runtime_error("'get' requires KEY argument");
+        }
+        if (args.size() == 1) {
+            try {
+                result["value"] = cfg.get(args[0]);
+            } catch (const confy::KeyError& e) {
+                result = {{"ok", false}, {"error", e.what()},
+                          {"missing", confy::Value::array({args[0]})}};
+            } catch (const confy::TypeError& e) {
+                result = {{"ok", false}, {"error", e.what()},
+                          {"type_errors", {{args[0], e.what()}}}};
+            }
+            return result;
+        }
+
+        // Several keys: one traversal, report all missing ones
+        auto values = cfg.get_many(args);
+        confy::Value found = confy::Value::object();
+        confy::Value missing = confy::Value::array();
+        confy::Value type_errors = confy::Value::object();
+        std::string failed;
+        for (size_t i = 0; i < args.size(); ++i) {
+            switch (values[i].status) {
+                case confy::LookupStatus::Found:
+                    found[args[i]] = std::move(values[i].value);
+                    continue;
+                case confy::LookupStatus::Missing:
+                    missing.push_back(args[i]);
+                    break;
+                case confy::LookupStatus::TypeMismatch:
+                    type_errors[args[i]] =
+                        "Cannot traverse into non-container at path '" + args[i] + "'";
+                    break;
+            }
+            failed += (failed.empty() ? "" : ", ") + args[i];
+        }
+        result["value"] = std::move(found);
+        if (!failed.empty()) {
+            result["ok"] = false;
+            result["error"] = "Key not found: " + failed;
+            if (!missing.empty()) result["missing"] = std::move(missing);
+            if (!type_errors.empty()) result["type_errors"] = std::move(type_errors);
+        }
+    } else if (cmd == "exists") {
+        if (args.empty()) {
+            throw std::runtime_error("'exists' requires KEY argument");
+        }
+        try {
+            result["value"] = cfg.contains(args[0]);
+        } catch (const confy::TypeError&) {
+            result["value"] = false;
+        }
+    } else if (cmd == "search") {
+        std::string key_pattern;
+        std::string val_pattern;
+        bool ignore_case = false;
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (args[i] == "-i" || args[i] == "--ignore-case") {
+                ignore_case = true;
+            } else if ((args[i] == "--key" || args[i] == "--val") && i + 1 < args.size()) {
+                (args[i] == "--key" ? key_pattern : val_pattern) = args[i + 1];
+                ++i;
+            } else {
+                throw std::runtime_error("Unknown search option: " + args[i]);
+            }
+        }
+        if (key_pattern.empty() && val_pattern.empty()) {
+            throw std::runtime_error("Please supply --key and/or --val pattern");
+        }
+        if (!index) {
+            index.emplace(cfg, /*trigrams=*/true);
+        }
+        result["value"] = search_config(*index, key_pattern, val_pattern, ignore_case);
+    } else if (cmd == "dump") {
+        result["value"] = std::as_const(cfg).data();
+    } else if (cmd == "set") {
+        if (read_only) {
+            throw std::runtime_error("'set' is not available here (read-only)");
+        }
+        if (opts.file_path.empty()) {
+            throw std::runtime_error("--config/-c is required for 'set' command");
+        }
+        if (args.size() < 2 || args.size() % 2 != 0) {
+            throw std::runtime_error("'set' requires KEY VALUE pairs");
+        }
+        std::vector<std::pair<std::string, confy::Value>> assignments;
+        for (size_t i = 0; i < args.size(); i += 2) {
+            assignments.emplace_back(args[i], confy::parse_value(args[i + 1]));
+        }
+        confy::update_config_file(opts.file_path, assignments);
+
+        // Later commands in the batch see what a fresh load would: env
+        // and overrides still take precedence over the file
+        cfg = confy::Config::load(opts);
+        index.reset();
+    } else {
+        throw std::runtime_error("Unknown command: " + words[0]);
+    }
+    return result;
+}
+
+/**
+ * @brief CMD: batch [FILE]
+ * Run newline-delimited commands (get, exists, search, dump, set) against the
+ * config loaded once, printing one JSON result per command.
+ * Reads stdin when FILE is omitted or "-". Blank lines and lines
+ * starting with '#' are skipped.
+ */
+int cmd_batch(confy::Config& cfg,
+              const confy::LoadOptions& opts,
+              const std::string& input_path) {
+    std::ifstream file;
+    std::istream* in = &std::cin;
+    if (!input_path.empty() && input_path != "-") {
+        file.open(input_path);
         if (!file) {
-            std::cerr << color::red("Error: Cannot open file for writing: " + output_file) << std::endl;
+            std::cerr << color::red("Error: Cannot open batch file: " + input_path) << std::endl;
             return 1;
         }
-        file << output;
-        std::cout << "Wrote " << to_lower(format) << " output to " << output_file << std::endl;
+        in = &file;
+    }
+
+    std::optional<confy::PathIndex> index;
+    int rc = 0;
+    std::string line;
+    while (std::getline(*in, line)) {
+        // Comments are free text (quotes need not balance), so skip
+        // them before tokenizing
+        std::string trimmed = trim(line);
+        if (trimmed.empty() || trimmed[0] == '#') {
+            continue;
+        }
+
+        confy::Value result;
+        try {
+            auto words = confy::split_command_line(trimmed);
+            result = run_batch_command(cfg, opts, index, words);
+        } catch (const std::exception& e) {
+            result = {{"ok", false}, {"error", e.what()}};
+        }
+
+        if (!result["ok"].get<bool>()) {
+            rc = 1;
+        }
+        // std::cin is tied to std::cout, so an interactive caller sees
+        // each result before the next line is read
+        std::cout << result.dump() << '\n';
+    }
+    std::cout.flush();
+    return rc;
+}
+
+/**
+ * @brief Server stopped by SIGINT/SIGTERM.
+ */
+confy::ConfigServer* g_server = nullptr;
+
+void stop_server(int) {
+    if (g_server != nullptr) {
+        g_server->stop();
+    }
+}
+
+/**
+ * @brief CMD: serve --socket PATH
+ * Answer get/exists/search/dump requests from the loaded config over a
+ * Unix socket, reloading it when the config file, .env or environment changes.
+ */
+int cmd_serve(const confy::LoadOptions& opts,
+              confy::Config cfg,
+              const std::string& socket_path) {
+    if (socket_path.empty()) {
+        std::cerr << color::red("Error: 'serve' requires --socket PATH") << std::endl;
+        return 1;
+    }
+
+    std::optional<confy::PathIndex> index;
+    auto handler = [&cfg, &opts, &index](std::string_view line) -> std::string {
+        auto words = confy::split_command_line(line);
+        if (words.empty()) {
+            throw std::runtime_error("Empty request");
+        }
+        return run_batch_command(cfg, opts, index, words, true).dump();
+    };
+
+    std::unique_ptr<confy::ConfigServer> server;
+    try {
+        server = std::make_unique<confy::ConfigServer>(socket_path, handler);
+    } catch (const confy::ConfigError& e) {
+        std::cerr << color::red("Error: ") << e.what() << std::endl;
+        return 1;
     }
 
+    // Watch the sources; a failed reload keeps serving the old snapshot
+    confy::ConfigWatcher watcher(opts, cfg);
+    server->set_tick(std::chrono::seconds(1), [&]() {
+        try {
+            if (!watcher.refresh()) {
+                return;
+            }
+            cfg = watcher.config();
+            index.reset();
+            std::cerr << "Reloaded " << opts.file_path << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << color::yellow("Reload failed, keeping previous config: ")
+                      << e.what() << std::endl;
+        }
+    });
+
+    g_server = server.get();
+    std::signal(SIGINT, stop_server);
+    std::signal(SIGTERM, stop_server);
+
+    std::cout << "Serving configuration on " << socket_path << std::endl;
+    server->run();
+
+    g_server = nullptr;
+    return 0;
+}
+
+/**
+ * @brief Client mode: forward a read command to a running 'serve'.
+ * Output and exit codes match the local commands.
+ */
+int cmd_remote(const std::string& socket_path,
+               const std::string& cmd,
+               std::vector<std::string> words) {
+    if (cmd != "get" && cmd != "exists" && cmd != "search" && cmd != "dump") {
+        std::cerr << color::red("Error: '" + cmd + "' is not available with --socket") << std::endl;
+        return 1;
+    }
+    words.insert(words.begin(), cmd);
+
+    confy::Value response;
+    try {
+        confy::ConfigClient client(socket_path);
+        response = client.request(words);
+    } catch (const confy::ConfigError& e) {
+        std::cerr << color::red("Error: ") << e.what() << std::endl;
+        return 1;
+    }
+
+    bool ok = response.value("ok", false);
+    if (cmd == "get" && (ok || response.contains("missing") || response.contains("type_errors"))) {
+        // Same output as cmd_get / cmd_get_many: an error line per failed
+        // key, then the values found (all of them when several were asked)
+        static const confy::Value none = confy::Value::object();
+        const confy::Value& missing = response.contains("missing") ? response["missing"] : none;
+        const confy::Value& type_errors =
+            response.contains("type_errors") ? response["type_errors"] : none;
+        for (auto it = words.begin() + 1; it != words.end(); ++it) {
+            if (std::find(missing.begin(), missing.end(), *it) != missing.end()) {
+                std::cerr << color::yellow("Key not found: " + *it) << std::endl;
+            } else if (type_errors.contains(*it)) {
+                std::cerr << color::red("Error: ")
+                          << type_errors[*it].get<std::string>() << std::endl;
+            }
+        }
+        if (ok || words.size() > 2) {
+            std::cout << response.value("value", confy::Value::object()).dump(2) << std::endl;
+        }
+        return ok ? 0 : 1;
+    }
+
+    if (!ok) {
+        std::cerr << color::red("Error: ") << response.value("error", "request failed") << std::endl;
+        return 1;
+    }
+
+    const confy::Value& value = response["value"];
+    if (cmd == "exists") {
+        std::cout << (value.get<bool>() ? "true" : "false") << std::endl;
+        return value.get<bool>() ? 0 : 1;
+    }
+    if (cmd == "search" && value.empty()) {
+        std::cout << "No matches found." << std::endl;
+        return 1;
+    }
+    std::cout << value.dump(2) << std::endl;
     return 0;
 }
 
@@ -565,6 +872,8 @@ int main(int argc, char** argv) {
                 cxxopts::value<std::string>()->default_value(""))
             ("no-dotenv", "Disable .env file loading",
                 cxxopts::value<bool>()->default_value("false"))
+            ("socket", "Unix socket to serve on, or of a running server (client mode)",
+                cxxopts::value<std::string>()->default_value(""))
             // === Subcommand options (search) ===
             ("key", "Pattern to match against keys (for search)",
                 cxxopts::value<std::string>()->default_value(""))
@@ -597,9 +906,10 @@ int main(int argc, char** argv) {
         if (result.count("help") || result["command"].as<std::string>().empty()) {
             std::cout << options.help() << std::endl;
             std::cout << "Commands:" << std::endl;
-            std::cout << "  get KEY                Get value at dot-path" << std::endl;
-            std::cout << "  set KEY VALUE          Set value in config file" << std::endl;
+            std::cout << "  get KEY [KEY...]       Get value(s) at dot-path(s)" << std::endl;
+            std::cout << "  set KEY VALUE [...]    Set value(s) in config file" << std::endl;
             std::cout << "  exists KEY             Check if key exists (exit 0/1)" << std::endl;
+            std::cout << "  explain KEY            Show the source of each value at KEY" << std::endl;
             std::cout << "  search [OPTIONS]       Search keys/values" << std::endl;
             std::cout << "    --key PATTERN        Pattern to match against keys" << std::endl;
             std::cout << "    --val PATTERN        Pattern to match against values" << std::endl;
@@ -608,13 +918,22 @@ int main(int argc, char** argv) {
             std::cout << "  convert [OPTIONS]      Convert to different format" << std::endl;
             std::cout << "    --to FORMAT          Target format (json or toml)" << std::endl;
             std::cout << "    --out FILE           Output file (default: stdout)" << std::endl;
+            std::cout << "  batch [FILE]           Run get/exists/search/set lines from FILE" << std::endl;
+            std::cout << "                         or stdin; one JSON result per line" << std::endl;
+            std::cout << "  serve --socket PATH    Answer get/exists/search/dump over a Unix socket," << std::endl;
+            std::cout << "                         reloading when its sources change" << std::endl;
+            std::cout << "  With --socket PATH, get/exists/search/dump query a running server." << std::endl;
             std::cout << std::endl;
             std::cout << "Examples:" << std::endl;
             std::cout << "  confy-cpp -c config.toml get database.host" << std::endl;
             std::cout << "  confy-cpp -c config.toml -p MYAPP dump" << std::endl;
             std::cout << "  confy-cpp -c config.json set db.port 5433" << std::endl;
+            std::cout << "  confy-cpp -c config.toml -p MYAPP explain database" << std::endl;
             std::cout << "  confy-cpp -c config.toml search --key 'db.*'" << std::endl;
             std::cout << "  confy-cpp -c config.toml convert --to json --out config.json" << std::endl;
+            std::cout << "  printf 'get db.host\\nexists db.ssl\\n' | confy-cpp -c config.toml batch" << std::endl;
+            std::cout << "  confy-cpp -c config.toml --socket /tmp/confy.sock serve" << std::endl;
+            std::cout << "  confy-cpp --socket /tmp/confy.sock get db.host" << std::endl;
             return result.count("help") ? 0 : 1;
         }
 
@@ -626,6 +945,7 @@ int main(int argc, char** argv) {
         std::string mandatory_str = result["mandatory"].as<std::string>();
         std::string dotenv_path = result["dotenv-path"].as<std::string>();
         bool no_dotenv = result["no-dotenv"].as<bool>();
+        std::string socket_path = result["socket"].as<std::string>();
 
         std::string command = result["command"].as<std::string>();
         std::vector<std::string> args;
@@ -633,6 +953,23 @@ int main(int argc, char** argv) {
             args = result["args"].as<std::vector<std::string>>();
         }
 
+        std::string cmd = to_lower(command);
+
+        // =====================================================================
+        // Client mode: ask a running server instead of loading anything
+        // =====================================================================
+        if (!socket_path.empty() && cmd != "serve") {
+            std::vector<std::string> words = args;
+            if (cmd == "search") {
+                std::string key_pattern = result["key"].as<std::string>();
+                std::string val_pattern = result["val"].as<std::string>();
+                if (!key_pattern.empty()) words.insert(words.end(), {"--key", key_pattern});
+                if (!val_pattern.empty()) words.insert(words.end(), {"--val", val_pattern});
+                if (result["ignore-case"].as<bool>()) words.push_back("-i");
+            }
+            return cmd_remote(socket_path, cmd, std::move(words));
+        }
+
         // =====================================================================
         // Build LoadOptions
         // =====================================================================
@@ -657,6 +994,9 @@ int main(int argc, char** argv) {
         // Parse mandatory keys
         opts.mandatory = parse_list(mandatory_str);
 
+        // Only explain reads the per-key origins
+        opts.track_origins = (cmd == "explain");
+
         // =====================================================================
         // Load configuration
         // =====================================================================
@@ -677,21 +1017,23 @@ int main(int argc, char** argv) {
         // =====================================================================
         // Dispatch command
         // =====================================================================
-        std::string cmd = to_lower(command);
 
         if (cmd == "get") {
             if (args.empty()) {
                 std::cerr << color::red("Error: 'get' requires KEY argument") << std::endl;
                 return 1;
             }
+            if (args.size() > 1) {
+                return cmd_get_many(cfg, args);
+            }
             return cmd_get(cfg, args[0]);
         }
         else if (cmd == "set") {
-            if (args.size() < 2) {
-                std::cerr << color::red("Error: 'set' requires KEY and VALUE arguments") << std::endl;
+            if (args.size() < 2 || args.size() % 2 != 0) {
+                std::cerr << color::red("Error: 'set' requires KEY VALUE pairs") << std::endl;
                 return 1;
             }
-            return cmd_set(config_path, args[0], args[1]);
+            return cmd_set(config_path, args);
         }
         else if (cmd == "exists") {
             if (args.empty()) {
@@ -700,6 +1042,13 @@ int main(int argc, char** argv) {
             }
             return cmd_exists(cfg, args[0]);
         }
+        else if (cmd == "explain") {
+            if (args.size() != 1) {
+                std::cerr << color::red("Error: 'explain' requires one KEY argument") << std::endl;
+                return 1;
+            }
+            return cmd_explain(cfg, args[0]);
+        }
         else if (cmd == "search") {
             // Get search options from parsed cxxopts result
             std::string key_pattern = result["key"].as<std::string>();
@@ -723,6 +1072,16 @@ int main(int argc, char** argv) {
 
             return cmd_convert(cfg, format, output_file);
         }
+        else if (cmd == "batch") {
+            if (args.size() > 1) {
+                std::cerr << color::red("Error: 'batch' takes at most one FILE argument") << std::endl;
+                return 1;
+            }
+            return cmd_batch(cfg, opts, args.empty() ? "" : args[0]);
+        }
+        else if (cmd == "serve") {
+            return cmd_serve(opts, std::move(cfg), socket_path);
+        }
         else {
             std::cerr << color::red("Unknown command: " + command) << std::endl;
             std::cerr << "Use --help for available commands." << std::endl;
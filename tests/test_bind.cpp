@@ -0,0 +1,171 @@
+/**
+ * @file test_bind.cpp
+ * @brief Unit tests for typed struct binding (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/Bind.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace confy;
+
+namespace {
+
+struct DbSettings {
+    std::string host;
+    int port = 5432;
+    int pool_max = 16;
+    int pool_min = 1;
+    bool ssl = false;
+    std::vector<std::string> replicas;
+    std::string first_replica;
+};
+
+struct RequiredSettings {
+    std::string host;
+    int port = 0;
+    std::string user;
+};
+
+} // anonymous namespace
+
+template<>
+struct confy::Binding<DbSettings> {
+    static constexpr auto fields = std::make_tuple(
+        bind_required("database.host", &DbSettings::host),
+        bind_field("database.port", &DbSettings::port),
+        bind_field("database.pool.max", &DbSettings::pool_max),
+        bind_field("database.pool.min", &DbSettings::pool_min),
+        bind_field("database.ssl", &DbSettings::ssl),
+        bind_field("database.replicas", &DbSettings::replicas),
+        bind_field("database.replicas.0", &DbSettings::first_replica));
+};
+
+template<>
+struct confy::Binding<RequiredSettings> {
+    static constexpr auto fields = std::make_tuple(
+        bind_required("server.host", &RequiredSettings::host),
+        bind_required("server.port", &RequiredSettings::port),
+        bind_required("auth.user", &RequiredSettings::user));
+};
+
+TEST(Bind, PopulatesFields) {
+    Config cfg(Value{
+        {"database", {
+            {"host", "db.local"},
+            {"pool", {{"max", 32}}},
+            {"ssl", true},
+            {"replicas", {"r1", "r2"}}
+        }}
+    });
+
+    auto db = bind_config<DbSettings>(cfg);
+
+    EXPECT_EQ(db.host, "db.local");
+    EXPECT_EQ(db.port, 5432);      // missing optional keeps default
+    EXPECT_EQ(db.pool_max, 32);
+    EXPECT_EQ(db.pool_min, 1);
+    EXPECT_TRUE(db.ssl);
+    EXPECT_EQ(db.replicas, (std::vector<std::string>{"r1", "r2"}));
+    EXPECT_EQ(db.first_replica, "r1");
+}
+
+TEST(Bind, MatchesConfigGet) {
+    Config cfg(Value{{"database", {{"host", "h"}, {"port", 1}, {"pool", {{"max", 2}, {"min", 3}}}}}});
+
+    auto db = bind_config<DbSettings>(cfg);
+
+    EXPECT_EQ(db.port, cfg.get<int>("database.port", 0));
+    EXPECT_EQ(db.pool_max, cfg.get<int>("database.pool.max", 0));
+    EXPECT_EQ(db.pool_min, cfg.get<int>("database.pool.min", 0));
+}
+
+TEST(Bind, TypeMismatchThrowsTypeError) {
+    Config cfg(Value{{"database", {{"host", "h"}, {"port", "not a number"}}}});
+
+    try {
+        bind_config<DbSettings>(cfg);
+        FAIL() << "Expected TypeError";
+    } catch (const TypeError& e) {
+        EXPECT_EQ(e.path(), "database.port");
+    }
+}
+
+TEST(Bind, TraversalIntoScalarThrowsTypeError) {
+    // RULE D2: optional field still raises on traversal into non-container
+    Config cfg(Value{{"database", {{"host", "h"}, {"pool", 5}}}});
+
+    EXPECT_THROW(bind_config<DbSettings>(cfg), TypeError);
+}
+
+TEST(Bind, CollectsAllMissingRequired) {
+    Config cfg(Value{{"server", {{"port", 80}}}, {"auth", "flat"}});
+
+    try {
+        bind_config<RequiredSettings>(cfg);
+        FAIL() << "Expected MissingMandatoryConfig";
+    } catch (const MissingMandatoryConfig& e) {
+        // Declaration order; RULE M3 for auth.user
+        EXPECT_EQ(e.missing_keys(),
+                  (std::vector<std::string>{"server.host", "auth.user"}));
+    }
+}
+
+TEST(Bind, RebindUpdatesInPlace) {
+    Config v1(Value{{"database", {{"host", "a"}, {"port", 1}}}});
+    Config v2(Value{{"database", {{"host", "b"}}}});
+
+    DbSettings db;
+    bind_config(v1, db);
+    EXPECT_EQ(db.host, "a");
+    EXPECT_EQ(db.port, 1);
+
+    bind_config(v2, db);
+    EXPECT_EQ(db.host, "b");
+    EXPECT_EQ(db.port, 1);  // missing optional keeps current value
+}
+
+TEST(Bind, FailedRebindLeavesStructUnchanged) {
+    Config good(Value{{"database", {{"host", "a"}, {"port", 1}}}});
+    Config bad(Value{{"database", {{"port", 2}}}});
+
+    DbSettings db;
+    bind_config(good, db);
+    EXPECT_THROW(bind_config(bad, db), MissingMandatoryConfig);
+    EXPECT_EQ(db.host, "a");
+    EXPECT_EQ(db.port, 1);
+}
+
+TEST(BindPlan, ResolvesSharedPrefixes) {
+    BindPlan plan({"a.b.c", "a", "a.b", "a.x", "z", "a.b.c.d", "l.1"});
+    Value root = {{"a", {{"b", {{"c", 1}}}, {"x", 2}}}, {"l", {10, 20}}};
+
+    std::vector<BindPlan::Slot> slots;
+    plan.resolve(root, slots);
+
+    ASSERT_EQ(slots.size(), 7u);
+    EXPECT_EQ(*slots[0].value, 1);
+    EXPECT_EQ(slots[1].value, &root["a"]);
+    EXPECT_EQ(slots[2].value, &root["a"]["b"]);
+    EXPECT_EQ(*slots[3].value, 2);
+    EXPECT_EQ(slots[4].value, nullptr);
+    EXPECT_EQ(slots[4].blocked_by, nullptr);
+    EXPECT_EQ(slots[5].value, nullptr);
+    EXPECT_EQ(slots[5].blocked_by, &root["a"]["b"]["c"]);
+    EXPECT_EQ(*slots[6].value, 20);
+}
+
+TEST(BindPlan, OversizedIndexIsMissing) {
+    BindPlan plan({"l.99999999999999999999999", "l.0"});
+    Value root = {{"l", {10}}};
+
+    std::vector<BindPlan::Slot> slots;
+    plan.resolve(root, slots);
+
+    ASSERT_EQ(slots.size(), 2u);
+    EXPECT_EQ(slots[0].value, nullptr);
+    EXPECT_EQ(slots[0].blocked_by, nullptr);
+    EXPECT_EQ(*slots[1].value, 10);
+}
@@ -29,6 +29,8 @@
 #include <fstream>
 #include <cstdlib>
 #include <filesystem>
+#include <sstream>
+#include <utility>
 
 namespace fs = std::filesystem;
 using namespace confy;
@@ -111,7 +113,7 @@ TEST(ConfigConstruction, DefaultConstructor) {
     Config cfg;
     EXPECT_TRUE(cfg.empty());
     EXPECT_EQ(cfg.size(), 0);
-    EXPECT_TRUE(cfg.data().is_object());
+    EXPECT_TRUE(std::as_const(cfg).data().is_object());
 }
 
 TEST(ConfigConstruction, ConstructFromValue) {
@@ -402,6 +404,47 @@ TEST(ConfigSerialization, ToJsonCompact) {
     EXPECT_EQ(compact.find('\n'), std::string::npos);
 }
 
+TEST(ConfigSerialization, ToJsonStreamMatchesString) {
+    Config cfg(Value{
+        {"string", "h\u00e9llo \"quoted\""},
+        {"list", {1, 2.5, nullptr, true}},
+        {"nested", {{"key", "value"}, {"empty", Value::object()}}}
+    });
+
+    for (int indent : {-1, 0, 2, 4}) {
+        std::ostringstream out;
+        cfg.to_json(out, indent);
+        EXPECT_EQ(out.str(), cfg.to_json(indent)) << indent;
+    }
+}
+
+TEST(ConfigSerialization, ToJsonSinkChunks) {
+    Value big = Value::object();
+    for (int i = 0; i < 5000; ++i) {
+        big["key_" + std::to_string(i)] = std::string(20, 'x');
+    }
+    big["long"] = std::string(100000, 'y');
+    Config cfg(big);
+
+    std::string collected;
+    size_t chunks = 0;
+    cfg.to_json([&](const char* data, size_t size) {
+        collected.append(data, size);
+        ++chunks;
+    }, -1);
+
+    EXPECT_EQ(collected, cfg.to_json(-1));
+    EXPECT_GT(chunks, 1u);
+}
+
+TEST(ConfigSerialization, ToJsonSinkExceptionPropagates) {
+    Config cfg(Value{{"key", "value"}});
+
+    EXPECT_THROW(cfg.to_json([](const char*, size_t) {
+        throw std::runtime_error("sink failed");
+    }), std::runtime_error);
+}
+
 TEST(ConfigSerialization, ToToml) {
     Config cfg(Value{
         {"string", "hello"},
@@ -416,6 +459,88 @@ TEST(ConfigSerialization, ToToml) {
     EXPECT_NE(toml.find("42"), std::string::npos);
 }
 
+TEST(ConfigSerialization, ToTomlLayout) {
+    Config cfg(Value{
+        {"name", "app"},
+        {"nothing", nullptr},
+        {"ratio", 0.5},
+        {"list", {1, nullptr, "x"}},
+        {"database", {{"host", "localhost"}, {"pool", {{"max", 8}}}}},
+        {"deep", {{"only", {{"leaf", true}}}}},
+        {"empty", Value::object()},
+        {"servers", {{{"host", "a"}}, {{"host", "b"}, {"tags", {{"zone", "eu"}}}}}},
+        {"key with.dot", {{"k", 1}}}
+    });
+
+    EXPECT_EQ(cfg.to_toml(),
+        "list = [ 1, \"\", \"x\" ]\n"
+        "name = \"app\"\n"
+        "nothing = \"\"\n"
+        "ratio = 0.5\n"
+        "\n[database]\n"
+        "host = \"localhost\"\n"
+        "\n[database.pool]\n"
+        "max = 8\n"
+        "\n[deep.only]\n"
+        "leaf = true\n"
+        "\n[empty]\n"
+        "\n[\"key with.dot\"]\n"
+        "k = 1\n"
+        "\n[[servers]]\n"
+        "host = \"a\"\n"
+        "\n[[servers]]\n"
+        "host = \"b\"\n"
+        "\n[servers.tags]\n"
+        "zone = \"eu\"\n");
+}
+
+TEST(ConfigSerialization, ToTomlEscapesStrings) {
+    Config cfg(Value{{"s", "quote\" back\\ tab\t nl\n bell\x07 caf\u00e9"}});
+
+    EXPECT_EQ(cfg.to_toml(),
+              "s = \"quote\\\" back\\\\ tab\\t nl\\n bell\\u0007 caf\u00e9\"\n");
+}
+
+TEST(ConfigSerialization, ToTomlRejectsUnsignedAboveInt64) {
+    Config fits(Value{{"n", static_cast<uint64_t>(9223372036854775807ull)}});
+    EXPECT_EQ(fits.to_toml(), "n = 9223372036854775807\n");
+
+    Config big(Value{{"n", static_cast<uint64_t>(9223372036854775808ull)}});
+    EXPECT_THROW(big.to_toml(), ConfigError);
+}
+
+TEST(ConfigSerialization, ToTomlStreamAndSinkMatchString) {
+    Config cfg(Value{{"a", {{"b", 1}}}, {"c", {1.0, 2.5}}});
+
+    std::ostringstream out;
+    cfg.to_toml(out);
+    EXPECT_EQ(out.str(), cfg.to_toml());
+
+    std::string collected;
+    cfg.to_toml([&](const char* data, size_t size) { collected.append(data, size); });
+    EXPECT_EQ(collected, cfg.to_toml());
+}
+
+TEST(ConfigSerialization, ToTomlRoundTrip) {
+    Value original = {
+        {"name", "app"},
+        {"nothing", nullptr},
+        {"ratio", 0.25},
+        {"big", 1e20},
+        {"neg", -42},
+        {"flags", {true, false}},
+        {"mixed", {1, "two", {{"three", 3}}, {4, 5}}},
+        {"database", {{"host", "h"}, {"pool", {{"max", 8}, {"opts", Value::object()}}}}},
+        {"servers", {{{"host", "a"}, {"ports", {80, 443}}}, {{"host", "b"}, {"meta", {{"zone", "eu"}}}}}},
+        {"odd key", {{"\"quoted\"", "v\nw"}}}
+    };
+    TempFile file("test_config_roundtrip.toml", Config(original).to_toml());
+
+    Value expected = original;
+    expected["nothing"] = "";   // TOML has no null
+    EXPECT_EQ(load_toml_file(file.path()), expected);
+}
+
 // ============================================================================
 // Merge Tests
 // ============================================================================
@@ -466,6 +591,106 @@ TEST(ConfigMerge, DeepMerge) {
     EXPECT_EQ(cfg.get("database.port"), 5433);
 }
 
+// ============================================================================
+// Copy-on-Write Snapshot Tests
+// ============================================================================
+
+TEST(ConfigSnapshot, CopySharesTree) {
+    Config cfg1(Value{{"database", {{"host", "localhost"}}}});
+    Config cfg2 = cfg1;
+
+    EXPECT_TRUE(cfg2.shares_data_with(cfg1));
+    EXPECT_EQ(&std::as_const(cfg2).data(), &std::as_const(cfg1).data());
+}
+
+TEST(ConfigSnapshot, SetDetachesOnlyModifiedCopy) {
+    Config original(Value{{"database", {{"host", "localhost"}, {"port", 5432}}}});
+    Config snapshot = original;
+
+    original.set("database.port", 5433);
+
+    EXPECT_FALSE(original.shares_data_with(snapshot));
+    EXPECT_EQ(original.get("database.port"), 5433);
+    EXPECT_EQ(snapshot.get("database.port"), 5432);
+}
+
+TEST(ConfigSnapshot, UnsharedSetDoesNotCopy) {
+    Config cfg(Value{{"a", 1}});
+    const Value* before = &std::as_const(cfg).data();
+
+    cfg.set("b", 2);
+
+    EXPECT_EQ(&std::as_const(cfg).data(), before);
+}
+
+TEST(ConfigSnapshot, MergeLeavesSnapshotIntact) {
+    Config cfg(Value{{"a", 1}});
+    Config snapshot = cfg;
+
+    cfg.merge(Value{{"a", 2}, {"b", 3}});
+
+    EXPECT_EQ(cfg.get("a"), 2);
+    EXPECT_EQ(snapshot.get("a"), 1);
+    EXPECT_FALSE(snapshot.contains("b"));
+}
+
+TEST(ConfigSnapshot, MutableDataDetaches) {
+    Config cfg(Value{{"a", 1}});
+    Config snapshot = cfg;
+
+    cfg.mutable_data()["a"] = 10;
+
+    EXPECT_EQ(cfg.get("a"), 10);
+    EXPECT_EQ(snapshot.get("a"), 1);
+}
+
+TEST(ConfigSnapshot, ReadsThroughNonConstDoNotDetach) {
+    Config cfg(Value{{"a", 1}});
+    Config snapshot = cfg;
+
+    Value copy = std::as_const(cfg).data();
+
+    EXPECT_EQ(copy["a"], 1);
+    EXPECT_TRUE(cfg.shares_data_with(snapshot));
+}
+
+TEST(ConfigSnapshot, CopyAfterMutableDataDoesNotAlias) {
+    Config cfg(Value{{"a", 1}});
+    Value& tree = cfg.mutable_data();
+    Config snapshot = cfg;
+    Config assigned;
+    assigned = cfg;
+
+    tree["a"] = 2;
+
+    EXPECT_EQ(cfg.get("a"), 2);
+    EXPECT_EQ(snapshot.get("a"), 1);
+    EXPECT_EQ(assigned.get("a"), 1);
+    EXPECT_TRUE(snapshot.shares_data_with(Config(snapshot)));
+
+    // merge() replaces the tree, so copies share it again
+    cfg.merge(Value::object());
+    EXPECT_TRUE(Config(cfg).shares_data_with(cfg));
+}
+
+TEST(ConfigSnapshot, SetKeepsTreeSharable) {
+    Config cfg(Value{{"a", 1}});
+    cfg.set("a", 2);
+    Config snapshot = cfg;
+    EXPECT_TRUE(snapshot.shares_data_with(cfg));
+}
+
+TEST(ConfigSnapshot, MovedFromIsEmpty) {
+    Config cfg1(Value{{"key", "value"}});
+    Config cfg2(std::move(cfg1));
+
+    EXPECT_TRUE(cfg1.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_TRUE(std::as_const(cfg1).data().is_object());
+    cfg1.set("other", 1);
+    EXPECT_EQ(cfg1.get("other"), 1);
+    EXPECT_FALSE(Config().contains("other"));
+}
+
 // ============================================================================
 // Integration Tests
 // ============================================================================
@@ -516,3 +741,82 @@ port = 5432
     EXPECT_EQ(cfg.get("database.host"), "localhost");
     EXPECT_EQ(cfg.get("database.port"), 5432);
 }
+
+TEST(ConfigStaticPath, GetOverloads) {
+    using namespace confy::literals;
+    Config cfg(Value{{"db", {{"port", 5432}, {"host", "h"}}}});
+
+    EXPECT_EQ(cfg.get<int>("db.port"_cpath, 0), 5432);
+    EXPECT_EQ(cfg.get<int>("db.missing"_cpath, 7), 7);
+    EXPECT_EQ(cfg.get("db.host"_cpath), "h");
+    EXPECT_FALSE(cfg.get_optional("db.missing"_cpath).has_value());
+    EXPECT_THROW(cfg.get("db.missing"_cpath), KeyError);
+    EXPECT_THROW(cfg.get<int>("db.host"_cpath, 0), TypeError);
+    EXPECT_THROW(cfg.get_optional("db.port.x"_cpath), TypeError);
+}
+
+TEST(ConfigGetMany, ResultsInCallerOrder) {
+    Config cfg(Value{
+        {"db", {{"host", "h"}, {"port", 5432}, {"pool", {{"max", 8}}}}},
+        {"list", {1, 2}}
+    });
+
+    auto r = cfg.get_many({"db.pool.max", "db.host", "missing", "db.port",
+                           "db.host.x", "list.1", "list.5", "db.pool.max"});
+
+    ASSERT_EQ(r.size(), 8u);
+    EXPECT_EQ(r[0].status, LookupStatus::Found);
+    EXPECT_EQ(r[0].value, 8);
+    EXPECT_EQ(r[1].value, "h");
+    EXPECT_EQ(r[2].status, LookupStatus::Missing);
+    EXPECT_EQ(r[3].value, 5432);
+    EXPECT_EQ(r[4].status, LookupStatus::TypeMismatch);
+    EXPECT_EQ(r[5].value, 2);
+    EXPECT_EQ(r[6].status, LookupStatus::Missing);
+    EXPECT_TRUE(r[7].found());
+}
+
+TEST(ConfigGetMany, MatchesSingleLookups) {
+    Config cfg(Value{{"a", {{"b", {{"c", 1}}}, {"s", "x"}}}, {"n", nullptr}});
+    std::vector<std::string> paths = {"a", "a.b", "a.b.c", "a.s", "a.s.t", "n", "n.k", "zz"};
+
+    auto r = cfg.get_many(paths);
+    for (size_t i = 0; i < paths.size(); ++i) {
+        try {
+            auto single = cfg.get_optional(paths[i]);
+            EXPECT_EQ(r[i].found(), single.has_value()) << paths[i];
+            if (single) {
+                EXPECT_EQ(r[i].value, *single) << paths[i];
+            }
+        } catch (const TypeError&) {
+            EXPECT_EQ(r[i].status, LookupStatus::TypeMismatch) << paths[i];
+        }
+    }
+}
+
+TEST(ConfigGetMany, EmptyBatch) {
+    Config cfg(Value{{"a", 1}});
+    EXPECT_TRUE(cfg.get_many({}).empty());
+}
+
+TEST(ConfigFind, NonThrowingLookup) {
+    Config cfg(Value{{"db", {{"port", 5432}}}});
+
+    auto hit = cfg.find("db.port");
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(*hit.value, 5432);
+    EXPECT_EQ(cfg.find("db.host").status, LookupStatus::Missing);
+    EXPECT_EQ(cfg.find("db.port.x").status, LookupStatus::TypeMismatch);
+}
+
+TEST(ConfigFind, MissSegmentViewsCallerBuffer) {
+    Config cfg(Value{{"db", {{"port", 5432}}}});
+
+    auto literal = cfg.find("db.host");
+    EXPECT_EQ(literal.segment, "host");
+
+    std::string path = "db.user";
+    auto miss = cfg.find(path);
+    EXPECT_EQ(miss.segment, "user");
+    EXPECT_EQ(miss.segment.data(), path.data() + 3);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_config_watcher.cpp
+ * @brief Unit tests for change-driven configuration reload (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/ConfigWatcher.hpp"
+#include "confy/EnvMapper.hpp"
+#include "confy/Errors.hpp"
+#include "confy/Loader.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+using namespace confy;
+
+namespace {
+
+class TempDir {
+public:
+    TempDir() : path_(fs::temp_directory_path() / "confy_watcher_test") {
+        fs::remove_all(path_);
+        fs::create_directories(path_);
+    }
+
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path_, ec);
+    }
+
+    std::string file(const std::string& name, const std::string& content) const {
+        std::string p = (path_ / name).string();
+        std::ofstream(p, std::ios::binary) << content;
+        return p;
+    }
+
+private:
+    fs::path path_;
+};
+
+void set_env(const char* name, const char* value) {
+#ifdef _WIN32
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+void unset_env(const char* name) {
+#ifdef _WIN32
+    _putenv_s(name, "");
+#else
+    unsetenv(name);
+#endif
+}
+
+LoadOptions options(const std::string& file) {
+    LoadOptions opts;
+    opts.file_path = file;
+    opts.load_dotenv_file = false;
+    opts.prefix = std::string("WATCHTEST");
+    return opts;
+}
+
+} // anonymous namespace
+
+TEST(ConfigWatcher, ReloadsOnlyOnFileChange) {
+    TempDir dir;
+    std::string path = dir.file("app.json", R"({"port": 1})");
+    ConfigWatcher watcher(options(path));
+    EXPECT_EQ(watcher.config().get("port"), 1);
+
+    EXPECT_FALSE(watcher.changed());
+    EXPECT_FALSE(watcher.refresh());
+
+    dir.file("app.json", R"({"port": 22})");
+    EXPECT_TRUE(watcher.changed());
+    EXPECT_TRUE(watcher.refresh());
+    EXPECT_EQ(watcher.config().get("port"), 22);
+    EXPECT_FALSE(watcher.refresh());
+}
+
+TEST(ConfigWatcher, ReloadsOnEnvironmentChange) {
+    TempDir dir;
+    std::string path = dir.file("app.json", R"({"port": 1})");
+    ConfigWatcher watcher(options(path));
+
+    set_env("WATCHTEST_PORT", "7");
+    EXPECT_TRUE(watcher.refresh());
+    EXPECT_EQ(watcher.config().get("port"), 7);
+    EXPECT_FALSE(watcher.refresh());
+
+    unset_env("WATCHTEST_PORT");
+    EXPECT_TRUE(watcher.refresh());
+    EXPECT_EQ(watcher.config().get("port"), 1);
+}
+
+TEST(ConfigWatcher, ReloadsEditedDotenv) {
+    TempDir dir;
+    std::string path = dir.file("app.json", R"({"name": "file", "port": 1})");
+    std::string dotenv = dir.file("app.env", "WATCHTEST_NAME=one\nWATCHTEST_PORT=5\n");
+    set_env("WATCHTEST_PORT", "9");
+    LoadOptions opts = options(path);
+    opts.load_dotenv_file = true;
+    opts.dotenv_path = dotenv;
+
+    ConfigWatcher watcher(opts);
+    EXPECT_EQ(watcher.config().get("name"), "one");
+    EXPECT_EQ(watcher.config().get("port"), 9);
+
+    dir.file("app.env", "WATCHTEST_NAME=three\nWATCHTEST_PORT=6\n");
+    EXPECT_TRUE(watcher.refresh());
+    EXPECT_EQ(watcher.config().get("name"), "three");
+    EXPECT_EQ(watcher.config().get("port"), 9);   // set outside .env, still wins
+
+    dir.file("app.env", "WATCHTEST_PORT=6\n");
+    EXPECT_TRUE(watcher.refresh());
+    EXPECT_EQ(watcher.config().get("name"), "file");
+    EXPECT_FALSE(has_env_var("WATCHTEST_NAME"));
+
+    unset_env("WATCHTEST_PORT");
+}
+
+TEST(ConfigWatcher, FailedReloadKeepsPreviousConfig) {
+    TempDir dir;
+    std::string path = dir.file("app.json", R"({"port": 1})");
+    ConfigWatcher watcher(options(path));
+
+    dir.file("app.json", R"({"port": )");
+    EXPECT_THROW(watcher.refresh(), ConfigParseError);
+    EXPECT_EQ(watcher.config().get("port"), 1);
+    EXPECT_FALSE(watcher.refresh());    // not retried until it changes again
+
+    dir.file("app.json", R"({"port": 333})");
+    EXPECT_TRUE(watcher.refresh());
+    EXPECT_EQ(watcher.config().get("port"), 333);
+}
+
+TEST(EnvFingerprint, TracksFilteredEnvironment) {
+    unset_env("FPTEST_A");
+    uint64_t before = env_fingerprint(std::string("FPTEST"));
+    EXPECT_EQ(env_fingerprint(std::string("FPTEST")), before);
+
+    set_env("FPTEST_A", "1");
+    uint64_t with_a = env_fingerprint(std::string("FPTEST"));
+    EXPECT_NE(with_a, before);
+
+    set_env("FPTEST_A", "2");
+    EXPECT_NE(env_fingerprint(std::string("FPTEST")), with_a);
+
+    set_env("OTHERFP_B", "x");    // outside the prefix
+    uint64_t current = env_fingerprint(std::string("FPTEST"));
+    set_env("OTHERFP_B", "y");
+    EXPECT_EQ(env_fingerprint(std::string("FPTEST")), current);
+
+    EXPECT_EQ(env_fingerprint(std::nullopt), 0u);
+    unset_env("FPTEST_A");
+    unset_env("OTHERFP_B");
+}
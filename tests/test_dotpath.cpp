@@ -352,3 +352,180 @@ TEST(DotPathEdgeCases, NumericStringKeys) {
     ASSERT_NE(result, nullptr);
     EXPECT_EQ(*result, "first");
 }
+
+// ============================================================================
+// Static Path Tests
+// ============================================================================
+
+using namespace confy::literals;
+
+TEST(StaticPath, TokenizesAtCompileTime) {
+    constexpr auto path = "logging.handlers.0.type"_cpath;
+    static_assert(path.size() == 4, "segment count");
+    static_assert(path[1] == "handlers", "segment text");
+    static_assert(path.is_index(2) && path.index(2) == 0, "array index");
+    static_assert(!path.is_index(3), "not an index");
+
+    EXPECT_EQ(path.str(), "logging.handlers.0.type");
+}
+
+TEST(StaticPath, MatchesSplitDotPath) {
+    constexpr StaticPath paths[] = {
+        StaticPath(""), StaticPath("."), StaticPath("a..b."), StaticPath(".x")
+    };
+    const char* texts[] = {"", ".", "a..b.", ".x"};
+
+    for (size_t p = 0; p < 4; ++p) {
+        auto expected = split_dot_path(texts[p]);
+        ASSERT_EQ(paths[p].size(), expected.size()) << texts[p];
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(paths[p][i], expected[i]);
+        }
+    }
+}
+
+TEST(StaticPath, IndexRulesMatchRuntime) {
+    for (const char* seg : {"0", "12", "01", "-1", "x", "1a"}) {
+        StaticPath path(seg);
+        EXPECT_EQ(path.is_index(0), is_array_index(seg)) << seg;
+    }
+}
+
+TEST(StaticPath, TooManySegmentsThrows) {
+    EXPECT_THROW(StaticPath("a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q"), std::length_error);
+}
+
+TEST(StaticPath, GetByDotMatchesStringPath) {
+    Value data = {
+        {"db", {{"host", "localhost"}}},
+        {"list", {10, 20}}
+    };
+
+    EXPECT_EQ(*get_by_dot(data, "db.host"_cpath), "localhost");
+    EXPECT_EQ(*get_by_dot(data, "list.1"_cpath), 20);
+    EXPECT_EQ(get_by_dot(data, ""_cpath), &data);
+
+    EXPECT_THROW(get_by_dot(data, "db.port"_cpath), KeyError);
+    EXPECT_THROW(get_by_dot(data, "list.2"_cpath), KeyError);
+    EXPECT_THROW(get_by_dot(data, "list.x"_cpath), KeyError);
+    EXPECT_THROW(get_by_dot(data, "db.host.x"_cpath), TypeError);
+
+    Value def = "default";
+    EXPECT_EQ(get_by_dot(data, "db.port"_cpath, def), &def);
+    EXPECT_THROW(get_by_dot(data, "db.host.x"_cpath, def), TypeError);
+}
+
+// ============================================================================
+// Non-throwing Lookup Tests
+// ============================================================================
+
+TEST(DotPathTryGet, StatusMatchesThrowingLookup) {
+    Value data = {
+        {"db", {{"host", "localhost"}, {"port", 5432}}},
+        {"list", {10, 20}}
+    };
+
+    auto found = try_get_by_dot(data, "db.host");
+    ASSERT_TRUE(found);
+    EXPECT_EQ(*found.value, "localhost");
+
+    auto root = try_get_by_dot(data, "");
+    EXPECT_EQ(root.value, &data);
+
+    EXPECT_EQ(try_get_by_dot(data, "list.1").status, LookupStatus::Found);
+    EXPECT_EQ(try_get_by_dot(data, "db.user").status, LookupStatus::Missing);
+    EXPECT_EQ(try_get_by_dot(data, "list.9").status, LookupStatus::Missing);
+    EXPECT_EQ(try_get_by_dot(data, "list.x").status, LookupStatus::Missing);
+    EXPECT_EQ(try_get_by_dot(data, "list.99999999999999999999999").status,
+              LookupStatus::Missing);
+    EXPECT_EQ(try_get_by_dot(data, "db.port.x").status, LookupStatus::TypeMismatch);
+}
+
+TEST(DotPathTryGet, MessageMatchesException) {
+    Value data = {{"db", {{"port", 5432}}}, {"list", {1}}};
+
+    for (const std::string path : {"db.user", "list.3", "list.x", "db.port.x"}) {
+        auto result = try_get_by_dot(data, path);
+        ASSERT_FALSE(result) << path;
+        try {
+            get_by_dot(data, path);
+            FAIL() << "Expected exception for " << path;
+        } catch (const ConfigError& e) {
+            EXPECT_EQ(result.message(path), e.what());
+        }
+    }
+}
+
+TEST(DotPathTryGet, ThrowIfError) {
+    Value data = {{"db", {{"port", 5432}}}};
+
+    EXPECT_NO_THROW(try_get_by_dot(data, "db.port").throw_if_error("db.port"));
+    EXPECT_THROW(try_get_by_dot(data, "db.host").throw_if_error("db.host"), KeyError);
+    EXPECT_THROW(try_get_by_dot(data, "db.port.x").throw_if_error("db.port.x"), TypeError);
+}
+
+TEST(DotPathTryGet, SkipsEmptySegments) {
+    Value data = {{"a", {{"b", 1}}}};
+    auto result = try_get_by_dot(data, ".a..b.");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result.value, 1);
+}
+
+// ============================================================================
+// TreeBuilder
+// ============================================================================
+
+TEST(TreeBuilder, MatchesSetByDot) {
+    std::vector<std::pair<std::string, Value>> pairs = {
+        {"db.port", 5432}, {"db.host", "localhost"}, {"log.level", "info"},
+        {"db.pool.max", 10}, {"a-b.c", 1}, {"a.b", 2}, {"ab", 3}, {"db.pool.min", 1}
+    };
+    Value expected = Value::object();
+    for (const auto& [path, value] : pairs) {
+        set_by_dot(expected, path, value, true);
+    }
+
+    TreeBuilder tree;
+    for (const auto& [path, value] : pairs) {
+        tree.add(path, value);
+    }
+    EXPECT_EQ(tree.size(), pairs.size());
+    EXPECT_EQ(tree.build(), expected);
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_EQ(tree.build(), Value::object());
+}
+
+TEST(TreeBuilder, OverlapsIndependentOfOrder) {
+    std::vector<std::pair<std::string, Value>> pairs = {
+        {"a", 1}, {"a.b", 2},                       // a scalar ends its path
+        {"o", {{"x", 1}}}, {"o.y", 2},              // an object is a base
+        {"dup", "first"}, {".dup.", "second"}       // same path: last added wins
+    };
+    Value expected = {{"a", 1}, {"o", {{"x", 1}, {"y", 2}}}, {"dup", "second"}};
+
+    TreeBuilder forward;
+    for (const auto& [path, value] : pairs) {
+        forward.add(path, value);
+    }
+    EXPECT_EQ(forward.build(), expected);
+
+    // Reversed, except the duplicate pair which must keep its own order
+    TreeBuilder backward;
+    backward.add("dup", "first");
+    backward.add("dup", "second");
+    for (size_t i = 4; i-- > 0;) {
+        backward.add(pairs[i].first, pairs[i].second);
+    }
+    EXPECT_EQ(backward.build(), expected);
+}
+
+TEST(TreeBuilder, RootPath) {
+    TreeBuilder tree;
+    tree.add("", Value{{"x", 1}});
+    tree.add("y", 2);
+    EXPECT_EQ(tree.build(), (Value{{"x", 1}, {"y", 2}}));
+
+    tree.add("", 5);
+    tree.add("y", 2);
+    EXPECT_EQ(tree.build(), 5);
+}
@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 #include "confy/EnvMapper.hpp"
 #include "confy/Value.hpp"
+#include "confy/DotPath.hpp"
 
 #include <cstdlib>
 
@@ -300,6 +301,22 @@ TEST(EnvMapperRemap, NestedUnderscoreKey) {
     EXPECT_EQ(result, "feature_flags.beta");
 }
 
+TEST(EnvMapperRemap, OrderedSetMatchesKeySet) {
+    // "db-old" sorts between "db" and "db.host": the section query must
+    // still find the keys below "db"
+    std::set<std::string> base_keys = {"db-old", "db.host", "feature_flags.beta"};
+    KeySet key_set(base_keys.begin(), base_keys.end());
+
+    for (const char* path : {"db", "db.port", "feature.flags.beta", "other.key"}) {
+        for (bool load_dotenv : {false, true}) {
+            EXPECT_EQ(remap_env_key(path, base_keys, std::string(""), load_dotenv),
+                      remap_env_key(path, key_set, std::string(""), load_dotenv))
+                << path << " load_dotenv=" << load_dotenv;
+        }
+    }
+    EXPECT_EQ(remap_env_key("db", base_keys, std::string(""), true), "db");
+}
+
 // ============================================================================
 // Full Pipeline Tests
 // ============================================================================
@@ -347,3 +364,89 @@ TEST(EnvMapperPipeline, ValueParsing) {
 
     EXPECT_TRUE(result.is_object());
 }
+
+// ============================================================================
+// Remap Plan Tests
+// ============================================================================
+
+namespace {
+
+Value full_pipeline(const RemapPlan::EnvVars& vars, const KeySet& keys,
+                    const std::optional<std::string>& prefix, bool load_dotenv) {
+    Value result = Value::object();
+    for (const auto& [key, value] :
+         remap_and_flatten_env_data(env_vars_to_nested(vars, prefix), keys, prefix, load_dotenv)) {
+        set_by_dot(result, key, value, true);
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(EnvMapperRemapPlan, MatchesFullPipeline) {
+    KeySet keys(Value{
+        {"feature_flags", {{"beta_feature", false}}},
+        {"database", {{"host", ""}, {"port", 0}}}
+    });
+    RemapPlan::EnvVars vars = {
+        {"APP_FEATURE_FLAGS_BETA_FEATURE", "true"},
+        {"APP_DATABASE_HOST", "db"},
+        {"APP_DATABASE_PORT", "5432"},
+        {"APP_A", "1"},
+        {"APP_A_B", "2"},           // turns "a" into a section
+        {"APP_LIST", "[1, 2]"},
+        {"APP_UNKNOWN_KEY", "x"}
+    };
+
+    for (const std::optional<std::string>& prefix : {std::optional<std::string>("APP"),
+                                                     std::optional<std::string>("")}) {
+        for (bool load_dotenv : {false, true}) {
+            RemapPlan plan = RemapPlan::build(vars, keys, prefix, load_dotenv);
+            auto applied = plan.apply(vars);
+            ASSERT_TRUE(applied.has_value());
+            EXPECT_EQ(*applied, full_pipeline(vars, keys, prefix, load_dotenv))
+                << "prefix='" << *prefix << "' load_dotenv=" << load_dotenv;
+        }
+    }
+}
+
+TEST(EnvMapperRemapPlan, ReusedForNewValues) {
+    KeySet keys(Value{{"database", {{"host", ""}}}});
+    RemapPlan::EnvVars vars = {{"APP_DATABASE_HOST", "a"}};
+    RemapPlan plan = RemapPlan::build(vars, keys, std::string("APP"), false);
+
+    RemapPlan::EnvVars changed = {{"APP_DATABASE_HOST", "b"}};
+    EXPECT_TRUE(plan.matches(changed, keys, std::string("APP"), false));
+    EXPECT_EQ(*plan.apply(changed), (Value{{"database", {{"host", "b"}}}}));
+
+    EXPECT_FALSE(plan.matches(changed, keys, std::string("OTHER"), false));
+    EXPECT_FALSE(plan.matches(changed, keys, std::string("APP"), true));
+    EXPECT_FALSE(plan.matches({{"APP_DATABASE_PORT", "1"}}, keys, std::string("APP"), false));
+    EXPECT_FALSE(plan.matches(changed, KeySet(Value{{"db", 1}}), std::string("APP"), false));
+}
+
+TEST(EnvMapperRemapPlan, ObjectValueNeedsFullPipeline) {
+    KeySet keys;
+    RemapPlan::EnvVars vars = {{"APP_DB", "{\"host\": \"x\"}"}};
+    RemapPlan plan = RemapPlan::build(vars, keys, std::string("APP"), false);
+    EXPECT_FALSE(plan.apply(vars).has_value());
+}
+
+TEST(EnvMapperRemapPlan, LoadEnvVarsAcrossReloads) {
+    Value base = {{"database", {{"host", ""}}}};
+    Value first;
+    {
+        EnvGuard env("TESTPLAN_DATABASE_HOST", "one");
+        first = load_env_vars(std::string("TESTPLAN"), base, base, Value::object(), false);
+    }
+    EnvGuard env("TESTPLAN_DATABASE_HOST", "two");
+    Value second = load_env_vars(std::string("TESTPLAN"), base, base, Value::object(), false);
+
+    EXPECT_EQ(first["database"]["host"], "one");
+    EXPECT_EQ(second["database"]["host"], "two");
+
+    EnvGuard object_env("TESTPLAN_EXTRA", "{\"a\": 1}");
+    Value third = load_env_vars(std::string("TESTPLAN"), base, base, Value::object(), false);
+    EXPECT_EQ(third["extra_a"], 1);   // unknown key: flat fallback (RULE E7)
+    EXPECT_EQ(third["database"]["host"], "two");
+}
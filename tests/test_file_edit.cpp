@@ -0,0 +1,235 @@
+/**
+ * @file test_file_edit.cpp
+ * @brief Unit tests for atomic, minimal-rewrite file edits (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/FileEdit.hpp"
+#include "confy/Loader.hpp"
+#include "confy/Errors.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using namespace confy;
+
+namespace {
+
+class TempDir {
+public:
+    TempDir() : path_(fs::temp_directory_path() / "confy_file_edit_test") {
+        fs::remove_all(path_);
+        fs::create_directories(path_);
+    }
+
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path_, ec);
+    }
+
+    std::string file(const std::string& name, const std::string& content) const {
+        std::string p = (path_ / name).string();
+        std::ofstream(p, std::ios::binary) << content;
+        return p;
+    }
+
+    size_t entries() const {
+        return static_cast<size_t>(std::distance(fs::directory_iterator(path_),
+                                                 fs::directory_iterator()));
+    }
+
+    const fs::path& path() const { return path_; }
+
+private:
+    fs::path path_;
+};
+
+std::string read_text(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+std::string span_text(std::string_view text, const std::optional<TextSpan>& span) {
+    return std::string(text.substr(span->begin, span->end - span->begin));
+}
+
+} // anonymous namespace
+
+TEST(FileEditSpan, JsonNestedAndArrays) {
+    std::string text = R"({ "a" : {"s": "x,}", "b1": [1, {"c": null}, [2]] }, "n": -1.5e3 })";
+
+    auto s = find_json_value_span(text, "a.b1.1.c");
+    ASSERT_TRUE(s);
+    EXPECT_EQ(span_text(text, s), "null");
+
+    EXPECT_EQ(span_text(text, find_json_value_span(text, "a.b1.2")), "[2]");
+    EXPECT_EQ(span_text(text, find_json_value_span(text, "a.s")), "\"x,}\"");
+    EXPECT_EQ(span_text(text, find_json_value_span(text, "n")), "-1.5e3");
+
+    EXPECT_FALSE(find_json_value_span(text, "a.missing"));
+    EXPECT_FALSE(find_json_value_span(text, "a.b1.3"));
+    EXPECT_FALSE(find_json_value_span(text, "n.x"));
+}
+
+TEST(FileEditSpan, TomlTablesAndComments) {
+    std::string text =
+        "title = 'demo'  # top\n"
+        "[database]\n"
+        "host = \"db\"   # primary\n"
+        "ports = [ 1, 2 ]\n"
+        "notes = \"\"\"\n"
+        "[fake]\n"
+        "x = 1\n"
+        "\"\"\"\n"
+        "[ \"fake\" ]\n"
+        "x = 2\n"
+        "[[servers]]\n"
+        "name = \"a\"\n";
+
+    EXPECT_EQ(span_text(text, find_toml_value_span(text, "title")), "'demo'");
+    EXPECT_EQ(span_text(text, find_toml_value_span(text, "database.host")), "\"db\"");
+    EXPECT_EQ(span_text(text, find_toml_value_span(text, "database.ports")), "[ 1, 2 ]");
+    EXPECT_EQ(span_text(text, find_toml_value_span(text, "fake.x")), "2");
+
+    EXPECT_FALSE(find_toml_value_span(text, "database.notes"));    // multi-line
+    EXPECT_FALSE(find_toml_value_span(text, "servers.0.name"));    // array of tables
+    EXPECT_FALSE(find_toml_value_span(text, "database.user"));
+}
+
+TEST(FileEdit, JsonPatchKeepsFormatting) {
+    TempDir dir;
+    std::string original =
+        "{\n"
+        "    \"db\": { \"host\": \"old\",   \"port\": 5432 },\n"
+        "    \"tags\": [\"a\", \"b\"]\n"
+        "}\n";
+    std::string path = dir.file("cfg.json", original);
+
+    auto result = update_config_file(path, {{"db.port", 6543}, {"tags", Value{"a", "c"}}});
+
+    EXPECT_TRUE(result.patched);
+    EXPECT_EQ(read_text(path),
+              "{\n"
+              "    \"db\": { \"host\": \"old\",   \"port\": 6543 },\n"
+              "    \"tags\": [\"a\",\"c\"]\n"
+              "}\n");
+    EXPECT_EQ(dir.entries(), 1u);  // no temporary left behind
+}
+
+TEST(FileEdit, JsonNewKeyRewritesWholeFile) {
+    TempDir dir;
+    std::string path = dir.file("cfg.json", R"({"db": {"host": "old"}})");
+
+    auto result = update_config_file(path, {{"db.host", "new"}, {"db.port", 5432}});
+
+    EXPECT_FALSE(result.patched);
+    EXPECT_EQ(load_json_file(path), (Value{{"db", {{"host", "new"}, {"port", 5432}}}}));
+}
+
+TEST(FileEdit, CreatesMissingFile) {
+    TempDir dir;
+    std::string path = (dir.path() / "new.json").string();
+
+    update_config_file(path, {{"a.b", true}});
+
+    EXPECT_EQ(load_json_file(path), (Value{{"a", {{"b", true}}}}));
+}
+
+TEST(FileEdit, MalformedFileLeftUntouched) {
+    TempDir dir;
+    std::string original = R"({"a": 1,})";
+    std::string path = dir.file("cfg.json", original);
+
+    EXPECT_THROW(update_config_file(path, {{"a", 2}}), ConfigParseError);
+    EXPECT_EQ(read_text(path), original);
+}
+
+TEST(FileEdit, UnsupportedExtension) {
+    TempDir dir;
+    std::string path = dir.file("cfg.yaml", "a: 1\n");
+
+    EXPECT_THROW(update_config_file(path, {{"a", 2}}), ConfigError);
+}
+
+TEST(FileEdit, TomlPatchKeepsComments) {
+    TempDir dir;
+    std::string path = dir.file("cfg.toml",
+        "# service settings\n"
+        "[database]\n"
+        "host = \"localhost\"  # primary\n"
+        "port = 5432\n");
+
+    auto result = update_config_file(path, {{"database.host", "db.internal"}});
+
+    EXPECT_TRUE(result.patched);
+    EXPECT_EQ(read_text(path),
+        "# service settings\n"
+        "[database]\n"
+        "host = \"db.internal\"  # primary\n"
+        "port = 5432\n");
+}
+
+TEST(FileEditAtomic, ReplacesContent) {
+    TempDir dir;
+    std::string path = dir.file("out.txt", "old");
+
+    write_file_atomic(path, "new content");
+
+    EXPECT_EQ(read_text(path), "new content");
+    EXPECT_EQ(dir.entries(), 1u);
+}
+
+#ifndef _WIN32
+TEST(FileEditAtomic, WritesThroughSymlink) {
+    TempDir dir;
+    fs::create_directories(dir.path() / "real");
+    std::string real = dir.file("real/config.json", "old");
+    fs::path link = dir.path() / "config.json";
+    fs::create_symlink("real/config.json", link);
+
+    write_file_atomic(link.string(), "new");
+
+    EXPECT_TRUE(fs::is_symlink(link));
+    EXPECT_EQ(read_text(real), "new");
+    EXPECT_EQ(dir.entries(), 2u);  // the link and real/, no stray temp file
+}
+
+TEST(FileEditAtomic, KeepsOwnerAndGroup) {
+    if (::geteuid() != 0) {
+        GTEST_SKIP() << "changing a file's owner needs root";
+    }
+    TempDir dir;
+    std::string path = dir.file("out.txt", "old");
+    ASSERT_EQ(::chown(path.c_str(), 4321, 4322), 0);
+
+    write_file_atomic(path, "new");
+
+    struct stat st;
+    ASSERT_EQ(::stat(path.c_str(), &st), 0);
+    EXPECT_EQ(st.st_uid, 4321u);
+    EXPECT_EQ(st.st_gid, 4322u);
+}
+#endif
+
+TEST(FileEditAtomic, FailedWriteKeepsOriginal) {
+    TempDir dir;
+    std::string path = dir.file("out.txt", "old");
+
+    EXPECT_THROW(write_file_atomic(path, [](std::ostream& out) {
+        out << "partial";
+        throw std::runtime_error("boom");
+    }), std::runtime_error);
+
+    EXPECT_EQ(read_text(path), "old");
+    EXPECT_EQ(dir.entries(), 1u);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file test_intern.cpp
+ * @brief Unit tests for key interning (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/Intern.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_set>
+
+using namespace confy;
+
+TEST(KeyTable, EqualKeysShareStorage) {
+    KeyTable table;
+    std::string a = "database";
+    std::string b = std::string("data") + "base";
+
+    InternedKey ka = table.intern(a);
+    InternedKey kb = table.intern(b);
+
+    EXPECT_EQ(ka, kb);
+    EXPECT_EQ(ka.view().data(), kb.view().data());
+    EXPECT_EQ(ka.view(), "database");
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(KeyTable, DistinctKeysDiffer) {
+    KeyTable table;
+    InternedKey host = table.intern("host");
+    InternedKey port = table.intern("port");
+
+    EXPECT_NE(host, port);
+    EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(KeyTable, ViewsOutliveSourceString) {
+    KeyTable table;
+    InternedKey key;
+    {
+        std::string temp = "temporary.key.that.is.long.enough.to.allocate";
+        key = table.intern(temp);
+    }
+    EXPECT_EQ(key.view(), "temporary.key.that.is.long.enough.to.allocate");
+}
+
+TEST(KeyTable, FindDoesNotInsert) {
+    KeyTable table;
+    EXPECT_TRUE(table.find("missing").empty());
+    EXPECT_EQ(table.size(), 0u);
+
+    InternedKey k = table.intern("present");
+    EXPECT_EQ(table.find("present"), k);
+}
+
+TEST(KeyTable, ViewsStableAcrossManyBlocks) {
+    KeyTable table;
+    std::vector<InternedKey> keys;
+    for (int i = 0; i < 5000; ++i) {
+        keys.push_back(table.intern("key_number_" + std::to_string(i)));
+    }
+    keys.push_back(table.intern(std::string(10000, 'x')));
+
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_EQ(keys[i].view(), "key_number_" + std::to_string(i));
+    }
+    EXPECT_EQ(keys.back().view().size(), 10000u);
+    EXPECT_EQ(table.size(), 5001u);
+}
+
+TEST(KeyTable, UsableInHashSet) {
+    KeyTable table;
+    std::unordered_set<InternedKey, InternedKeyHash> set;
+    set.insert(table.intern("a"));
+    set.insert(table.intern("b"));
+    set.insert(table.intern(std::string("a")));
+
+    EXPECT_EQ(set.size(), 2u);
+    EXPECT_TRUE(set.count(table.intern("b")) > 0);
+}
+
+TEST(KeyTable, ConcurrentInterning) {
+    KeyTable table;
+    std::vector<std::thread> threads;
+    std::vector<std::vector<InternedKey>> results(4);
+
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&table, &results, t] {
+            for (int i = 0; i < 500; ++i) {
+                results[t].push_back(table.intern("k" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(table.size(), 500u);
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_EQ(results[0][i], results[3][i]);
+    }
+}
+
+TEST(KeyTable, GlobalTableShortcut) {
+    InternedKey a = intern_key("confy.test.global");
+    InternedKey b = KeyTable::global().intern("confy.test.global");
+    EXPECT_EQ(a, b);
+}
@@ -0,0 +1,191 @@
+/**
+ * @file test_interpolator.cpp
+ * @brief Unit tests for lazy ${...} expansion (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/Interpolator.hpp"
+#include "confy/Errors.hpp"
+
+#include <cstdlib>
+
+using namespace confy;
+
+namespace {
+
+void set_env(const char* name, const char* value) {
+#ifdef _WIN32
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+void unset_env(const char* name) {
+#ifdef _WIN32
+    _putenv_s(name, "");
+#else
+    unsetenv(name);
+#endif
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Expansion
+// ============================================================================
+
+TEST(Interpolator, ExpandsKeyReferences) {
+    Interpolator values(Config(Value{
+        {"server", {{"host", "example.com"}, {"port", 8080}}},
+        {"url", "http://${server.host}:${server.port}/"},
+        {"port", "${server.port}"},
+        {"copy", "${server}"},
+        {"plain", "no references"}
+    }));
+
+    EXPECT_EQ(values.get("url"), "http://example.com:8080/");
+    EXPECT_EQ(values.get("port"), 8080);  // whole-string reference keeps the type
+    EXPECT_EQ(values.get("copy"), (Value{{"host", "example.com"}, {"port", 8080}}));
+    EXPECT_EQ(values.get("plain"), "no references");
+    EXPECT_EQ(values.get<int>("port", 0), 8080);
+    EXPECT_EQ(values.get<int>("missing", 7), 7);
+}
+
+TEST(Interpolator, SplicedTextIsTyped) {
+    Interpolator values(Config(Value{
+        {"major", 2}, {"minor", 5},
+        {"version", "${major}.${minor}"},
+        {"flag", "${enabled}"}, {"enabled", "true"},
+        {"text", "tr${suffix}"}, {"suffix", "ue"}
+    }));
+
+    EXPECT_EQ(values.get("version"), 2.5);
+    EXPECT_EQ(values.get("flag"), "true");  // referenced value is a string
+    EXPECT_EQ(values.get("text"), true);    // spliced text goes through parse_value
+}
+
+TEST(Interpolator, EnvironmentReferences) {
+    set_env("CONFY_INTERP_PORT", "9090");
+    set_env("CONFY_INTERP_HOST", "db.local");
+    Interpolator values(Config(Value{
+        {"port", "${env:CONFY_INTERP_PORT}"},
+        {"dsn", "pg://${env:CONFY_INTERP_HOST}:${env:CONFY_INTERP_PORT}"}
+    }));
+
+    EXPECT_EQ(values.get("port"), 9090);
+    EXPECT_EQ(values.get("dsn"), "pg://db.local:9090");
+
+    unset_env("CONFY_INTERP_PORT");
+    unset_env("CONFY_INTERP_HOST");
+}
+
+TEST(Interpolator, EscapesAndStrayDollars) {
+    Interpolator values(Config(Value{
+        {"literal", "cost $${price} in $"},
+        {"price", 3}
+    }));
+    EXPECT_EQ(values.get("literal"), "cost ${price} in $");
+}
+
+TEST(Interpolator, ExpandsInsideObjectsAndArrays) {
+    Interpolator values(Config(Value{
+        {"name", "api"},
+        {"hosts", {"${name}-1", "${name}-2"}},
+        {"service", {{"id", "${name}"}, {"first", "${hosts.0}"}}}
+    }));
+
+    EXPECT_EQ(values.get("hosts"), (Value{"api-1", "api-2"}));
+    EXPECT_EQ(values.get("service"), (Value{{"id", "api"}, {"first", "api-1"}}));
+    EXPECT_EQ(values.resolve_all()["service"]["first"], "api-1");
+}
+
+TEST(Interpolator, ErrorsNameTheString) {
+    Interpolator values(Config(Value{
+        {"a", "${b}"}, {"b", "${c}"}, {"c", "${a}"},
+        {"self", {{"x", "${self}"}}},
+        {"missing", "${nope.key}"},
+        {"env", "${env:CONFY_INTERP_UNSET}"},
+        {"open", "${unterminated"}
+    }));
+    unset_env("CONFY_INTERP_UNSET");
+
+    try {
+        values.get("a");
+        FAIL() << "expected a cycle";
+    } catch (const InterpolationError& e) {
+        EXPECT_EQ(e.path(), "a");
+        EXPECT_EQ(e.reason(), "reference cycle a -> b -> c -> a");
+    }
+    EXPECT_THROW(values.get("self"), InterpolationError);
+    EXPECT_THROW(values.get("missing"), InterpolationError);
+    EXPECT_THROW(values.get("env"), InterpolationError);
+    EXPECT_THROW(values.get("open"), InterpolationError);
+    EXPECT_THROW(values.get("absent"), KeyError);
+
+    // Failed expansions are not cached and leave no partial state
+    EXPECT_EQ(values.cached(), 0u);
+}
+
+// ============================================================================
+// Laziness and invalidation
+// ============================================================================
+
+TEST(Interpolator, ExpandsOnlyWhatIsRead) {
+    Interpolator values(Config(Value{
+        {"a", "${base}/a"}, {"b", "${base}/b"}, {"c", "${a}/c"}, {"base", "/srv"}
+    }));
+    EXPECT_EQ(values.cached(), 0u);
+
+    EXPECT_EQ(values.get("c"), "/srv/a/c");
+    EXPECT_EQ(values.cached(), 2u);  // c and a; b untouched
+}
+
+TEST(Interpolator, UpdateDropsOnlyDependents) {
+    Value data = {
+        {"db", {{"host", "h1"}, {"port", 5432}}},
+        {"dsn", "${db.host}:${db.port}"},
+        {"url", "pg://${dsn}"},
+        {"section", "${db}"},
+        {"name", "${app}"},
+        {"app", "svc"}
+    };
+    Interpolator values{Config(data)};
+    for (const char* key : {"dsn", "url", "section", "name"}) {
+        values.get(key);
+    }
+    ASSERT_EQ(values.cached(), 4u);
+
+    // Unchanged snapshot: nothing dropped
+    EXPECT_EQ(values.update(Config(data)), 0u);
+    EXPECT_EQ(values.cached(), 4u);
+
+    // db.host changes: dsn (direct), url (through dsn) and section (via db)
+    data["db"]["host"] = "h2";
+    EXPECT_EQ(values.update(Config(data)), 3u);
+    EXPECT_EQ(values.cached(), 1u);
+    EXPECT_EQ(values.get("url"), "pg://h2:5432");
+    EXPECT_EQ(values.get("section")["host"], "h2");
+    EXPECT_EQ(values.get("name"), "svc");
+
+    // Replacing a string drops its own expansion
+    data["name"] = "fixed";
+    values.update(Config(data));
+    EXPECT_EQ(values.get("name"), "fixed");
+}
+
+TEST(Interpolator, UpdateRereadsReferencedEnvironment) {
+    set_env("CONFY_INTERP_MODE", "blue");
+    Value data = {{"mode", "${env:CONFY_INTERP_MODE}"}, {"other", "${app}"}, {"app", "x"}};
+    Interpolator values{Config(data)};
+    EXPECT_EQ(values.get("mode"), "blue");
+    values.get("other");
+
+    EXPECT_EQ(values.update(Config(data)), 0u);
+
+    set_env("CONFY_INTERP_MODE", "green");
+    EXPECT_EQ(values.update(Config(data)), 1u);
+    EXPECT_EQ(values.get("mode"), "green");
+
+    unset_env("CONFY_INTERP_MODE");
+}
@@ -0,0 +1,108 @@
+/**
+ * @file test_key_set.cpp
+ * @brief Unit tests for the hashed dot-path set (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/KeySet.hpp"
+#include "confy/EnvMapper.hpp"
+
+#include <string>
+
+using namespace confy;
+
+TEST(KeySet, MatchesFlattenKeys) {
+    Value data = {
+        {"database", {{"host", "x"}, {"port", 5432}}},
+        {"feature_flags", {{"beta", true}}},
+        {"debug", false},
+        {"empty", Value::object()}
+    };
+
+    KeySet keys(data);
+    auto expected = flatten_keys(data);
+    EXPECT_EQ(keys.size(), expected.size());
+    for (const auto& key : expected) {
+        EXPECT_TRUE(keys.contains(key)) << key;
+    }
+    EXPECT_FALSE(keys.contains("database.user"));
+    EXPECT_FALSE(keys.contains("data"));
+}
+
+TEST(KeySet, ContainsPrefix) {
+    KeySet keys{"a.b.c", "literal.dotted", "x"};
+    EXPECT_TRUE(keys.contains_prefix("a"));
+    EXPECT_TRUE(keys.contains_prefix("a.b"));
+    EXPECT_TRUE(keys.contains_prefix("a.b.c"));
+    EXPECT_TRUE(keys.contains_prefix("literal"));
+    EXPECT_TRUE(keys.contains_prefix("x"));
+    EXPECT_FALSE(keys.contains_prefix("a.b.c.d"));
+    EXPECT_FALSE(keys.contains_prefix("a.b."));
+
+    // Sections are not keys
+    EXPECT_FALSE(keys.contains("a"));
+    EXPECT_FALSE(keys.contains("literal"));
+    EXPECT_EQ(keys.size(), 3u);
+}
+
+TEST(KeySet, FromLayersLaysFileSectionsOverDefaults) {
+    Value defaults = {
+        {"db", {{"host", "h"}, {"port", 1}}},
+        {"log", {{"level", "info"}}}
+    };
+    Value file = {{"db", {{"url", "u"}}}, {"extra", 1}};
+
+    KeySet keys = KeySet::from_layers(defaults, file);
+    EXPECT_TRUE(keys.contains("db.url"));
+    EXPECT_FALSE(keys.contains("db.host"));     // whole section replaced
+    EXPECT_TRUE(keys.contains("log.level"));
+    EXPECT_TRUE(keys.contains("extra"));
+
+    Value base = defaults;
+    for (auto it = file.begin(); it != file.end(); ++it) {
+        base[it.key()] = it.value();
+    }
+    EXPECT_EQ(keys.size(), KeySet(base).size());
+    EXPECT_EQ(keys.fingerprint(), KeySet(base).fingerprint());
+
+    EXPECT_EQ(KeySet::from_layers(defaults, Value(5)).size(), KeySet(defaults).size());
+}
+
+TEST(KeySet, SameAsLayers) {
+    Value defaults = {{"a", {{"b", 1}}}, {"c", 2}};
+    Value file = {{"d", 3}};
+    KeySet keys = KeySet::from_layers(defaults, file);
+
+    EXPECT_TRUE(keys.same_as_layers(defaults, file));
+    Value changed_value = {{"d", "other"}};
+    EXPECT_TRUE(keys.same_as_layers(defaults, changed_value));   // values do not matter
+
+    EXPECT_FALSE(keys.same_as_layers(defaults, Value::object()));
+    EXPECT_FALSE(keys.same_as_layers(defaults, Value{{"d", 3}, {"e", 4}}));
+
+    // Duplicate paths must not hide a missing one
+    Value dup = {{"a", {{"b", 1}}}, {"a.b", 2}};
+    EXPECT_FALSE(keys.same_as_layers(dup, file));
+    EXPECT_TRUE(KeySet().same_as_layers(Value::object(), Value()));
+}
+
+TEST(KeySet, FingerprintIgnoresOrder) {
+    KeySet a{"x", "y.z", "w"};
+    KeySet b{"w", "x", "y.z", "x"};
+    KeySet c{"x", "y.z"};
+    EXPECT_EQ(a.fingerprint(), b.fingerprint());
+    EXPECT_NE(a.fingerprint(), c.fingerprint());
+}
+
+TEST(KeySet, GrowsPastInitialCapacity) {
+    KeySet keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.insert("section" + std::to_string(i % 10) + ".key" + std::to_string(i));
+    }
+    EXPECT_EQ(keys.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(keys.contains("section" + std::to_string(i % 10) + ".key" + std::to_string(i)));
+    }
+    EXPECT_TRUE(keys.contains_prefix("section7"));
+    EXPECT_FALSE(keys.contains("section7"));
+}
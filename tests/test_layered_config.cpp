@@ -0,0 +1,188 @@
+/**
+ * @file test_layered_config.cpp
+ * @brief Unit tests for LayeredConfig (GoogleTest)
+ *
+ * Every lookup on a LayeredConfig must match the same lookup on the
+ * eagerly merged tree (RULE P2/P3, null-does-not-override).
+ *
+ * @copyright (c) 2026. MIT License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "confy/LayeredConfig.hpp"
+#include "confy/Config.hpp"
+#include "confy/DotPath.hpp"
+#include "confy/Errors.hpp"
+
+using namespace confy;
+
+namespace {
+
+LayeredConfig make_layers(std::initializer_list<Value> layers) {
+    LayeredConfig cfg;
+    for (const auto& layer : layers) {
+        cfg.add_layer(layer);
+    }
+    return cfg;
+}
+
+/**
+ * @brief Check a path against the materialized tree (value or error kind)
+ */
+void expect_same_as_merged(const LayeredConfig& layered, const std::string& path) {
+    Config merged(layered.materialize());
+
+    bool merged_type_error = false;
+    std::optional<Value> expected;
+    try {
+        expected = merged.get_optional(path);
+    } catch (const TypeError&) {
+        merged_type_error = true;
+    }
+
+    if (merged_type_error) {
+        EXPECT_THROW(layered.get_optional(path), TypeError) << path;
+        return;
+    }
+    EXPECT_EQ(layered.get_optional(path), expected) << path;
+    EXPECT_EQ(layered.contains(path), expected.has_value()) << path;
+}
+
+} // anonymous namespace
+
+TEST(LayeredConfig, HigherLayerWins) {
+    auto cfg = make_layers({
+        {{"db", {{"host", "a"}, {"port", 1}}}},
+        {{"db", {{"port", 2}}}}
+    });
+
+    EXPECT_EQ(cfg.get("db.host"), "a");
+    EXPECT_EQ(cfg.get("db.port"), 2);
+    EXPECT_EQ(cfg.get("db"), (Value{{"host", "a"}, {"port", 2}}));
+}
+
+TEST(LayeredConfig, ScalarReplacesObject) {
+    // RULE P3
+    auto cfg = make_layers({
+        {{"db", {{"host", "a"}}}},
+        {{"db", "string"}}
+    });
+
+    EXPECT_EQ(cfg.get("db"), "string");
+    EXPECT_THROW(cfg.get("db.host"), TypeError);
+}
+
+TEST(LayeredConfig, ObjectReplacesScalarBelow) {
+    auto cfg = make_layers({
+        {{"db", {{"user", "root"}}}},
+        {{"db", "string"}},
+        {{"db", {{"host", "a"}}}}
+    });
+
+    // The scalar layer cut off the lowest object
+    EXPECT_EQ(cfg.get("db"), (Value{{"host", "a"}}));
+    EXPECT_FALSE(cfg.contains("db.user"));
+}
+
+TEST(LayeredConfig, NullDoesNotOverride) {
+    auto cfg = make_layers({
+        {{"a", 1}, {"b", {{"c", 2}}}},
+        {{"a", nullptr}, {"b", nullptr}}
+    });
+
+    EXPECT_EQ(cfg.get("a"), 1);
+    EXPECT_EQ(cfg.get("b.c"), 2);
+}
+
+TEST(LayeredConfig, NullOnlyKeyExists) {
+    auto cfg = make_layers({
+        {{"a", 1}},
+        {{"n", nullptr}}
+    });
+
+    EXPECT_TRUE(cfg.contains("n"));
+    EXPECT_TRUE(cfg.get("n").is_null());
+}
+
+TEST(LayeredConfig, ArraysAreReplacedNotMerged) {
+    auto cfg = make_layers({
+        {{"list", {1, 2, 3}}},
+        {{"list", {9}}}
+    });
+
+    EXPECT_EQ(cfg.get("list.0"), 9);
+    EXPECT_FALSE(cfg.contains("list.1"));
+}
+
+TEST(LayeredConfig, OversizedIndexIsOutOfRange) {
+    auto cfg = make_layers({{{"list", {1, 2}}}});
+
+    EXPECT_FALSE(cfg.contains("list.99999999999999999999999"));
+    EXPECT_THROW(cfg.get("list.99999999999999999999999"), KeyError);
+}
+
+TEST(LayeredConfig, MissingKeyErrors) {
+    auto cfg = make_layers({{{"a", 1}}});
+
+    EXPECT_THROW(cfg.get("missing"), KeyError);
+    EXPECT_FALSE(cfg.get_optional("missing").has_value());
+    EXPECT_EQ(cfg.get<int>("missing", 7), 7);
+    EXPECT_THROW(cfg.contains("a.b"), TypeError);
+}
+
+TEST(LayeredConfig, EmptyLayersBehaveAsEmptyObject) {
+    LayeredConfig cfg;
+    EXPECT_FALSE(cfg.contains("a"));
+    EXPECT_EQ(cfg.get(""), Value::object());
+    EXPECT_EQ(cfg.materialize(), Value::object());
+}
+
+TEST(LayeredConfig, AddLayerRejectsNonObject) {
+    LayeredConfig cfg;
+    EXPECT_THROW(cfg.add_layer(Value::array({1})), TypeError);
+}
+
+TEST(LayeredConfig, MatchesMaterializedTree) {
+    auto cfg = make_layers({
+        {{"a", {{"b", {{"c", 1}, {"d", 2}}}, {"list", {{{"x", 1}}}}}}, {"s", "str"}, {"n", nullptr}},
+        {{"a", {{"b", {{"d", 3}, {"e", nullptr}}}}}, {"s", {{"now", "object"}}}},
+        {{"a", {{"list", {{{"y", 2}}}}}}, {"n", {{"k", true}}}, {"s", nullptr}}
+    });
+
+    for (const char* path : {"", "a", "a.b", "a.b.c", "a.b.d", "a.b.e", "a.list",
+                             "a.list.0", "a.list.0.y", "a.list.0.x", "a.list.1",
+                             "s", "s.now", "n", "n.k", "n.k.deeper", "missing",
+                             "a.b.c.z", "a.list.x"}) {
+        expect_same_as_merged(cfg, path);
+    }
+}
+
+TEST(LayeredConfig, LoadKeepsLayersSeparate) {
+    LoadOptions opts;
+    opts.defaults = {{"server", {{"host", "localhost"}, {"port", 8080}}}};
+    opts.overrides = {{"server.port", 9090}};
+    opts.load_dotenv_file = false;
+
+    LayeredConfig cfg = LayeredConfig::load(opts);
+
+    ASSERT_EQ(cfg.layers().size(), 2u);
+    EXPECT_EQ(cfg.layers()[0].name, "defaults");
+    EXPECT_EQ(cfg.layers()[1].name, "overrides");
+    EXPECT_EQ(cfg.get<int>("server.port", 0), 9090);
+    EXPECT_EQ(cfg.materialize(), Config::load(opts).to_dict());
+}
+
+TEST(LayeredConfig, LoadValidatesMandatory) {
+    LoadOptions opts;
+    opts.defaults = {{"a", 1}};
+    opts.mandatory = {"a", "b.c", "a.x"};
+    opts.load_dotenv_file = false;
+
+    try {
+        LayeredConfig::load(opts);
+        FAIL() << "Expected MissingMandatoryConfig";
+    } catch (const MissingMandatoryConfig& e) {
+        EXPECT_EQ(e.missing_keys(), (std::vector<std::string>{"b.c", "a.x"}));
+    }
+}
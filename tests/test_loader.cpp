@@ -287,6 +287,19 @@ KEY2=value2
     EXPECT_EQ(result.entries.size(), 2u);
 }
 
+TEST(LoaderDotenv, SmallAndLargeFilesParseAlike) {
+    // Small files are read into memory, files of several MiB are mapped
+    const std::string body = "KEY1=value1\nKEY2=\"two\"\n";
+    TempFile small("test_small.env", body);
+    TempFile large("test_large.env", std::string(5 * 1024 * 1024, '#') + "\n" + body);
+
+    DotenvResult a = parse_dotenv_file(small.path());
+    DotenvResult b = parse_dotenv_file(large.path());
+
+    ASSERT_EQ(a.entries.size(), 2u);
+    EXPECT_EQ(a.entries, b.entries);
+}
+
 TEST(LoaderDotenv, MissingFileNotFound) {
     DotenvResult result = parse_dotenv_file("/nonexistent/.env");
 
@@ -294,6 +307,148 @@ TEST(LoaderDotenv, MissingFileNotFound) {
     EXPECT_TRUE(result.entries.empty());
 }
 
+TEST(LoaderDotenv, MultilineQuotedValues) {
+    TempFile file("test_multiline.env",
+        "CERT=\"-----BEGIN CERTIFICATE-----\n"
+        "MIIBszCCAVmgAwIBAgIU\n"
+        "-----END CERTIFICATE-----\"\n"
+        "KEY='line one\n"
+        "line two' # trailing comment\n"
+        "AFTER=ok\n");
+
+    DotenvResult result = parse_dotenv_file(file.path());
+
+    ASSERT_EQ(result.entries.size(), 3u);
+    EXPECT_EQ(result.entries[0].second,
+              "-----BEGIN CERTIFICATE-----\nMIIBszCCAVmgAwIBAgIU\n-----END CERTIFICATE-----");
+    EXPECT_EQ(result.entries[1].second, "line one\nline two");
+    EXPECT_EQ(result.entries[2].first, "AFTER");
+    EXPECT_EQ(result.entries[2].second, "ok");
+}
+
+TEST(LoaderDotenv, CommentsAndEscapesFollowPythonDotenv) {
+    TempFile file("test_escapes.env",
+        "HASH=abc#def\n"
+        "COMMENT=abc #def\n"
+        "QUOTED=\"x # y\" # note\n"
+        "DOUBLE=\"tab\\there \\\"q\\\" back\\\\slash\"\n"
+        "SINGLE='raw\\n it\\'s'\n"
+        "EMPTY=\n"
+        "'QUOTED KEY'=1\n"
+        "  export   SPACED = value  \r\n");
+
+    DotenvResult result = parse_dotenv_file(file.path());
+
+    std::vector<std::pair<std::string, std::string>> expected = {
+        {"HASH", "abc#def"},
+        {"COMMENT", "abc"},
+        {"QUOTED", "x # y"},
+        {"DOUBLE", "tab\there \"q\" back\\slash"},
+        {"SINGLE", "raw\\n it's"},
+        {"EMPTY", ""},
+        {"QUOTED KEY", "1"},
+        {"SPACED", "value"}
+    };
+    EXPECT_EQ(result.entries, expected);
+}
+
+TEST(LoaderDotenv, SkipsMalformedLines) {
+    TempFile file("test_malformed.env",
+        "=novalue\n"
+        "BARE\n"
+        "JUNK=\"a\" trailing\n"
+        "OPEN=\"never closed\n"
+        "NEXT=1\n");
+
+    DotenvResult result = parse_dotenv_file(file.path());
+
+    ASSERT_EQ(result.entries.size(), 1u);
+    EXPECT_EQ(result.entries[0].first, "NEXT");
+}
+
+TEST(LoaderDotenv, ExpandsVariables) {
+    set_env_var("CONFY_DOTENV_HOST", "env-host");
+    TempFile file("test_interpolate.env",
+        "CONFY_DOTENV_HOST=file-host\n"
+        "CONFY_DOTENV_USER=admin\n"
+        "URL=\"http://${CONFY_DOTENV_USER}@${CONFY_DOTENV_HOST}/${MISSING_VAR:-db}\"\n"
+        "RAW='${CONFY_DOTENV_USER}'\n"
+        "PLAIN=${CONFY_DOTENV_USER}-${NOT_SET_ANYWHERE}\n");
+
+    // Default: the environment wins, as the entries will not override it
+    DotenvResult result = parse_dotenv_file(file.path());
+    ASSERT_EQ(result.entries.size(), 5u);
+    EXPECT_EQ(result.entries[2].second, "http://admin@env-host/db");
+    EXPECT_EQ(result.entries[3].second, "${CONFY_DOTENV_USER}");
+    EXPECT_EQ(result.entries[4].second, "admin-");
+
+    DotenvOptions options;
+    options.override_existing = true;
+    result = parse_dotenv_file(file.path(), options);
+    EXPECT_EQ(result.entries[2].second, "http://admin@file-host/db");
+
+    options.interpolate = false;
+    result = parse_dotenv_file(file.path(), options);
+    EXPECT_EQ(result.entries[4].second, "${CONFY_DOTENV_USER}-${NOT_SET_ANYWHERE}");
+
+#ifdef _WIN32
+    _putenv_s("CONFY_DOTENV_HOST", "");
+#else
+    unsetenv("CONFY_DOTENV_HOST");
+#endif
+}
+
+TEST(LoaderDotenv, FindDotenvWalksUpToBoundary) {
+    fs::path root = fs::temp_directory_path() / "confy_find_dotenv";
+    fs::remove_all(root);
+    fs::create_directories(root / "repo" / "pkg" / "src");
+    std::ofstream(root / ".env") << "OUTER=1\n";
+    std::ofstream(root / "repo" / ".git") << "gitdir: elsewhere\n";
+    clear_dotenv_cache();
+
+    std::string start = (root / "repo" / "pkg" / "src").string();
+    std::string outer = (root / ".env").string();
+    EXPECT_EQ(find_dotenv(start), outer);
+
+    // Bounded by a directory or by a marker, the outer file is not seen
+    DotenvSearch search;
+    search.start_dir = start;
+    search.stop_dir = (root / "repo").string() + "/";
+    EXPECT_EQ(find_dotenv(search), "");
+    search.stop_dir.clear();
+    search.stop_marker = ".git";
+    EXPECT_EQ(find_dotenv(search), "");
+
+    // A boundary that is not an ancestor does not stop the walk
+    search.stop_marker.clear();
+    search.stop_dir = (root / "elsewhere").string();
+    EXPECT_EQ(find_dotenv(search), outer);
+
+    // "Not found" is not cached: a .env created later is seen at once
+    search.stop_dir = (root / "repo").string();
+    EXPECT_EQ(find_dotenv(search), "");
+    std::ofstream(root / "repo" / ".env") << "REPO=1\n";
+    EXPECT_EQ(find_dotenv(search), (root / "repo" / ".env").string());
+
+    // A cached hit that was deleted is searched again
+    fs::remove(root / "repo" / ".env");
+    EXPECT_EQ(find_dotenv(search), "");
+
+    // A hit is cached until cleared, even if a closer .env appears
+    std::ofstream(root / "repo" / "pkg" / ".env") << "INNER=1\n";
+    EXPECT_EQ(find_dotenv(start), outer);
+    clear_dotenv_cache();
+    EXPECT_EQ(find_dotenv(start), (root / "repo" / "pkg" / ".env").string());
+
+    // A directory named .env is not a .env file
+    fs::create_directories(root / "repo" / "pkg" / "src" / ".env");
+    clear_dotenv_cache();
+    EXPECT_EQ(find_dotenv(start), (root / "repo" / "pkg" / ".env").string());
+
+    clear_dotenv_cache();
+    fs::remove_all(root);
+}
+
 // ============================================================================
 // RULE F5: TOML Key Promotion
 // ============================================================================
@@ -362,3 +362,86 @@ TEST(MergeRealWorld, FeatureFlags) {
     EXPECT_EQ(result["features"]["beta_api"], true);
     EXPECT_EQ(result["features"]["analytics"], true);
 }
+
+// ============================================================================
+// Parallel Merge Tests
+// ============================================================================
+
+namespace {
+
+/// Per-tenant map where every fifth key is only in base, every seventh only
+/// in the override, and the rest cover each merge rule
+void make_tenants(size_t count, Value& base, Value& over) {
+    base = Value::object();
+    over = Value::object();
+    for (size_t i = 0; i < count; ++i) {
+        std::string key = "tenant" + std::to_string(i);
+        if (i % 7 != 0) {
+            base[key] = {{"plan", "free"}, {"limits", {{"cpu", 1}, {"disk", 10}}}, {"tags", {"a"}}};
+        }
+        if (i % 5 == 0) {
+            continue;
+        }
+        switch (i % 4) {
+            case 0: over[key] = {{"limits", {{"cpu", 4}, {"gpu", nullptr}}}}; break;
+            case 1: over[key] = nullptr; break;                 // null does not override
+            case 2: over[key] = "disabled"; break;              // scalar replaces object
+            case 3: over[key] = {{"plan", nullptr}, {"tags", {"b", "c"}}}; break;
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(MergeParallel, MatchesSequentialOnWideObject) {
+    Value base, over;
+    make_tenants(5000, base, over);
+    Value expected = deep_merge(base, over);
+
+    for (size_t threads : {1u, 2u, 3u, 8u, 33u}) {
+        ParallelMergeOptions options;
+        options.threads = threads;
+        options.min_keys = 64;
+        EXPECT_EQ(deep_merge_parallel(base, over, options), expected) << threads << " threads";
+    }
+}
+
+TEST(MergeParallel, WideObjectBelowTopLevel) {
+    Value tenants, tenant_overrides;
+    make_tenants(2000, tenants, tenant_overrides);
+    Value base = {{"tenants", tenants}, {"app", {{"name", "x"}}}, {"only_base", 1}};
+    Value over = {{"tenants", tenant_overrides}, {"app", {{"name", nullptr}}}, {"only_over", nullptr}};
+
+    ParallelMergeOptions options;
+    options.threads = 4;
+    options.min_keys = 100;
+    EXPECT_EQ(deep_merge_parallel(base, over, options), deep_merge(base, over));
+}
+
+TEST(MergeParallel, SkewedSides) {
+    // Ranges are cut from the larger side; the other side may be tiny
+    Value wide, narrow = {{"tenant0", {{"plan", "pro"}}}, {"zzz", 1}, {"aaa", 2}};
+    Value ignored;
+    make_tenants(1000, wide, ignored);
+
+    ParallelMergeOptions options;
+    options.threads = 8;
+    options.min_keys = 10;
+    EXPECT_EQ(deep_merge_parallel(wide, narrow, options), deep_merge(wide, narrow));
+    EXPECT_EQ(deep_merge_parallel(narrow, wide, options), deep_merge(narrow, wide));
+    EXPECT_EQ(deep_merge_parallel(Value::object(), wide, options), wide);
+    EXPECT_EQ(deep_merge_parallel(wide, Value::object(), options), wide);
+}
+
+TEST(MergeParallel, NonObjectsAsDeepMerge) {
+    ParallelMergeOptions options;
+    options.threads = 4;
+    options.min_keys = 1;
+    Value obj = {{"a", 1}};
+
+    EXPECT_EQ(deep_merge_parallel(obj, nullptr, options), obj);
+    EXPECT_EQ(deep_merge_parallel(nullptr, obj, options), obj);
+    EXPECT_EQ(deep_merge_parallel(obj, 5, options), 5);
+    EXPECT_EQ(deep_merge_parallel(Value::array({1}), obj, options), obj);
+    EXPECT_EQ(deep_merge_parallel(Value::object(), Value::object(), options), Value::object());
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_path_index.cpp
+ * @brief Unit tests for the sorted dot-path index (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/PathIndex.hpp"
+
+#include <optional>
+
+using namespace confy;
+
+namespace {
+
+Config sample() {
+    Config cfg;
+    cfg.merge(Value{
+        {"database", {{"host", "db.local"}, {"port", 5432},
+                      {"replica", {{"host", "r.local"}, {"port", 5433}}}}},
+        {"app", {{"name", "demo"}, {"tags", {"a", "b"}}}},
+        {"db", {{"timeout", 30}}},
+        {"dbx", true}
+    });
+    return cfg;
+}
+
+std::vector<std::string> paths(const std::vector<const PathIndex::Entry*>& entries) {
+    std::vector<std::string> out;
+    for (const auto* e : entries) out.emplace_back(e->path);
+    return out;
+}
+
+} // anonymous namespace
+
+using List = std::vector<std::string>;
+
+TEST(PathIndex, FlattensLeavesSorted) {
+    PathIndex index(sample());
+    EXPECT_EQ(index.size(), 8u);
+    EXPECT_EQ(index.entries().front().path, "app.name");
+    EXPECT_EQ(index.entries().back().path, "dbx");
+
+    auto tags = index.find("app.tags");
+    ASSERT_EQ(tags.size(), 1u);
+    EXPECT_EQ(*tags[0]->value, (Value{"a", "b"}));   // arrays are leaves
+}
+
+TEST(PathIndex, WithPrefix) {
+    PathIndex index(sample());
+    EXPECT_EQ(paths(index.with_prefix("db.")), List{"db.timeout"});
+    EXPECT_EQ(paths(index.with_prefix("d")).size(), 6u);
+    EXPECT_EQ(paths(index.with_prefix("db")), (List{"db.timeout", "dbx"}));
+    EXPECT_TRUE(index.with_prefix("zzz").empty());
+}
+
+TEST(PathIndex, PrefixPrunesCandidates) {
+    PathIndex index(sample());
+    EXPECT_EQ(index.candidates(Pattern("database.*")).size(), 4u);
+    EXPECT_EQ(paths(index.find("database.*.port")), List{"database.replica.port"});
+    EXPECT_EQ(paths(index.find("^db\\.")), List{"db.timeout"});
+}
+
+TEST(PathIndex, TrigramsPruneInfixQueries) {
+    PathIndex plain(sample());
+    PathIndex tri(sample(), true);
+    EXPECT_FALSE(plain.has_trigrams());
+    EXPECT_TRUE(tri.has_trigrams());
+
+    EXPECT_EQ(plain.candidates(Pattern("*.port")).size(), plain.size());
+    EXPECT_EQ(tri.candidates(Pattern("*.port")).size(), 2u);
+    EXPECT_TRUE(tri.candidates(Pattern("nothing")).empty());
+
+    for (const char* pat : {"host", "HOST", "*.port", "replica", "(host|name)$", "^app", "db"}) {
+        for (bool icase : {false, true}) {
+            EXPECT_EQ(paths(tri.find(pat, icase)), paths(plain.find(pat, icase)))
+                << pat << (icase ? " -i" : "");
+        }
+    }
+    EXPECT_EQ(paths(tri.find("HOST", true)), (List{"database.host", "database.replica.host"}));
+}
+
+TEST(PathIndex, SnapshotSurvivesChanges) {
+    Config cfg = sample();
+    PathIndex index(cfg);
+    cfg.set("database.host", "changed");
+
+    auto hosts = index.find("database.host");
+    ASSERT_EQ(hosts.size(), 1u);
+    EXPECT_EQ(*hosts[0]->value, "db.local");
+}
+
+TEST(PathIndex, EmptyConfig) {
+    PathIndex index(Config{}, true);
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_TRUE(index.find("*").empty());
+}
+
+TEST(PathIndex, PathsAreOwnedByTheIndex) {
+    Config cfg;
+    cfg.set("confy_index_own.leaf", 1);
+    std::optional<PathIndex> copy;
+    {
+        PathIndex index(cfg);
+        copy = index;  // copies share the path storage
+    }
+    ASSERT_EQ(copy->size(), 1u);
+    EXPECT_EQ(copy->entries()[0].path, "confy_index_own.leaf");
+    // Nothing is added to the process-wide table
+    EXPECT_TRUE(KeyTable::global().find("confy_index_own.leaf").empty());
+}
@@ -0,0 +1,94 @@
+/**
+ * @file test_pattern.cpp
+ * @brief Unit tests for pre-compiled search patterns (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/Pattern.hpp"
+
+using namespace confy;
+using Kind = Pattern::Kind;
+
+TEST(Pattern, DetectsKind) {
+    EXPECT_EQ(Pattern("db.host").kind(), Kind::Substring);
+    EXPECT_EQ(Pattern("db.*").kind(), Kind::Glob);
+    EXPECT_EQ(Pattern("^db").kind(), Kind::Regex);
+    EXPECT_EQ(Pattern("db[").kind(), Kind::Substring);    // invalid glob
+    EXPECT_EQ(Pattern("(db").kind(), Kind::Substring);    // invalid regex
+}
+
+TEST(Pattern, Substring) {
+    Pattern p("host");
+    EXPECT_TRUE(p.matches("database.host"));
+    EXPECT_FALSE(p.matches("database.HOST"));
+    EXPECT_TRUE(Pattern("HoSt", true).matches("database.host"));
+    EXPECT_TRUE(Pattern("").matches("anything"));
+}
+
+TEST(Pattern, GlobMatchesWholeText) {
+    Pattern p("db.*.port");
+    EXPECT_TRUE(p.matches("db.primary.port"));
+    EXPECT_TRUE(p.matches("db..port"));
+    EXPECT_FALSE(p.matches("db.primary.port2"));
+    EXPECT_FALSE(p.matches("xdb.primary.port"));
+
+    EXPECT_TRUE(Pattern("a?c").matches("abc"));
+    EXPECT_FALSE(Pattern("a?c").matches("ac"));
+    EXPECT_TRUE(Pattern("*").matches(""));
+    EXPECT_TRUE(Pattern("**a**").matches("bab"));
+    EXPECT_TRUE(Pattern("*ab*ab").matches("xabyabab"));
+}
+
+TEST(Pattern, GlobClasses) {
+    Pattern p("node[0-2].[ab]*");
+    EXPECT_TRUE(p.matches("node1.alpha"));
+    EXPECT_TRUE(p.matches("node0.b"));
+    EXPECT_FALSE(p.matches("node3.alpha"));
+    EXPECT_FALSE(p.matches("node1.c"));
+
+    EXPECT_TRUE(Pattern("NODE[A-C]", true).matches("nodeb"));
+    EXPECT_FALSE(Pattern("NODE[A-C]").matches("nodeb"));
+}
+
+TEST(Pattern, GlobNegatedClasses) {
+    EXPECT_FALSE(Pattern("[^a]bc").matches("abc"));
+    EXPECT_TRUE(Pattern("[^a]bc").matches("xbc"));
+    EXPECT_FALSE(Pattern("node[!0-2]").matches("node1"));
+    EXPECT_TRUE(Pattern("node[!0-2]").matches("node7"));
+
+    // Case folding applies before negation
+    EXPECT_FALSE(Pattern("[^a]bc", true).matches("Abc"));
+    EXPECT_TRUE(Pattern("[^a]bc", true).matches("Xbc"));
+
+    // A lone marker is a literal member
+    EXPECT_TRUE(Pattern("a[!]").matches("a!"));
+    EXPECT_TRUE(Pattern("a[^]").matches("a^"));
+}
+
+TEST(Pattern, Regex) {
+    Pattern p("^(db|cache)\\.");
+    EXPECT_TRUE(p.matches("db.host"));
+    EXPECT_TRUE(p.matches("cache.ttl"));
+    EXPECT_FALSE(p.matches("mydb.host"));
+    EXPECT_TRUE(Pattern("^DB", true).matches("db.host"));
+}
+
+TEST(Pattern, LiteralPrefix) {
+    EXPECT_EQ(Pattern("db.*.port").literal_prefix(), "db.");
+    EXPECT_EQ(Pattern("^db\\.host").literal_prefix(), "db.host");
+    EXPECT_EQ(Pattern("^dbs+x").literal_prefix(), "db");
+    EXPECT_EQ(Pattern("^db|^app").literal_prefix(), "");
+    EXPECT_EQ(Pattern("*.port").literal_prefix(), "");
+    EXPECT_EQ(Pattern("host").literal_prefix(), "");      // substring may match anywhere
+    EXPECT_EQ(Pattern("db.*", true).literal_prefix(), "");
+}
+
+TEST(Pattern, RequiredLiterals) {
+    using List = std::vector<std::string>;
+    EXPECT_EQ(Pattern("host").required_literals(), List{"host"});
+    EXPECT_EQ(Pattern("HOST", true).required_literals(), List{"host"});
+    EXPECT_EQ(Pattern("db.*.port").required_literals(), (List{"db.", ".port"}));
+    EXPECT_EQ(Pattern("node[0-2]?x").required_literals(), (List{"node", "x"}));
+    EXPECT_EQ(Pattern("^db\\.").required_literals(), List{"db."});
+    EXPECT_TRUE(Pattern("(a|b)$").required_literals().empty());
+}
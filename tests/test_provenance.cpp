@@ -0,0 +1,190 @@
+/**
+ * @file test_provenance.cpp
+ * @brief Unit tests for per-key origin tracking (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/Config.hpp"
+#include "confy/Merge.hpp"
+#include "confy/Provenance.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+using namespace confy;
+
+namespace {
+
+class TempDir {
+public:
+    TempDir() : path_(fs::temp_directory_path() / "confy_provenance_test") {
+        fs::remove_all(path_);
+        fs::create_directories(path_);
+    }
+
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path_, ec);
+    }
+
+    std::string file(const std::string& name, const std::string& content) const {
+        std::string p = (path_ / name).string();
+        std::ofstream(p, std::ios::binary) << content;
+        return p;
+    }
+
+private:
+    fs::path path_;
+};
+
+void set_env(const char* name, const char* value) {
+#ifdef _WIN32
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+void unset_env(const char* name) {
+#ifdef _WIN32
+    _putenv_s(name, "");
+#else
+    unsetenv(name);
+#endif
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// deep_merge() with a leaf table
+// ============================================================================
+
+TEST(ProvenanceMerge, SameResultAsDeepMerge) {
+    Value base = {{"db", {{"host", "a"}, {"port", 1}}}, {"list", {1, 2}}, {"n", nullptr}};
+    Value over = {{"db", {{"port", 2}, {"user", nullptr}}}, {"list", {3}}, {"n", 5}, {"x", {{"y", true}}}};
+
+    Provenance provenance;
+    uint8_t low = provenance.add_layer(Source::Defaults);
+    uint8_t high = provenance.add_layer(Source::Override);
+    Value merged = deep_merge(Value::object(), base, provenance, low);
+    merged = deep_merge(merged, over, provenance, high);
+
+    EXPECT_EQ(merged, deep_merge(base, over));
+    EXPECT_EQ(provenance.origin("db.host")->source, Source::Defaults);
+    EXPECT_EQ(provenance.origin("db.port")->source, Source::Override);
+    EXPECT_EQ(provenance.origin("list")->source, Source::Override);
+    EXPECT_EQ(provenance.origin("list.0")->source, Source::Override);
+    EXPECT_EQ(provenance.origin("n")->source, Source::Override);
+    EXPECT_EQ(provenance.origin("x.y")->source, Source::Override);
+    // null does not override, and adds no leaf of its own
+    EXPECT_EQ(provenance.origin("db.user")->source, Source::Override);
+    EXPECT_FALSE(provenance.origin("db").has_value());
+}
+
+TEST(ProvenanceMerge, ReplacedSectionForgetsItsLeaves) {
+    Provenance provenance;
+    uint8_t low = provenance.add_layer(Source::Defaults);
+    uint8_t high = provenance.add_layer(Source::File);
+    Value merged = deep_merge(Value::object(), Value{{"db", {{"host", "a"}, {"port", 1}}}},
+                              provenance, low);
+    merged = deep_merge(merged, Value{{"db", "sqlite"}}, provenance, high);
+
+    EXPECT_EQ(provenance.size(), 1u);
+    EXPECT_EQ(provenance.origin("db")->source, Source::File);
+    // A path below a leaf reports the leaf
+    EXPECT_EQ(provenance.origin("db.host")->source, Source::File);
+}
+
+TEST(ProvenanceMerge, LeafPathsStayOutOfTheGlobalTable) {
+    Provenance provenance;
+    uint8_t layer = provenance.add_layer(Source::Defaults);
+    deep_merge(Value::object(), Value{{"confy_prov_intern", {{"leaf", 1}}}}, provenance, layer);
+
+    EXPECT_EQ(provenance.origin("confy_prov_intern.leaf")->source, Source::Defaults);
+    EXPECT_FALSE(provenance.origin("confy_prov_intern.other.deep").has_value());
+    EXPECT_TRUE(KeyTable::global().find("confy_prov_intern.leaf").empty());
+}
+
+// ============================================================================
+// Config::load() with track_origins
+// ============================================================================
+
+TEST(ConfigOrigin, OffByDefault) {
+    LoadOptions opts;
+    opts.load_dotenv_file = false;
+    opts.defaults = {{"a", 1}};
+    Config cfg = Config::load(opts);
+    EXPECT_FALSE(cfg.has_origins());
+    EXPECT_FALSE(cfg.origin("a").has_value());
+}
+
+TEST(ConfigOrigin, ReportsEverySource) {
+    TempDir dir;
+    std::string file = dir.file("app.json",
+        "{\n"
+        "  \"database\": {\n"
+        "    \"host\": \"file-host\",\n"
+        "    \"port\": 5432\n"
+        "  }\n"
+        "}\n");
+    std::string dotenv = dir.file(".env", "PROVTEST_DATABASE_USER=dotenv-user\n");
+    set_env("PROVTEST_DATABASE_HOST", "env-host");
+    unset_env("PROVTEST_DATABASE_USER");
+
+    LoadOptions opts;
+    opts.file_path = file;
+    opts.dotenv_path = dotenv;
+    opts.prefix = std::string("PROVTEST");
+    opts.defaults = {{"database", {{"host", "localhost"}, {"port", 1}, {"user", "root"},
+                                   {"pool", 4}}}};
+    opts.overrides = {{"database.pool", Value(8)}};
+    opts.track_origins = true;
+    Config cfg = Config::load(opts);
+    ASSERT_TRUE(cfg.has_origins());
+
+    auto host = cfg.origin("database.host");
+    ASSERT_TRUE(host.has_value());
+    EXPECT_EQ(host->source, Source::Env);
+    EXPECT_EQ(host->name, "PROVTEST_DATABASE_HOST");
+    EXPECT_EQ(host->to_string(), "env PROVTEST_DATABASE_HOST");
+
+    auto port = cfg.origin("database.port");
+    ASSERT_TRUE(port.has_value());
+    EXPECT_EQ(port->source, Source::File);
+    EXPECT_EQ(port->file, file);
+    EXPECT_EQ(port->line, 4u);
+    EXPECT_EQ(port->to_string(), "file " + file + ":4");
+
+    auto user = cfg.origin("database.user");
+    ASSERT_TRUE(user.has_value());
+    EXPECT_EQ(user->source, Source::Dotenv);
+    EXPECT_EQ(user->name, "PROVTEST_DATABASE_USER");
+    EXPECT_EQ(user->file, dotenv);
+
+    auto pool = cfg.origin("database.pool");
+    ASSERT_TRUE(pool.has_value());
+    EXPECT_EQ(pool->source, Source::Override);
+    EXPECT_EQ(pool->name, "database.pool");
+
+    unset_env("PROVTEST_DATABASE_HOST");
+    unset_env("PROVTEST_DATABASE_USER");
+}
+
+TEST(ConfigOrigin, DefaultsAndModification) {
+    LoadOptions opts;
+    opts.load_dotenv_file = false;
+    opts.defaults = {{"a", {{"b", 1}}}};
+    opts.track_origins = true;
+    Config cfg = Config::load(opts);
+
+    EXPECT_EQ(cfg.origin("a.b")->to_string(), "defaults");
+    EXPECT_FALSE(cfg.origin("a.missing").has_value());
+
+    // Copies share the record; modification discards it
+    Config copy = cfg;
+    copy.set("a.b", 2);
+    EXPECT_FALSE(copy.has_origins());
+    EXPECT_TRUE(cfg.origin("a.b").has_value());
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_schema.cpp
+ * @brief Unit tests for compiled configuration schemas (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/Schema.hpp"
+#include "confy/Config.hpp"
+
+#include <memory>
+
+using namespace confy;
+
+namespace {
+
+using Kind = SchemaViolation::Kind;
+
+Schema make_db_schema() {
+    Schema schema;
+    schema.field("database.host").required().type(SchemaType::String);
+    schema.field("database.port").type(SchemaType::Integer).min(1).max(65535)
+          .default_value(5432);
+    schema.field("log.level").one_of({"debug", "info", "warn", "error"})
+          .default_value("info");
+    schema.field("service.name").pattern("^[a-z][a-z0-9-]*$");
+    return schema;
+}
+
+} // anonymous namespace
+
+TEST(Schema, ValidTreeHasNoViolations) {
+    Schema schema = make_db_schema();
+    Value tree = {
+        {"database", {{"host", "db"}, {"port", 5432}}},
+        {"log", {{"level", "warn"}}},
+        {"service", {{"name", "api-1"}}}
+    };
+
+    EXPECT_TRUE(schema.validate(tree).empty());
+    EXPECT_NO_THROW(schema.check(tree));
+}
+
+TEST(Schema, ReportsAllViolationsInDeclarationOrder) {
+    Schema schema = make_db_schema();
+    Value tree = {
+        {"database", {{"port", 70000}}},
+        {"log", {{"level", "loud"}}},
+        {"service", {{"name", "Bad_Name"}}}
+    };
+
+    auto v = schema.validate(tree);
+    ASSERT_EQ(v.size(), 4u);
+    EXPECT_EQ(v[0].kind, Kind::Missing);
+    EXPECT_EQ(v[0].path, "database.host");
+    EXPECT_EQ(v[1].kind, Kind::OutOfRange);
+    EXPECT_EQ(v[1].path, "database.port");
+    EXPECT_EQ(v[2].kind, Kind::NotInEnum);
+    EXPECT_EQ(v[3].kind, Kind::PatternMismatch);
+}
+
+TEST(Schema, WrongType) {
+    Schema schema = make_db_schema();
+    Value tree = {{"database", {{"host", 42}, {"port", 1.5}}}};
+
+    auto v = schema.validate(tree);
+    ASSERT_EQ(v.size(), 2u);
+    EXPECT_EQ(v[0].kind, Kind::WrongType);
+    EXPECT_EQ(v[1].kind, Kind::WrongType);
+}
+
+TEST(Schema, PathIntoScalarIsMissing) {
+    // RULE M3
+    Schema schema;
+    schema.field("a.b.c").required();
+    schema.field("a.b.d").required();
+
+    auto v = schema.validate(Value{{"a", {{"b", "scalar"}}}});
+    ASSERT_EQ(v.size(), 2u);
+    EXPECT_EQ(v[0].path, "a.b.c");
+    EXPECT_EQ(v[1].path, "a.b.d");
+    EXPECT_EQ(v[1].kind, Kind::Missing);
+}
+
+TEST(Schema, ArrayIndexPaths) {
+    Schema schema;
+    schema.field("servers.0.host").required().type(SchemaType::String);
+    schema.field("servers.1.host").required();
+
+    auto v = schema.validate(Value{{"servers", {{{"host", "a"}}}}});
+    ASSERT_EQ(v.size(), 1u);
+    EXPECT_EQ(v[0].path, "servers.1.host");
+}
+
+TEST(Schema, OversizedIndexIsMissing) {
+    Schema schema;
+    schema.field("servers.99999999999999999999999").required();
+
+    auto v = schema.validate(Value{{"servers", {1, 2}}});
+    ASSERT_EQ(v.size(), 1u);
+    EXPECT_EQ(v[0].kind, Kind::Missing);
+}
+
+TEST(Schema, DefaultsTree) {
+    Schema schema = make_db_schema();
+    EXPECT_EQ(schema.defaults(),
+              (Value{{"database", {{"port", 5432}}}, {"log", {{"level", "info"}}}}));
+}
+
+TEST(Schema, FieldReturnsSameRule) {
+    Schema schema;
+    schema.field("a.b").required();
+    schema.field("a.b").type(SchemaType::Boolean);
+
+    EXPECT_EQ(schema.size(), 1u);
+    EXPECT_TRUE(schema.field("a.b").is_required());
+}
+
+TEST(Schema, FromJson) {
+    Schema schema = Schema::from_json(Value{
+        {"database.host", {{"type", "string"}, {"required", true}}},
+        {"database.port", {{"type", "integer"}, {"min", 1}, {"max", 65535}, {"default", 5432}}},
+        {"log.level", {{"enum", {"debug", "info"}}}},
+        {"service.name", {{"pattern", "^[a-z]+$"}}}
+    });
+
+    EXPECT_EQ(schema.size(), 4u);
+    auto v = schema.validate(Value{{"database", {{"port", 0}}}, {"service", {{"name", "X"}}}});
+    ASSERT_EQ(v.size(), 3u);
+    EXPECT_EQ(v[0].kind, Kind::Missing);
+    EXPECT_EQ(v[1].kind, Kind::OutOfRange);
+    EXPECT_EQ(v[2].kind, Kind::PatternMismatch);
+}
+
+TEST(Schema, FromJsonRejectsMalformed) {
+    EXPECT_THROW(Schema::from_json(Value::array()), ConfigError);
+    EXPECT_THROW(Schema::from_json(Value{{"a", 1}}), ConfigError);
+    EXPECT_THROW(Schema::from_json(Value{{"a", {{"type", "str"}}}}), ConfigError);
+    EXPECT_THROW(Schema::from_json(Value{{"a", {{"unknown", 1}}}}), ConfigError);
+    EXPECT_THROW(Schema::from_json(Value{{"a", {{"pattern", "("}}}}), ConfigError);
+}
+
+TEST(Schema, CheckThrowsWithAllViolations) {
+    Schema schema = make_db_schema();
+    try {
+        schema.check(Value{{"database", {{"port", "x"}}}});
+        FAIL() << "Expected SchemaValidationError";
+    } catch (const SchemaValidationError& e) {
+        EXPECT_EQ(e.violations().size(), 2u);
+        EXPECT_EQ(e.missing_keys(), (std::vector<std::string>{"database.host"}));
+    }
+}
+
+TEST(Schema, ConfigLoadAppliesDefaultsAndValidates) {
+    auto schema = std::make_shared<Schema>(make_db_schema());
+
+    LoadOptions opts;
+    opts.load_dotenv_file = false;
+    opts.schema = schema;
+    opts.defaults = {{"log", {{"level", "debug"}}}};
+    opts.overrides = {{"database.host", "db.local"}};
+
+    Config cfg = Config::load(opts);
+    EXPECT_EQ(cfg.get<int>("database.port", 0), 5432);              // schema default
+    EXPECT_EQ(cfg.get<std::string>("log.level", ""), "debug");      // defaults win
+
+    opts.overrides = {{"database.port", 0}};
+    EXPECT_THROW(Config::load(opts), SchemaValidationError);
+}
@@ -0,0 +1,181 @@
+/**
+ * @file test_server.cpp
+ * @brief Unit tests for the socket protocol, server and client (GoogleTest)
+ */
+
+#include <gtest/gtest.h>
+#include "confy/Server.hpp"
+#include "confy/Errors.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace confy;
+
+TEST(CommandLine, SplitHandlesQuotes) {
+    auto words = split_command_line(R"(set  a.b '{"x": [1, 2]}'  "say \"hi\"" '')");
+    EXPECT_EQ(words, (std::vector<std::string>{"set", "a.b", R"({"x": [1, 2]})", R"(say "hi")", ""}));
+
+    EXPECT_TRUE(split_command_line("  \t ").empty());
+    EXPECT_THROW(split_command_line("get 'a"), ConfigError);
+    EXPECT_THROW(split_command_line("get \"a"), ConfigError);
+}
+
+TEST(CommandLine, JoinRoundTrips) {
+    std::vector<std::string> words = {"search", "--val", "a b", "#x", "", "q\"uo'te\\", "plain"};
+    EXPECT_EQ(split_command_line(join_command_line(words)), words);
+    EXPECT_THROW(join_command_line({"get", "a\nb"}), ConfigError);
+}
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+std::string socket_file(const std::string& name) {
+    return (fs::temp_directory_path() / name).string();
+}
+
+/// Server answering "<n> words: <first>" on a background thread
+class EchoServer {
+public:
+    explicit EchoServer(const std::string& path)
+        : server_(path, [](std::string_view line) {
+              auto words = split_command_line(line);
+              if (words.empty()) throw ConfigError("empty");
+              return Value{{"ok", true}, {"value", words.front()},
+                           {"count", words.size()}}.dump();
+          }),
+          thread_([this] { server_.run(); }) {}
+
+    ~EchoServer() {
+        server_.stop();
+        thread_.join();
+    }
+
+private:
+    ConfigServer server_;
+    std::thread thread_;
+};
+
+} // anonymous namespace
+
+TEST(ConfigServer, AnswersRequestsInOrder) {
+    std::string path = socket_file("confy_test_order.sock");
+    EchoServer server(path);
+
+    ConfigClient client(path);
+    for (int i = 0; i < 50; ++i) {
+        std::string key = "key" + std::to_string(i);
+        Value r = client.request({key, "a b"});
+        EXPECT_EQ(r["value"], key);
+        EXPECT_EQ(r["count"], 2);
+    }
+
+    // Handler exceptions become error responses
+    Value err = Value::parse(client.request_line(""));
+    EXPECT_FALSE(err["ok"].get<bool>());
+    EXPECT_EQ(err["error"], "empty");
+}
+
+TEST(ConfigServer, ServesManyClients) {
+    std::string path = socket_file("confy_test_many.sock");
+    EchoServer server(path);
+
+    std::vector<std::unique_ptr<ConfigClient>> clients;
+    for (int i = 0; i < 20; ++i) {
+        clients.push_back(std::make_unique<ConfigClient>(path));
+    }
+    for (size_t i = 0; i < clients.size(); ++i) {
+        EXPECT_EQ(clients[i]->request({"c" + std::to_string(i)})["value"],
+                  "c" + std::to_string(i));
+    }
+}
+
+TEST(ConfigServer, SocketFileLifecycle) {
+    std::string path = socket_file("confy_test_life.sock");
+    {
+        EchoServer server(path);
+        EXPECT_TRUE(fs::exists(path));
+
+        // A live server is never replaced
+        EXPECT_THROW(ConfigServer(path, [](std::string_view) { return std::string(); }),
+                     ConfigError);
+    }
+    EXPECT_FALSE(fs::exists(path));
+    EXPECT_THROW(ConfigClient client(path), ConfigError);
+
+    // Regular files are never removed
+    std::string file = socket_file("confy_test_not_a_socket");
+    std::ofstream(file) << "keep";
+    EXPECT_THROW(ConfigServer(file, [](std::string_view) { return std::string(); }),
+                 ConfigError);
+    EXPECT_TRUE(fs::exists(file));
+    fs::remove(file);
+}
+
+TEST(ConfigServer, SocketIsOwnerOnly) {
+    std::string path = socket_file("confy_test_mode.sock");
+    EchoServer server(path);
+
+    EXPECT_EQ(fs::status(path).permissions() & fs::perms::all,
+              fs::perms::owner_read | fs::perms::owner_write);
+}
+
+TEST(ConfigServer, StopsReadingWhileOutputBacksUp) {
+    std::string path = socket_file("confy_test_backlog.sock");
+    std::atomic<int> answered{0};
+    const std::string big(64 * 1024, 'x');
+    ConfigServer server(path, [&](std::string_view) {
+        ++answered;
+        return big;
+    });
+    std::thread thread([&server] { server.run(); });
+
+    // Pipeline far more than MAX_PENDING_OUTPUT worth of requests
+    // without reading any response
+    constexpr int REQUESTS = 400;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0);
+    std::string requests;
+    for (int i = 0; i < REQUESTS; ++i) {
+        requests += "dump\n";
+    }
+    ASSERT_EQ(::write(fd, requests.data(), requests.size()),
+              static_cast<ssize_t>(requests.size()));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_LT(answered.load(), REQUESTS);
+
+    // Reading drains the backlog; every response arrives
+    size_t expected = static_cast<size_t>(REQUESTS) * (big.size() + 1);
+    size_t received = 0;
+    char buf[65536];
+    while (received < expected) {
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        ASSERT_GT(n, 0);
+        received += static_cast<size_t>(n);
+    }
+    EXPECT_EQ(received, expected);
+    EXPECT_EQ(answered.load(), REQUESTS);
+
+    ::close(fd);
+    server.stop();
+    thread.join();
+}
+
+#endif
@@ -39,3 +39,72 @@ TEST(OverridesDictToValue, Simple) {
     EXPECT_EQ(result["a"]["b"], 1);
     EXPECT_EQ(result["c"]["d"], 2);
 }
+
+TEST(OverridesDictToValue, OverlappingPaths) {
+    std::unordered_map<std::string, Value> overrides = {
+        {"a.b", 1}, {"a", 2}, {"s", {{"x", 1}}}, {"s.y", 2}
+    };
+
+    // A scalar ends its path, an object takes the deeper keys
+    EXPECT_EQ(overrides_dict_to_value(overrides),
+              (Value{{"a", 2}, {"s", {{"x", 1}, {"y", 2}}}}));
+}
+
+TEST(Leaves, DepthFirstWithoutCopies) {
+    Value data = {
+        {"a", 1},
+        {"b", {{"c", {{"d", "x"}}}, {"e", {1, 2}}}},
+        {"empty", Value::object()},
+        {"f", nullptr}
+    };
+
+    std::vector<std::string> paths;
+    std::vector<const Value*> values;
+    for (const auto& [path, value] : leaves(data)) {
+        paths.emplace_back(path);
+        values.push_back(&value);
+    }
+
+    EXPECT_EQ(paths, (std::vector<std::string>{"a", "b.c.d", "b.e", "f"}));
+    EXPECT_EQ(values[1], &data["b"]["c"]["d"]);
+    EXPECT_EQ(*values[2], (Value{1, 2}));   // arrays are leaves
+}
+
+TEST(Leaves, EmptyAndScalarRoots) {
+    EXPECT_EQ(leaves(Value::object()).begin(), leaves(Value::object()).end());
+    Value scalar = 42;
+    EXPECT_EQ(leaves(scalar).begin(), leaves(scalar).end());
+
+    Value only_empty = {{"a", Value::object()}, {"b", {{"c", Value::object()}}}};
+    EXPECT_EQ(std::distance(leaves(only_empty).begin(), leaves(only_empty).end()), 0);
+}
+
+TEST(Leaves, PathBufferSurvivesBacktracking) {
+    // Siblings of different lengths at several depths: each yielded path
+    // must be rebuilt correctly after the buffer is truncated
+    Value data = {
+        {"alpha", {{"x", 1}, {"longer_key", {{"deep", 2}}}, {"y", 3}}},
+        {"b", 4},
+        {"gamma", {{"z", {{"w", {{"v", 5}}}}}}}
+    };
+
+    std::vector<std::pair<std::string, Value>> got;
+    for (const auto& [path, value] : leaves(data)) {
+        got.emplace_back(std::string(path), value);
+    }
+
+    std::vector<std::pair<std::string, Value>> expected = {
+        {"alpha.longer_key.deep", 2}, {"alpha.x", 1}, {"alpha.y", 3},
+        {"b", 4}, {"gamma.z.w.v", 5}
+    };
+    EXPECT_EQ(got, expected);
+}
+
+TEST(FlattenToDotpaths, Prefix) {
+    Value data = {{"a", {{"b", 1}}}};
+    auto result = flatten_to_dotpaths(data, "root");
+
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0].first, "root.a.b");
+    EXPECT_EQ(flatten_to_dotpaths(Value(5), "x")[0].first, "x");
+}